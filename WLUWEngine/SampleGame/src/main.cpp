@@ -1,5 +1,7 @@
 #include "WWindow.h"
 #include "WRendering.h"
+#include "WGameLoop.h"
+#include "WWorld.h"
 #include <cstdlib>
 
 #include "SDL.h"
@@ -9,25 +11,34 @@ int main(int argc, char** argv)
 	WLUW::WWindow win((char*)"Hello World");
 	WLUW::WRenderer testRenderer(win);
 
-	// Test code
-	bool shouldQuit = false;
+	WLUW::WWorld world;
+	world.setGravity(WLUW::Vector2(0, -9.8));
+
+	// Physics runs at 30 Hz however fast frames are drawn
+	WLUW::WGameLoop loop(30);
 	SDL_Event event;
-	while (!shouldQuit)
-	{
-		while (SDL_PollEvent(&event) != 0)
-		{
-			switch (event.type)
+
+	loop.run(
+		[&]() {
+			while (SDL_PollEvent(&event) != 0)
 			{
-			case SDL_QUIT:
-				shouldQuit = true;
-				break;
+				switch (event.type)
+				{
+				case SDL_QUIT:
+					return false;
+				}
 			}
-		}
-		
-		testRenderer.clear(SDL_Color{204, 187, 100, 255});
-		testRenderer.present();
-	}
+			return true;
+		},
+		[&](double deltaTime) {
+			world.step(deltaTime);
+		},
+		[&](double alpha) {
+			// Objects are drawn between the last two physics states, at their body's getInterpolatedPosition(alpha)
+			testRenderer.clear(SDL_Color{204, 187, 100, 255});
+			testRenderer.present();
+		});
 	//win.setWindowSize(790, 500);
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,163 @@
+/*****************************************************************//**
+ * \file   AABB.h
+ * \brief  Axis-aligned bounding box used by the broadphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "RayCast.h"
+#include "Vector2.h"
+
+namespace WLUW
+{
+	/**
+	 * \class AABB AABB.h
+	 * \brief Axis-aligned bounding box defined by its lower and upper corners
+	 */
+	class AABB
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor. Creates an empty box at the origin
+		 */
+		AABB()
+		{
+		}
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param min lower corner of the box
+		 * \param max upper corner of the box
+		 */
+		AABB(Vector2 min, Vector2 max) : min(min), max(max)
+		{
+		}
+
+		// Core variables
+		Vector2 min;	/* Lower corner */
+		Vector2 max;	/* Upper corner */
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Checks if this box overlaps another. Touching boxes count as overlapping
+		 *
+		 * \param other box to test against
+		 * \return true if the boxes overlap
+		 */
+		bool overlaps(const AABB& other) const
+		{
+			return !(other.min.x > max.x || other.max.x < min.x || other.min.y > max.y || other.max.y < min.y);
+		}
+
+		/**
+		 * \brief Checks if this box fully contains another
+		 *
+		 * \param other box to test
+		 * \return true if other lies entirely inside this box
+		 */
+		bool contains(const AABB& other) const
+		{
+			return min.x <= other.min.x && min.y <= other.min.y && other.max.x <= max.x && other.max.y <= max.y;
+		}
+
+		/**\return perimeter of the box, used as the tree insertion cost */
+		double perimeter() const
+		{
+			return 2.0 * ((max.x - min.x) + (max.y - min.y));
+		}
+
+		/**\return centre of the box */
+		Vector2 getCenter() const
+		{
+			return (min + max) * 0.5;
+		}
+
+		/**\return half width and half height of the box */
+		Vector2 getExtents() const
+		{
+			return (max - min) * 0.5;
+		}
+
+		/**
+		 * \brief Gets a copy of this box grown by a margin on every side
+		 *
+		 * \param margin distance to grow each side by
+		 * \return the grown box
+		 */
+		AABB fattened(double margin) const
+		{
+			return AABB(min - margin, max + margin);
+		}
+
+		/**
+		 * \brief Finds where a ray enters this box. A ray starting inside the box enters it at distance 0
+		 *
+		 * \param ray ray to test
+		 * \param distance set to the entry distance along the ray if it hits
+		 * \return true if the ray enters the box within its maximum distance
+		 */
+		bool raycast(const Ray& ray, double& distance) const
+		{
+			double lower = 0.0;
+			double upper = ray.maxDistance;
+
+			if (!clipSlab(ray.origin.x, ray.direction.x, min.x, max.x, lower, upper)
+				|| !clipSlab(ray.origin.y, ray.direction.y, min.y, max.y, lower, upper))
+				return false;
+
+			distance = lower;
+			return true;
+		}
+
+		/**
+		 * \brief Gets the smallest box containing two boxes
+		 *
+		 * \param a first box
+		 * \param b second box
+		 * \return union of a and b
+		 */
+		static AABB combine(const AABB& a, const AABB& b)
+		{
+			return AABB(
+				Vector2(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y)),
+				Vector2(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y)));
+		}
+
+	private:
+		/**
+		 * \brief Narrows the distances along a ray which lie between two planes of the box
+		 *
+		 * \return false if no part of the ray is left
+		 */
+		static bool clipSlab(double origin, double direction, double low, double high, double& lower, double& upper)
+		{
+			// A ray parallel to the slab is either inside it the whole way or never
+			if (direction == 0.0)
+				return origin >= low && origin <= high;
+
+			double inverse = 1.0 / direction;
+			double enter = (low - origin) * inverse;
+			double leave = (high - origin) * inverse;
+			if (enter > leave)
+				std::swap(enter, leave);
+
+			lower = std::max(lower, enter);
+			upper = std::min(upper, leave);
+			return lower <= upper;
+		}
+	};
+}
@@ -0,0 +1,256 @@
+/*****************************************************************//**
+ * \file   CollisionKernels.h
+ * \brief  Collision routines on raw point arrays, templated on the scalar type
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "Vector2.h"
+#include "Vector2Array.h"
+
+namespace WLUW
+{
+	/*
+	 * Shape runs these with doubles on its cached world-space points, a Vector2Array, so SAT projects through
+	 * the SIMD kernels. Running them with Fixed instead gives
+	 * the same answer on every compiler and platform, for simulations which have to stay in lockstep. Each
+	 * routine returns false when the shapes don't touch, otherwise it sets the unit axis pointing from b
+	 * towards a and the depth to push a along it
+	 */
+
+	/**
+	 * \brief Helper function which projects points onto an axis
+	 *
+	 * \param points points to project
+	 * \param count number of points, at least 1
+	 * \param axis axis to project onto
+	 * \return smallest and largest projection
+	 */
+	template<class Scalar>
+	std::pair<Scalar, Scalar> projectPoints(const Vector2T<Scalar>* points, int count, Vector2T<Scalar> axis)
+	{
+		Scalar min = axis.dot(points[0]);
+		Scalar max = min;
+
+		for (int i = 1; i < count; i++)
+		{
+			Scalar p = axis.dot(points[i]);
+			if (p < min)
+				min = p;
+			else if (p > max)
+				max = p;
+		}
+
+		return std::make_pair(min, max);
+	}
+
+	/**
+	 * \brief Helper function which projects points held in x and y arrays onto an axis, with the SIMD kernels
+	 *
+	 * \param points points to project
+	 * \param count number of points from the start of points, at least 1
+	 * \param axis axis to project onto
+	 * \return smallest and largest projection
+	 */
+	inline std::pair<double, double> projectPoints(const Vector2Array& points, int count, Vector2 axis)
+	{
+		return points.projectOntoAxis(0, count, axis);
+	}
+
+	/**
+	 * \brief Computes the outward unit normal of every edge of a polygon, whichever way it winds
+	 *
+	 * \param points vertices of the polygon
+	 * \param count number of vertices, at least 2
+	 * \param normals receives count normals. normals[i] belongs to the edge from points[i] to points[i + 1]
+	 * \return twice the signed area of the polygon, negative when the points wind clockwise
+	 */
+	template<class Scalar>
+	Scalar computeNormals(const Vector2T<Scalar>* points, int count, Vector2T<Scalar>* normals)
+	{
+		// Twice the signed area, negative when the points wind clockwise
+		Scalar area = Scalar(0);
+		for (int i = 0; i < count; i++)
+		{
+			Vector2T<Scalar> p1 = points[i];
+			Vector2T<Scalar> p2 = points[(i + 1) % count];
+			area += p1.x * p2.y - p2.x * p1.y;
+		}
+
+		Scalar const winding = area < Scalar(0) ? Scalar(-1) : Scalar(1);
+
+		for (int i = 0; i < count; i++)
+		{
+			Vector2T<Scalar> edge = points[i] - points[(i + 1) % count];
+			normals[i] = edge.normal().normalized() * winding;
+		}
+
+		return area;
+	}
+
+	/**
+	 * \brief Collides two circles in closed form
+	 *
+	 * \param centreA centre of a
+	 * \param radiusA radius of a
+	 * \param centreB centre of b
+	 * \param radiusB radius of b
+	 * \param axis set to the axis pushing a out of b
+	 * \param depth set to how far a has to move along axis
+	 * \return true if the circles touch
+	 */
+	template<class Scalar>
+	bool circleCircleOverlap(Vector2T<Scalar> centreA, Scalar radiusA, Vector2T<Scalar> centreB, Scalar radiusB,
+		Vector2T<Scalar>& axis, Scalar& depth)
+	{
+		Vector2T<Scalar> d = centreA - centreB;
+		Scalar radii = radiusA + radiusB;
+		Scalar distanceSquared = d.dot(d);
+
+		if (distanceSquared > radii * radii)
+			return false;
+
+		// Concentric circles have no preferred direction, pick one
+		if (distanceSquared == Scalar(0))
+		{
+			axis = Vector2T<Scalar>(1, 0);
+			depth = radii;
+			return true;
+		}
+
+		using std::sqrt;
+		Scalar distance = sqrt(distanceSquared);
+		axis = d / distance;
+		depth = radii - distance;
+		return true;
+	}
+
+	/**
+	 * \brief Collides a circle with a polygon. Finds the edge the circle centre is furthest in front of, then
+	 * tests a single axis depending on which Voronoi region of that edge the centre is in
+	 *
+	 * \param centre centre of the circle
+	 * \param radius radius of the circle
+	 * \param points vertices of the polygon, a pointer or anything else indexable
+	 * \param normals outward unit normal of each edge of the polygon
+	 * \param count number of vertices, at least 2
+	 * \param axis set to the axis pushing the circle out of the polygon
+	 * \param depth set to how far the circle has to move along axis
+	 * \return true if the shapes touch
+	 */
+	template<class Scalar, class Points>
+	bool circlePolygonOverlap(Vector2T<Scalar> centre, Scalar radius, const Points& points, const Vector2T<Scalar>* normals,
+		int count, Vector2T<Scalar>& axis, Scalar& depth)
+	{
+		// Find the edge with the largest separation from the centre
+		Scalar separation = -std::numeric_limits<Scalar>::max();
+		int edge = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			Scalar s = normals[i].dot(centre - points[i]);
+
+			// The circle is entirely in front of this edge
+			if (s > radius)
+				return false;
+
+			if (s > separation)
+			{
+				separation = s;
+				edge = i;
+			}
+		}
+
+		// Centre is inside the polygon, push out through the closest edge
+		if (separation <= Scalar(0))
+		{
+			axis = normals[edge];
+			depth = radius - separation;
+			return true;
+		}
+
+		Vector2T<Scalar> v1 = points[edge];
+		Vector2T<Scalar> v2 = points[(edge + 1) % count];
+
+		// Work out whether the centre is nearest to v1, v2, or the edge between them
+		Vector2T<Scalar> vertex;
+		if ((centre - v1).dot(v2 - v1) <= Scalar(0))
+			vertex = v1;
+		else if ((centre - v2).dot(v1 - v2) <= Scalar(0))
+			vertex = v2;
+		else
+		{
+			axis = normals[edge];
+			depth = radius - separation;
+			return true;
+		}
+
+		Vector2T<Scalar> d = centre - vertex;
+		Scalar distanceSquared = d.dot(d);
+
+		if (distanceSquared > radius * radius)
+			return false;
+
+		using std::sqrt;
+		Scalar distance = sqrt(distanceSquared);
+		axis = d / distance;
+		depth = radius - distance;
+		return true;
+	}
+
+	/**
+	 * \brief Collides two convex polygons with SAT
+	 *
+	 * \param pointsA vertices of a, a pointer or a Vector2Array
+	 * \param countA number of vertices of a, at least 1
+	 * \param pointsB vertices of b, a pointer or a Vector2Array
+	 * \param countB number of vertices of b, at least 1
+	 * \param axes candidate separating axes, anything indexable. The edge normals of both polygons, or fewer if
+	 * parallel ones were removed
+	 * \param axisCount number of axes
+	 * \param centreA point inside a, such as the centre of its bounding box
+	 * \param centreB point inside b. The axis is flipped to point roughly from centreB towards centreA
+	 * \param axis set to the axis pushing a out of b
+	 * \param depth set to how far a has to move along axis
+	 * \return true if the polygons touch
+	 */
+	template<class Scalar, class PointsA, class PointsB, class Axes>
+	bool polygonPolygonOverlap(const PointsA& pointsA, int countA, const PointsB& pointsB, int countB,
+		const Axes& axes, int axisCount, Vector2T<Scalar> centreA, Vector2T<Scalar> centreB, Vector2T<Scalar>& axis, Scalar& depth)
+	{
+		axis = Vector2T<Scalar>(0, 0);
+		depth = std::numeric_limits<Scalar>::max();
+
+		for (int i = 0; i < axisCount; i++)
+		{
+			std::pair<Scalar, Scalar> a = projectPoints(pointsA, countA, Vector2T<Scalar>(axes[i]));
+			std::pair<Scalar, Scalar> b = projectPoints(pointsB, countB, Vector2T<Scalar>(axes[i]));
+
+			// Found a separating axis, the shapes can't overlap
+			if (b.first > a.second || a.first > b.second)
+				return false;
+
+			// Taking the smaller push also handles one range containing the other
+			Scalar overlap = std::min(a.second - b.first, b.second - a.first);
+			if (overlap < depth)
+			{
+				axis = axes[i];
+				depth = overlap;
+			}
+		}
+
+		// Point the axis from b towards a
+		if ((centreA - centreB).dot(axis) < Scalar(0))
+			axis = -axis;
+
+		return true;
+	}
+}
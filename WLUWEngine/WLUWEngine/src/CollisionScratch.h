@@ -0,0 +1,92 @@
+/*****************************************************************//**
+ * \file   CollisionScratch.h
+ * \brief  Reusable working memory for collision queries
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "Vector2.h"
+
+namespace WLUW
+{
+	/**
+	 * \struct CollisionScratch
+	 * \brief Working memory handed to collision queries. Buffers keep their capacity between
+	 * queries, so reusing one scratch for a whole collision pass means no heap allocation once warm.
+	 */
+	struct CollisionScratch
+	{
+		std::vector<Vector2> axes;		/* Axes which didn't fit in an AxisBuffer */
+		std::vector<Vector2> polytope;	/* Vertices of the polygon EPA expands */
+		std::vector<std::pair<int, int>> nodePairs;		/* Pairs of tree nodes still to visit in compound shape queries */
+		std::vector<std::pair<int, int>> childPairs;	/* Child pairs of two compound shapes whose boxes overlap */
+		std::vector<double> laneAxes;		/* Axes of the pairs ShapeBatch collides side by side, one pair per SIMD lane */
+		std::vector<double> laneVerticesA;	/* Vertices of the first shape of each of those pairs */
+		std::vector<double> laneVerticesB;	/* Vertices of the second shape of each of those pairs */
+	};
+
+	/**
+	 * \class AxisBuffer CollisionScratch.h
+	 * \tparam N number of axes stored inline
+	 * \brief List of separating axes. The first N axes live inside the buffer itself, anything past that
+	 * spills into a caller-supplied vector, so polygons with up to N edges never touch the heap.
+	 */
+	template<int N>
+	class AxisBuffer
+	{
+	public:
+		/**
+		 * \brief Constructor
+		 *
+		 * \param spill vector to hold axes past the first N. It is cleared
+		 */
+		AxisBuffer(std::vector<Vector2>& spill) : spill(spill)
+		{
+			spill.clear();
+		}
+
+		/**
+		 * \brief Append an axis
+		 *
+		 * \param axis axis to append
+		 */
+		void push_back(Vector2 axis)
+		{
+			if (count < N)
+				inlineAxes[count] = axis;
+			else
+				spill.push_back(axis);
+
+			count++;
+		}
+
+		/**
+		 * \brief Remove the last axis
+		 */
+		void pop_back()
+		{
+			count--;
+			if (count >= N)
+				spill.pop_back();
+		}
+
+		/**\return number of axes stored */
+		int size() const { return count; };
+
+		const Vector2& operator[](int index) const
+		{
+			return index < N ? inlineAxes[index] : spill[index - N];
+		}
+
+	private:
+		Vector2 inlineAxes[N];			/* First N axes */
+		std::vector<Vector2>& spill;	/* Axes past the first N */
+		int count = 0;					/* Total number of axes */
+	};
+}
@@ -0,0 +1,432 @@
+/*****************************************************************//**
+ * \file   CompoundShape.cpp
+ * \brief  Implementation of the compound shape and its bounding volume tree
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "CompoundShape.h"
+
+using namespace WLUW;
+
+namespace
+{
+    /**
+     * \brief Helper function which keeps the deeper of two MTVs, treating a NaN depth as no collision
+     *
+     * \param deepest deepest MTV so far, replaced if mtv is deeper
+     * \param mtv MTV of another pair
+     */
+    void keepDeepest(std::pair<Vector2, double>& deepest, const std::pair<Vector2, double>& mtv)
+    {
+        if (!std::isnan(mtv.second) && (std::isnan(deepest.second) || mtv.second > deepest.second))
+            deepest = mtv;
+    }
+}
+
+WLUW::CompoundShape::CompoundShape(Vector2 pos) : transform(pos)
+{
+}
+
+WLUW::CompoundShape::CompoundShape(const ConvexPieces& pieces, Vector2 pos) : transform(pos)
+{
+    this->children.reserve(pieces.size());
+    this->offsets.reserve(pieces.size());
+
+    for (const std::vector<Vector2>& piece : pieces)
+    {
+        std::vector<Vector2> points = piece;
+        addChild(Shape(points));
+    }
+}
+
+int WLUW::CompoundShape::addChild(const Shape& shape, const Transform2D& offset)
+{
+    this->children.push_back(shape);
+    this->offsets.push_back(offset);
+
+    // The child is placed by the compound from now on
+    Shape& child = this->children.back();
+    child.followTransform(nullptr);
+    child.setTransform(this->transform.combine(offset));
+
+    this->treeDirty = true;
+    return static_cast<int>(this->children.size()) - 1;
+}
+
+void WLUW::CompoundShape::removeChild(int index)
+{
+    if (index < 0 || index >= this->children.size())
+    {
+        throw("Child index out of range");
+        return;
+    }
+
+    this->children.erase(this->children.begin() + index);
+    this->offsets.erase(this->offsets.begin() + index);
+    this->treeDirty = true;
+}
+
+void WLUW::CompoundShape::queryChildren(const AABB& aabb, const std::function<bool(int)>& callback) const
+{
+    traverse(aabb, callback);
+}
+
+void WLUW::CompoundShape::findChildPairs(const CompoundShape& a, const CompoundShape& b, std::vector<std::pair<int, int>>& pairs,
+    CollisionScratch& scratch)
+{
+    pairs.clear();
+    a.updateCache();
+    b.updateCache();
+
+    if (a.nodes.empty() || b.nodes.empty())
+        return;
+
+    std::vector<std::pair<int, int>>& stack = scratch.nodePairs;
+    stack.clear();
+    stack.emplace_back(0, 0);
+
+    while (!stack.empty())
+    {
+        auto [nodeA, nodeB] = stack.back();
+        stack.pop_back();
+
+        const TreeNode& first = a.nodes[nodeA];
+        const TreeNode& second = b.nodes[nodeB];
+        if (!first.aabb.overlaps(second.aabb))
+            continue;
+
+        if (first.isLeaf() && second.isLeaf())
+        {
+            pairs.emplace_back(first.shape, second.shape);
+            continue;
+        }
+
+        // Split the larger box, so both sides shrink at about the same rate
+        if (first.isLeaf() || (!second.isLeaf() && second.aabb.perimeter() > first.aabb.perimeter()))
+        {
+            stack.emplace_back(nodeA, nodeB + 1);
+            stack.emplace_back(nodeA, second.child2);
+        }
+        else
+        {
+            stack.emplace_back(nodeA + 1, nodeB);
+            stack.emplace_back(first.child2, nodeB);
+        }
+    }
+}
+
+std::pair<WLUW::Vector2, double> WLUW::CompoundShape::checkCollision(const CompoundShape& a, const CompoundShape& b, CollisionScratch& scratch)
+{
+    std::pair<Vector2, double> deepest(Vector2(), std::numeric_limits<double>::quiet_NaN());
+
+    findChildPairs(a, b, scratch.childPairs, scratch);
+    for (const std::pair<int, int>& pair : scratch.childPairs)
+        keepDeepest(deepest, Shape::checkCollision(a.children[pair.first], b.children[pair.second], scratch));
+
+    return deepest;
+}
+
+std::pair<WLUW::Vector2, double> WLUW::CompoundShape::checkCollision(const CompoundShape& a, const Shape& b, CollisionScratch& scratch)
+{
+    std::pair<Vector2, double> deepest(Vector2(), std::numeric_limits<double>::quiet_NaN());
+
+    a.traverse(b.getBoundingBox(), [&](int child)
+        {
+            keepDeepest(deepest, Shape::checkCollision(a.children[child], b, scratch));
+            return true;
+        });
+
+    return deepest;
+}
+
+std::pair<WLUW::Vector2, double> WLUW::CompoundShape::checkCollision(const Shape& a, const CompoundShape& b, CollisionScratch& scratch)
+{
+    // Same test from the compound's side, with the MTV turned around to point from the compound towards the shape
+    std::pair<Vector2, double> mtv = checkCollision(b, a, scratch);
+    mtv.first = -mtv.first;
+    return mtv;
+}
+
+int WLUW::CompoundShape::computeManifolds(const CompoundShape& a, const CompoundShape& b, std::vector<ChildContact>& contacts,
+    CollisionScratch& scratch)
+{
+    contacts.clear();
+
+    findChildPairs(a, b, scratch.childPairs, scratch);
+    for (const std::pair<int, int>& pair : scratch.childPairs)
+    {
+        ChildContact contact{ pair.first, pair.second, ContactManifold() };
+        if (computeManifold(a.children[pair.first], b.children[pair.second], contact.manifold, scratch))
+            contacts.push_back(contact);
+    }
+
+    return static_cast<int>(contacts.size());
+}
+
+int WLUW::CompoundShape::computeManifolds(const CompoundShape& a, const Shape& b, std::vector<ChildContact>& contacts,
+    CollisionScratch& scratch)
+{
+    contacts.clear();
+
+    a.traverse(b.getBoundingBox(), [&](int child)
+        {
+            ChildContact contact{ child, 0, ContactManifold() };
+            if (computeManifold(a.children[child], b, contact.manifold, scratch))
+                contacts.push_back(contact);
+            return true;
+        });
+
+    return static_cast<int>(contacts.size());
+}
+
+int WLUW::CompoundShape::computeManifolds(const Shape& a, const CompoundShape& b, std::vector<ChildContact>& contacts,
+    CollisionScratch& scratch)
+{
+    contacts.clear();
+
+    b.traverse(a.getBoundingBox(), [&](int child)
+        {
+            ChildContact contact{ 0, child, ContactManifold() };
+            if (computeManifold(a, b.children[child], contact.manifold, scratch))
+                contacts.push_back(contact);
+            return true;
+        });
+
+    return static_cast<int>(contacts.size());
+}
+
+int WLUW::CompoundShape::raycast(const Ray& ray, RayHit& hit) const
+{
+    updateCache();
+
+    if (this->nodes.empty())
+        return -1;
+
+    int hitChild = -1;
+    Ray clipped = ray;
+
+    // updateCache made sure the tree is no taller than the stack
+    int stack[STACK_SIZE];
+    int count = 0;
+    stack[count++] = 0;
+
+    while (count > 0)
+    {
+        int const index = stack[--count];
+        const TreeNode& node = this->nodes[index];
+
+        // Test against the ray as clipped by the nearest hit so far
+        double distance;
+        if (!node.aabb.raycast(clipped, distance))
+            continue;
+
+        if (node.isLeaf())
+        {
+            RayHit candidate;
+            if (this->children[node.shape].raycast(clipped, candidate))
+            {
+                hit.point = candidate.point;
+                hit.normal = candidate.normal;
+                hit.distance = candidate.distance;
+                hitChild = node.shape;
+                clipped.maxDistance = candidate.distance;
+            }
+        }
+        else
+        {
+            stack[count++] = node.child2;
+            stack[count++] = index + 1;
+        }
+    }
+
+    return hitChild;
+}
+
+bool WLUW::CompoundShape::containsPoint(Vector2 point) const
+{
+    bool found = false;
+
+    traverse(AABB(point, point), [&](int child)
+        {
+            found = this->children[child].containsPoint(point);
+            return !found;
+        });
+
+    return found;
+}
+
+void WLUW::CompoundShape::updateCache() const
+{
+    this->emptyBox = AABB(getPosition(), getPosition());
+
+    if (this->treeDirty)
+    {
+        int const count = static_cast<int>(this->children.size());
+
+        this->nodes.clear();
+        this->nodes.reserve(count > 0 ? 2 * count - 1 : 0);
+        this->order.resize(count);
+        for (int i = 0; i < count; i++)
+            this->order[i] = i;
+
+        if (count > 0)
+            build(0, count);
+
+        // Heights filled in children first, as in the refit
+        std::vector<int> heights(this->nodes.size());
+        for (int i = static_cast<int>(this->nodes.size()) - 1; i >= 0; i--)
+        {
+            const TreeNode& node = this->nodes[i];
+            heights[i] = node.isLeaf() ? 1 : 1 + std::max(heights[i + 1], heights[node.child2]);
+        }
+        this->height = heights.empty() ? 0 : heights[0];
+
+        // A walk keeps at most one entry per level on its stack. Median splits keep the height near log2 of the
+        // child count, so this only guards the fixed size of the stacks
+        if (this->height > STACK_SIZE)
+        {
+            throw("Compound shape tree too tall to walk");
+            return;
+        }
+
+        this->treeDirty = false;
+        this->boxesDirty = false;
+        return;
+    }
+
+    if (!this->boxesDirty)
+        return;
+
+    // Children come after their parent, so walking backwards refits every child before its parent
+    for (int i = static_cast<int>(this->nodes.size()) - 1; i >= 0; i--)
+    {
+        TreeNode& node = this->nodes[i];
+        node.aabb = node.isLeaf()
+            ? this->children[node.shape].getBoundingBox()
+            : AABB::combine(this->nodes[i + 1].aabb, this->nodes[node.child2].aabb);
+    }
+
+    this->boxesDirty = false;
+}
+
+void WLUW::CompoundShape::setPosition(Vector2 position)
+{
+    this->transform.setTranslation(position);
+    placeChildren();
+}
+
+void WLUW::CompoundShape::setRotation(double angle)
+{
+    this->transform.setRotation(angle);
+    placeChildren();
+}
+
+void WLUW::CompoundShape::setScale(double scale)
+{
+    this->transform.setScale(scale);
+    placeChildren();
+}
+
+void WLUW::CompoundShape::setTransform(const Transform2D& transform)
+{
+    this->transform = transform;
+    placeChildren();
+}
+
+int WLUW::CompoundShape::getTreeHeight() const
+{
+    updateCache();
+    return this->height;
+}
+
+int WLUW::CompoundShape::build(int first, int last) const
+{
+    int const index = static_cast<int>(this->nodes.size());
+    this->nodes.push_back(TreeNode());
+
+    if (last - first == 1)
+    {
+        int const child = this->order[first];
+        this->nodes[index] = { this->children[child].getBoundingBox(), -1, child };
+        return index;
+    }
+
+    // Split at the median centre along the axis the centres spread furthest on
+    Vector2 low = this->children[this->order[first]].getBoundingBox().getCenter();
+    Vector2 high = low;
+    for (int i = first + 1; i < last; i++)
+    {
+        Vector2 centre = this->children[this->order[i]].getBoundingBox().getCenter();
+        low = Vector2(std::min(low.x, centre.x), std::min(low.y, centre.y));
+        high = Vector2(std::max(high.x, centre.x), std::max(high.y, centre.y));
+    }
+
+    int const axis = high.x - low.x >= high.y - low.y ? 0 : 1;
+    int const middle = (first + last) / 2;
+    std::nth_element(this->order.begin() + first, this->order.begin() + middle, this->order.begin() + last, [&](int lhs, int rhs)
+        {
+            return this->children[lhs].getBoundingBox().getCenter()[axis] < this->children[rhs].getBoundingBox().getCenter()[axis];
+        });
+
+    // The first child lands right after its parent, as the refit and walks expect
+    build(first, middle);
+    int const child2 = build(middle, last);
+
+    this->nodes[index].child2 = child2;
+    this->nodes[index].shape = -1;
+    this->nodes[index].aabb = AABB::combine(this->nodes[index + 1].aabb, this->nodes[child2].aabb);
+    return index;
+}
+
+template<class Callback>
+void WLUW::CompoundShape::traverse(const AABB& aabb, Callback&& callback) const
+{
+    updateCache();
+
+    if (this->nodes.empty())
+        return;
+
+    // updateCache made sure the tree is no taller than the stack
+    int stack[STACK_SIZE];
+    int count = 0;
+    stack[count++] = 0;
+
+    while (count > 0)
+    {
+        int const index = stack[--count];
+        const TreeNode& node = this->nodes[index];
+
+        if (!node.aabb.overlaps(aabb))
+            continue;
+
+        if (node.isLeaf())
+        {
+            if (!callback(node.shape))
+                return;
+        }
+        else
+        {
+            stack[count++] = node.child2;
+            stack[count++] = index + 1;
+        }
+    }
+}
+
+void WLUW::CompoundShape::placeChildren()
+{
+    for (int i = 0; i < this->children.size(); i++)
+        this->children[i].setTransform(this->transform.combine(this->offsets[i]));
+
+    this->boxesDirty = true;
+}
+
+WLUW::AABB const& WLUW::CompoundShape::getRootBox() const
+{
+    return this->nodes.empty() ? this->emptyBox : this->nodes[0].aabb;
+}
@@ -0,0 +1,305 @@
+/*****************************************************************//**
+ * \file   CompoundShape.h
+ * \brief  Collision shape built from many convex child shapes
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "AABB.h"
+#include "CollisionScratch.h"
+#include "ContactManifold.h"
+#include "ConvexDecomposition.h"
+#include "RayCast.h"
+#include "Shape.h"
+#include "Transform2D.h"
+
+namespace WLUW
+{
+	/**
+	 * \struct ChildContact
+	 * \brief Contact manifold between one child of a compound shape and one child, or the whole, of another shape
+	 */
+	struct ChildContact
+	{
+		int childA;					/* Child of a, 0 when a isn't a compound shape */
+		int childB;					/* Child of b, 0 when b isn't a compound shape */
+		ContactManifold manifold;	/* Contacts between the two, normal pointing from b towards a */
+	};
+
+	/**
+	 * \class CompoundShape CompoundShape.h
+	 * \brief Shape made of convex children, each placed by an offset relative to the compound's own transform.
+	 * The children's bounding boxes are kept in a small bounding volume tree, so queries and narrowphase only
+	 * reach the children whose boxes overlap what is being tested. The tree is built when children are added or
+	 * removed, and only its boxes are refitted when the compound moves
+	 */
+	class CompoundShape
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor. Creates a compound without children
+		 *
+		 * \param pos position of the compound
+		 */
+		CompoundShape(Vector2 pos = Vector2());
+
+		/**
+		 * \brief Constructor which makes a polygon child from each convex piece, placed without an offset
+		 *
+		 * \param pieces convex pieces, such as from convexDecomposition
+		 * \param pos position of the compound
+		 */
+		CompoundShape(const ConvexPieces& pieces, Vector2 pos = Vector2());
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Add a child shape. Its own transform is replaced by the offset combined with the compound's transform
+		 *
+		 * \param shape child to add, copied
+		 * \param offset placement of the child relative to the compound
+		 * \return index of the child
+		 */
+		int addChild(const Shape& shape, const Transform2D& offset = Transform2D());
+
+		/**
+		 * \brief Remove a child. Children after it move down one index
+		 *
+		 * \param index index of the child to remove
+		 */
+		void removeChild(int index);
+
+		/**
+		 * \brief Find the children whose bounding boxes overlap a box
+		 *
+		 * \param aabb world-space box to test
+		 * \param callback called with the index of each child found, returns false to stop the query
+		 */
+		void queryChildren(const AABB& aabb, const std::function<bool(int)>& callback) const;
+
+		/**
+		 * \brief Find the pairs of children of two compounds whose bounding boxes overlap, by walking both trees together
+		 *
+		 * \param a first compound
+		 * \param b second compound
+		 * \param pairs cleared, then filled with the child of a and the child of b of each overlapping pair
+		 * \param scratch working memory for the walk
+		 */
+		static void findChildPairs(const CompoundShape& a, const CompoundShape& b, std::vector<std::pair<int, int>>& pairs,
+			CollisionScratch& scratch);
+
+		/**
+		 * \brief Checks for a collision between two compounds. Only child pairs with overlapping boxes are tested
+		 *
+		 * \param a first compound
+		 * \param b second compound
+		 * \param scratch working memory for the query
+		 * \return the deepest MTV of any pair of children, as for Shape::checkCollision. The depth is NaN if nothing collides
+		 */
+		static std::pair<Vector2, double> checkCollision(const CompoundShape& a, const CompoundShape& b, CollisionScratch& scratch);
+
+		/**
+		 * \brief Checks for a collision between a compound and a shape. Only children whose boxes overlap the shape are tested
+		 *
+		 * \param a compound
+		 * \param b shape
+		 * \param scratch working memory for the query
+		 * \return the deepest MTV of any child, as for Shape::checkCollision. The depth is NaN if nothing collides
+		 */
+		static std::pair<Vector2, double> checkCollision(const CompoundShape& a, const Shape& b, CollisionScratch& scratch);
+
+		/**
+		 * \brief Checks for a collision between a shape and a compound. Only children whose boxes overlap the shape are tested
+		 *
+		 * \param a shape
+		 * \param b compound
+		 * \param scratch working memory for the query
+		 * \return the deepest MTV of any child, as for Shape::checkCollision. The depth is NaN if nothing collides
+		 */
+		static std::pair<Vector2, double> checkCollision(const Shape& a, const CompoundShape& b, CollisionScratch& scratch);
+
+		/**
+		 * \brief Build a contact manifold for every pair of touching children of two compounds
+		 *
+		 * \param a first compound
+		 * \param b second compound
+		 * \param contacts cleared, then filled with a manifold per touching pair
+		 * \param scratch working memory for the query
+		 * \return number of touching pairs
+		 */
+		static int computeManifolds(const CompoundShape& a, const CompoundShape& b, std::vector<ChildContact>& contacts,
+			CollisionScratch& scratch);
+
+		/**
+		 * \brief Build a contact manifold for every child of a compound which touches a shape
+		 *
+		 * \param a compound
+		 * \param b shape
+		 * \param contacts cleared, then filled with a manifold per touching child
+		 * \param scratch working memory for the query
+		 * \return number of touching children
+		 */
+		static int computeManifolds(const CompoundShape& a, const Shape& b, std::vector<ChildContact>& contacts,
+			CollisionScratch& scratch);
+
+		/**
+		 * \brief Build a contact manifold for every child of a compound which touches a shape
+		 *
+		 * \param a shape
+		 * \param b compound
+		 * \param contacts cleared, then filled with a manifold per touching child, normals pointing from the compound towards the shape
+		 * \param scratch working memory for the query
+		 * \return number of touching children
+		 */
+		static int computeManifolds(const Shape& a, const CompoundShape& b, std::vector<ChildContact>& contacts,
+			CollisionScratch& scratch);
+
+		/**
+		 * \brief Finds where a ray first hits any child. Children behind the nearest hit so far are skipped
+		 *
+		 * \param ray ray to cast, its direction must be unit length
+		 * \param hit set to the point, outward normal and distance of the nearest hit. The ID is left alone
+		 * \return index of the child hit, -1 if the ray hits nothing within its maximum distance
+		 */
+		int raycast(const Ray& ray, RayHit& hit) const;
+
+		/**
+		 * \brief Checks if a point lies inside any child
+		 *
+		 * \param point world-space point
+		 * \return true if a child contains the point
+		 */
+		bool containsPoint(Vector2 point) const;
+
+		/**
+		 * \brief Rebuild the tree, or refit its boxes, if the children changed or moved since it was last built.
+		 * Queries do this on demand. Call it before sharing the compound between threads
+		 */
+		void updateCache() const;
+
+		/////////////////////
+		//// Modifier Methods
+		/////////////////////
+
+		/**
+		 * \brief Move the compound
+		 *
+		 * \param position new position of the compound
+		 */
+		void setPosition(Vector2 position);
+
+		/**
+		 * \brief Rotate the compound about its local origin
+		 *
+		 * \param angle rotation in radians, counter-clockwise
+		 */
+		void setRotation(double angle);
+
+		/**
+		 * \brief Scale the compound about its local origin
+		 *
+		 * \param scale uniform scale, greater than 0
+		 */
+		void setScale(double scale);
+
+		/**
+		 * \brief Replace the compound's transform
+		 *
+		 * \param transform new transform
+		 */
+		void setTransform(const Transform2D& transform);
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return compound position, the world position of its local origin */
+		Vector2 getPosition() const { return transform.getTranslation(); };
+
+		/**\return transform placing the compound in the world */
+		Transform2D const& getTransform() const { return transform; };
+
+		/**\return number of children */
+		int getChildCount() const { return static_cast<int>(children.size()); };
+
+		/**\return child shape, placed in the world */
+		Shape const& getChild(int index) const { return children[index]; };
+
+		/**\return placement of a child relative to the compound */
+		Transform2D const& getChildOffset(int index) const { return offsets[index]; };
+
+		/**\return smallest axis-aligned box containing every child, in world space */
+		AABB const& getBoundingBox() const { updateCache(); return getRootBox(); };
+
+		/**\return height of the tree, 0 without children */
+		int getTreeHeight() const;
+
+	private:
+		/**
+		 * \struct TreeNode
+		 * \brief Node of the tree. A node's first child is the node right after it, so only the second is stored
+		 */
+		struct TreeNode
+		{
+			AABB aabb;		/* Box of the child for leaves, union of both children otherwise */
+			int child2;		/* Second child, -1 for leaves */
+			int shape;		/* Child shape of a leaf, -1 otherwise */
+
+			bool isLeaf() const { return child2 < 0; };
+		};
+
+		/**
+		 * \brief Build the subtree over a range of children, splitting at the median along the longer axis
+		 *
+		 * \param first first entry of order to include
+		 * \param last one past the last entry of order to include
+		 * \return index of the subtree root
+		 */
+		int build(int first, int last) const;
+
+		/**
+		 * \brief Walk the tree, calling a callback with every child whose box overlaps a box
+		 *
+		 * \param aabb box to test
+		 * \param callback called with each child index, returns false to stop the walk
+		 */
+		template<class Callback>
+		void traverse(const AABB& aabb, Callback&& callback) const;
+
+		/**
+		 * \brief Place every child by its offset combined with the compound's transform
+		 */
+		void placeChildren();
+
+		/**\return box of the root, an empty box at the position without children */
+		AABB const& getRootBox() const;
+
+		static constexpr int STACK_SIZE = 64;	/* Entries in the stacks of the tree walks, the tallest tree they can walk */
+
+		Transform2D transform;				/* Placement of the compound in the world */
+		std::vector<Shape> children;		/* Child shapes, placed in the world */
+		std::vector<Transform2D> offsets;	/* Placement of each child relative to the compound */
+
+		// Tree over the children, rebuilt lazily after children are added or removed and refitted after they move
+		mutable std::vector<TreeNode> nodes;	/* Nodes with each parent before its children, the root first */
+		mutable std::vector<int> order;			/* Children sorted into tree order while building */
+		mutable AABB emptyBox;					/* Box reported without children */
+		mutable int height = 0;					/* Height of the tree, 0 without children */
+		mutable bool treeDirty = true;			/* nodes need rebuilding */
+		mutable bool boxesDirty = true;			/* Boxes of nodes need refitting */
+	};
+}
@@ -0,0 +1,264 @@
+/*****************************************************************//**
+ * \file   ContactManifold.cpp
+ * \brief  Implementation of contact manifold generation
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "ContactManifold.h"
+#include "Shape.h"
+
+using namespace WLUW;
+
+namespace
+{
+    constexpr double REFERENCE_TOLERANCE = 0.0005;  /* Prefer a's edge as the reference unless b's is clearly better, so the choice doesn't flicker */
+
+    /**
+     * /enum FeatureType
+     * /brief What part of a polygon a contact point came from
+     */
+    enum FeatureType : std::uint64_t {
+        VERTEX = 0,
+        FACE = 1
+    };
+
+    /**
+     * \struct ClipVertex
+     * \brief Point of the incident edge, and the features it came from
+     */
+    struct ClipVertex
+    {
+        Vector2 point;              /* World-space point */
+        int indexReference;         /* Vertex or edge on the reference polygon */
+        int indexIncident;          /* Vertex or edge on the incident polygon */
+        FeatureType typeReference;  /* Whether indexReference is a vertex or an edge */
+        FeatureType typeIncident;   /* Whether indexIncident is a vertex or an edge */
+    };
+
+    /**
+     * \brief Helper function which packs the features of a contact point into one ID
+     */
+    std::uint64_t packFeature(int indexA, FeatureType typeA, int indexB, FeatureType typeB)
+    {
+        return (static_cast<std::uint64_t>(indexA) << 33) | (typeA << 32) | (static_cast<std::uint64_t>(indexB) << 1) | typeB;
+    }
+
+    /**
+     * \brief Helper function which finds the edge of one polygon that the other polygon is furthest outside of
+     *
+     * \param poly1 polygon whose edges are tested
+     * \param poly2 polygon tested against them
+     * \param edge set to the index of the best edge
+     * \return signed distance of poly2 outside the edge, negative when they overlap along it
+     */
+    double findMaxSeparation(const Shape& poly1, const Shape& poly2, int& edge)
+    {
+        Vector2Array const& points1 = poly1.getWorldPoints();
+        std::vector<Vector2> const& normals1 = poly1.getWorldNormals();
+        Vector2Array const& points2 = poly2.getWorldPoints();
+
+        double maxSeparation = -std::numeric_limits<double>::max();
+        int hint = 0;
+
+        for (int i = 0; i < normals1.size(); i++)
+        {
+            // Deepest point of poly2 behind this edge. Neighbouring edges have similar normals, so the hill climb starts close
+            hint = poly2.supportIndex(-normals1[i], hint);
+            double separation = normals1[i].dot(points2[hint] - points1[i]);
+
+            if (separation > maxSeparation)
+            {
+                maxSeparation = separation;
+                edge = i;
+            }
+
+            // Found a separating edge
+            if (separation > 0.0)
+                break;
+        }
+
+        return maxSeparation;
+    }
+
+    /**
+     * \brief Helper function which clips a segment against a line, keeping the part behind it
+     *
+     * \param out set to the clipped segment
+     * \param in segment to clip
+     * \param normal normal of the line
+     * \param offset distance of the line along the normal
+     * \param vertexReference reference vertex the line passes through, used to label new points
+     * \return number of points kept
+     */
+    int clipSegment(ClipVertex out[2], const ClipVertex in[2], Vector2 normal, double offset, int vertexReference)
+    {
+        int count = 0;
+
+        double distance0 = normal.dot(in[0].point) - offset;
+        double distance1 = normal.dot(in[1].point) - offset;
+
+        if (distance0 <= 0.0)
+            out[count++] = in[0];
+        if (distance1 <= 0.0)
+            out[count++] = in[1];
+
+        // The ends are on opposite sides, add the crossing point
+        if (distance0 * distance1 < 0.0)
+        {
+            double t = distance0 / (distance0 - distance1);
+            out[count].point = in[0].point + (in[1].point - in[0].point) * t;
+            out[count].indexReference = vertexReference;
+            out[count].typeReference = VERTEX;
+            out[count].indexIncident = in[0].indexIncident;
+            out[count].typeIncident = FACE;
+            count++;
+        }
+
+        return count;
+    }
+
+    /**
+     * \brief Helper function which builds the manifold of two polygons by clipping
+     */
+    bool collidePolygons(const Shape& a, const Shape& b, ContactManifold& manifold)
+    {
+        int edgeA = 0;
+        double separationA = findMaxSeparation(a, b, edgeA);
+        if (separationA > 0.0)
+            return false;
+
+        int edgeB = 0;
+        double separationB = findMaxSeparation(b, a, edgeB);
+        if (separationB > 0.0)
+            return false;
+
+        // The edge with the least overlap becomes the reference
+        bool const flip = separationB > separationA + REFERENCE_TOLERANCE;
+        const Shape& reference = flip ? b : a;
+        const Shape& incident = flip ? a : b;
+        int const referenceEdge = flip ? edgeB : edgeA;
+
+        Vector2Array const& referencePoints = reference.getWorldPoints();
+        Vector2Array const& incidentPoints = incident.getWorldPoints();
+        std::vector<Vector2> const& incidentNormals = incident.getWorldNormals();
+        Vector2 const normal = reference.getWorldNormals()[referenceEdge];
+        int const incidentCount = incidentPoints.size();
+
+        // The incident edge faces the reference edge most directly. It is one of the two edges at the deepest vertex
+        int vertex = incident.supportIndex(-normal);
+        int previous = (vertex + incidentCount - 1) % incidentCount;
+        int incidentEdge = incidentNormals[previous].dot(normal) < incidentNormals[vertex].dot(normal) ? previous : vertex;
+
+        ClipVertex incidentSegment[2];
+        for (int i = 0; i < 2; i++)
+        {
+            incidentSegment[i].point = incidentPoints[(incidentEdge + i) % incidentCount];
+            incidentSegment[i].indexReference = referenceEdge;
+            incidentSegment[i].typeReference = FACE;
+            incidentSegment[i].indexIncident = (incidentEdge + i) % incidentCount;
+            incidentSegment[i].typeIncident = VERTEX;
+        }
+
+        // Clip the incident edge to the sides of the reference edge
+        int const referenceNext = (referenceEdge + 1) % referencePoints.size();
+        Vector2 const v1 = referencePoints[referenceEdge];
+        Vector2 const v2 = referencePoints[referenceNext];
+        Vector2 const tangent = (v2 - v1).normalized();
+
+        ClipVertex clipped1[2];
+        if (clipSegment(clipped1, incidentSegment, -tangent, -tangent.dot(v1), referenceEdge) < 2)
+            return false;
+
+        ClipVertex clipped2[2];
+        if (clipSegment(clipped2, clipped1, tangent, tangent.dot(v2), referenceNext) < 2)
+            return false;
+
+        // Keep the points which are behind the reference edge
+        double const frontOffset = normal.dot(v1);
+        manifold.pointCount = 0;
+
+        for (int i = 0; i < 2; i++)
+        {
+            double separation = normal.dot(clipped2[i].point) - frontOffset;
+            if (separation > 0.0)
+                continue;
+
+            ContactPoint& point = manifold.points[manifold.pointCount++];
+            point.position = clipped2[i].point - normal * (separation * 0.5);
+            point.depth = -separation;
+            point.normalImpulse = 0.0;
+            point.tangentImpulse = 0.0;
+
+            // Features are always stored as (a, b), whichever shape was the reference
+            if (flip)
+                point.featureId = packFeature(clipped2[i].indexIncident, clipped2[i].typeIncident, clipped2[i].indexReference, clipped2[i].typeReference);
+            else
+                point.featureId = packFeature(clipped2[i].indexReference, clipped2[i].typeReference, clipped2[i].indexIncident, clipped2[i].typeIncident);
+        }
+
+        // The reference normal points from the reference towards the incident shape
+        manifold.normal = flip ? normal : -normal;
+
+        return manifold.pointCount > 0;
+    }
+}
+
+void WLUW::ContactManifold::warmStart(const ContactManifold& previous)
+{
+    for (int i = 0; i < pointCount; i++)
+    {
+        for (int j = 0; j < previous.pointCount; j++)
+        {
+            if (points[i].featureId == previous.points[j].featureId)
+            {
+                points[i].normalImpulse = previous.points[j].normalImpulse;
+                points[i].tangentImpulse = previous.points[j].tangentImpulse;
+                break;
+            }
+        }
+    }
+}
+
+double WLUW::ContactManifold::getMaxDepth() const
+{
+    double depth = 0.0;
+    for (int i = 0; i < pointCount; i++)
+        depth = std::max(depth, points[i].depth);
+
+    return depth;
+}
+
+bool WLUW::computeManifold(const Shape& a, const Shape& b, ContactManifold& manifold, CollisionScratch& scratch)
+{
+    manifold.pointCount = 0;
+
+    if (a.getShapeType() == ShapeType::POLYGON && b.getShapeType() == ShapeType::POLYGON)
+        return collidePolygons(a, b, manifold);
+
+    // Anything involving a circle touches at one point, found from the MTV
+    std::pair<Vector2, double> mtv = Shape::checkCollision(a, b, scratch);
+    if (std::isnan(mtv.second))
+        return false;
+
+    // Put the point halfway into the overlap, measured from the circle's deepest point
+    Vector2 position = a.getShapeType() == ShapeType::CIRCLE
+        ? a.getPosition() - mtv.first * (a.getWorldRadius() - mtv.second * 0.5)
+        : b.getPosition() + mtv.first * (b.getWorldRadius() - mtv.second * 0.5);
+
+    manifold.normal = mtv.first;
+    manifold.pointCount = 1;
+    manifold.points[0].position = position;
+    manifold.points[0].depth = mtv.second;
+    manifold.points[0].featureId = 0;
+    manifold.points[0].normalImpulse = 0.0;
+    manifold.points[0].tangentImpulse = 0.0;
+
+    return true;
+}
@@ -0,0 +1,66 @@
+/*****************************************************************//**
+ * \file   ContactManifold.h
+ * \brief  Contact points between two touching shapes
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "CollisionScratch.h"
+#include "Vector2.h"
+
+namespace WLUW
+{
+	class Shape;
+
+	/**
+	 * \struct ContactPoint
+	 * \brief Single point of contact, with the impulses the solver applied to it
+	 */
+	struct ContactPoint
+	{
+		Vector2 position;				/* World-space point halfway between the two surfaces */
+		double depth;					/* Penetration along the manifold normal */
+		std::uint64_t featureId;		/* Edges and vertices that produced the point, stable while the shapes keep touching the same way */
+		double normalImpulse = 0.0;		/* Accumulated impulse along the normal, carried over to warm start the solver */
+		double tangentImpulse = 0.0;	/* Accumulated friction impulse, carried over to warm start the solver */
+	};
+
+	/**
+	 * \struct ContactManifold
+	 * \brief Up to two contact points sharing one normal. Polygon pairs get their points by clipping the
+	 * incident edge against the reference edge, pairs involving a circle get a single point
+	 */
+	struct ContactManifold
+	{
+		Vector2 normal;				/* Unit axis pointing from b towards a, the same direction as the MTV */
+		ContactPoint points[2];		/* Contact points */
+		int pointCount = 0;			/* Number of points in use */
+
+		/**
+		 * \brief Carry the accumulated impulses over from last update's manifold of the same pair. Points are
+		 * matched by feature ID, so points which appeared or changed feature start from zero
+		 *
+		 * \param previous manifold of the same pair from the previous update
+		 */
+		void warmStart(const ContactManifold& previous);
+
+		/**\return depth of the deepest point, 0 if there are none */
+		double getMaxDepth() const;
+	};
+
+	/**
+	 * \brief Build the contact manifold of two shapes
+	 *
+	 * \param a first shape
+	 * \param b second shape
+	 * \param manifold set to the contacts. Impulses start at zero
+	 * \param scratch working memory for the pairs which go through Shape::checkCollision
+	 * \return true if the shapes touch
+	 */
+	bool computeManifold(const Shape& a, const Shape& b, ContactManifold& manifold, CollisionScratch& scratch);
+}
@@ -0,0 +1,505 @@
+/*****************************************************************//**
+ * \file   ConvexDecomposition.cpp
+ * \brief  Implementation of the convex hull, convex decomposition and decomposition cache
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include "ConvexDecomposition.h"
+
+using namespace WLUW;
+
+namespace
+{
+    std::uint32_t const CACHE_MAGIC = 0x44434C57;   /* "WLCD" read as little-endian */
+
+    /**
+     * \brief Helper function which gets the turn at b going from a to c
+     *
+     * \return twice the signed area of the triangle abc, positive for a left turn
+     */
+    double turn(Vector2 a, Vector2 b, Vector2 c)
+    {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    /**
+     * \brief Helper function which gets twice the signed area of a polygon
+     *
+     * \param points points of the polygon
+     * \return area, negative when the points wind clockwise
+     */
+    double signedArea(const std::vector<Vector2>& points)
+    {
+        double area = 0.0;
+        for (int i = 0; i < points.size(); i++)
+        {
+            Vector2 p1 = points[i];
+            Vector2 p2 = points[(i + 1) % points.size()];
+            area += p1.x * p2.y - p2.x * p1.y;
+        }
+        return area;
+    }
+
+    /**
+     * \brief Helper function which drops repeated and collinear points from a closed outline and winds it
+     * counter-clockwise
+     *
+     * \param points outline to clean, changed in place. Left empty if nothing with area remains
+     */
+    void cleanOutline(std::vector<Vector2>& points)
+    {
+        // Removing one point can make its neighbours collinear, so keep going until a full pass changes nothing
+        bool changed = true;
+        while (changed && points.size() >= 3)
+        {
+            changed = false;
+            for (int i = 0; i < points.size() && points.size() >= 3; )
+            {
+                int n = static_cast<int>(points.size());
+                Vector2 prev = points[(i + n - 1) % n];
+                Vector2 next = points[(i + 1) % n];
+
+                if (points[i] == next || turn(prev, points[i], next) == 0.0)
+                {
+                    points.erase(points.begin() + i);
+                    changed = true;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+
+        double area = signedArea(points);
+        if (points.size() < 3 || area == 0.0)
+        {
+            points.clear();
+            return;
+        }
+
+        if (area < 0.0)
+            std::reverse(points.begin(), points.end());
+    }
+
+    /**
+     * \brief Helper function which checks if a point lies in or on a counter-clockwise triangle
+     */
+    bool inTriangle(Vector2 p, Vector2 a, Vector2 b, Vector2 c)
+    {
+        return turn(a, b, p) >= 0.0 && turn(b, c, p) >= 0.0 && turn(c, a, p) >= 0.0;
+    }
+
+    /**
+     * \brief Helper function which checks if a corner of the remaining polygon can be clipped off as an ear
+     *
+     * \param points outline points
+     * \param polygon indices of the points still in the polygon, counter-clockwise
+     * \param corner position of the corner in polygon
+     * \return true if the corner is convex and no other point lies in the triangle it makes with its neighbours
+     */
+    bool isEar(const std::vector<Vector2>& points, const std::vector<int>& polygon, int corner)
+    {
+        int const n = static_cast<int>(polygon.size());
+        Vector2 const a = points[polygon[(corner + n - 1) % n]];
+        Vector2 const b = points[polygon[corner]];
+        Vector2 const c = points[polygon[(corner + 1) % n]];
+
+        if (turn(a, b, c) <= 0.0)
+            return false;
+
+        // Only reflex points can poke into an ear of a simple polygon
+        for (int i = 0; i < n; i++)
+        {
+            if (i == corner || i == (corner + 1) % n || i == (corner + n - 1) % n)
+                continue;
+
+            Vector2 const p = points[polygon[i]];
+            if (turn(points[polygon[(i + n - 1) % n]], p, points[polygon[(i + 1) % n]]) > 0.0)
+                continue;
+
+            if (p != a && p != b && p != c && inTriangle(p, a, b, c))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * \brief Helper function which triangulates a counter-clockwise polygon by clipping ears
+     *
+     * \param points outline points
+     * \return triangles as counter-clockwise index lists
+     */
+    std::vector<std::vector<int>> triangulate(const std::vector<Vector2>& points)
+    {
+        std::vector<int> polygon(points.size());
+        std::iota(polygon.begin(), polygon.end(), 0);
+
+        std::vector<std::vector<int>> triangles;
+        int corner = 0;
+        int attempts = 0;
+
+        while (polygon.size() > 3)
+        {
+            int const n = static_cast<int>(polygon.size());
+            corner %= n;
+
+            // A self-intersecting outline can run out of ears, clip the corner anyway so the loop always ends
+            if (isEar(points, polygon, corner) || attempts >= n)
+            {
+                triangles.push_back({ polygon[(corner + n - 1) % n], polygon[corner], polygon[(corner + 1) % n] });
+                polygon.erase(polygon.begin() + corner);
+                attempts = 0;
+            }
+            else
+            {
+                corner++;
+                attempts++;
+            }
+        }
+
+        triangles.push_back(polygon);
+        return triangles;
+    }
+
+    /**
+     * \brief Helper function which packs a directed edge into a map key
+     */
+    std::uint64_t edgeKey(int from, int to)
+    {
+        return (static_cast<std::uint64_t>(from) << 32) | static_cast<std::uint32_t>(to);
+    }
+
+    /**
+     * \brief Helper function which merges neighbouring convex pieces across every diagonal whose removal
+     * leaves the merged piece convex
+     *
+     * \param points outline points
+     * \param pieces counter-clockwise index lists, merged in place. Merged away pieces are left empty
+     */
+    void mergePieces(const std::vector<Vector2>& points, std::vector<std::vector<int>>& pieces)
+    {
+        // Map every directed edge to its piece. A diagonal shows up once in each direction, owned by the pieces either side
+        std::unordered_map<std::uint64_t, int> owners;
+        for (int i = 0; i < pieces.size(); i++)
+        {
+            for (int k = 0; k < pieces[i].size(); k++)
+                owners[edgeKey(pieces[i][k], pieces[i][(k + 1) % pieces[i].size()])] = i;
+        }
+
+        std::vector<int> merged;
+        for (int i = 0; i < pieces.size(); i++)
+        {
+            for (int k = 0; k < pieces[i].size(); )
+            {
+                std::vector<int>& piece = pieces[i];
+                int const n = static_cast<int>(piece.size());
+                int const a = piece[k];
+                int const b = piece[(k + 1) % n];
+
+                auto owner = owners.find(edgeKey(b, a));
+                if (owner == owners.end() || owner->second == i)
+                {
+                    k++;
+                    continue;
+                }
+
+                std::vector<int>& other = pieces[owner->second];
+                int const m = static_cast<int>(other.size());
+                int const start = static_cast<int>(std::find(other.begin(), other.end(), a) - other.begin());
+
+                // Walk this piece from b round to a, then the other piece from a round to b
+                merged.clear();
+                for (int t = 1; t <= n; t++)
+                    merged.push_back(piece[(k + t) % n]);
+                for (int t = 1; t < m - 1; t++)
+                    merged.push_back(other[(start + t) % m]);
+
+                // Only the corners at the ends of the removed diagonal can have become reflex
+                int const size = static_cast<int>(merged.size());
+                bool convexAtA = turn(points[merged[n - 2]], points[merged[n - 1]], points[merged[n % size]]) >= 0.0;
+                bool convexAtB = turn(points[merged[size - 1]], points[merged[0]], points[merged[1]]) >= 0.0;
+                if (!convexAtA || !convexAtB)
+                {
+                    k++;
+                    continue;
+                }
+
+                owners.erase(edgeKey(a, b));
+                owners.erase(edgeKey(b, a));
+                for (int t = 0; t < m; t++)
+                {
+                    auto edge = owners.find(edgeKey(other[t], other[(t + 1) % m]));
+                    if (edge != owners.end())
+                        edge->second = i;
+                }
+
+                other.clear();
+                piece = merged;
+                k = 0;
+            }
+        }
+    }
+
+    /**
+     * \brief Helper function which writes a value to a binary stream
+     */
+    template<class T>
+    void writeValue(std::ofstream& file, T value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /**
+     * \brief Helper function which reads a value from a binary stream
+     *
+     * \return false if the stream ran out
+     */
+    template<class T>
+    bool readValue(std::ifstream& file, T& value)
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    /**
+     * \brief Helper function which writes a list of points to a binary stream
+     */
+    void writePoints(std::ofstream& file, const std::vector<Vector2>& points)
+    {
+        writeValue(file, static_cast<std::uint32_t>(points.size()));
+        for (Vector2 p : points)
+        {
+            writeValue(file, p.x);
+            writeValue(file, p.y);
+        }
+    }
+
+    /**
+     * \brief Helper function which reads a list of points from a binary stream
+     *
+     * \param maxCount largest count to accept, guarding against corrupt files
+     * \return false if the stream ran out or the count was too large
+     */
+    bool readPoints(std::ifstream& file, std::vector<Vector2>& points, std::uint32_t maxCount)
+    {
+        std::uint32_t count;
+        if (!readValue(file, count) || count > maxCount)
+            return false;
+
+        points.resize(count);
+        for (Vector2& p : points)
+        {
+            if (!readValue(file, p.x) || !readValue(file, p.y))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+std::vector<Vector2> WLUW::convexHull(const std::vector<Vector2>& points)
+{
+    std::vector<Vector2> sorted = points;
+    std::sort(sorted.begin(), sorted.end(), [](Vector2 u, Vector2 v) { return u.x < v.x || (u.x == v.x && u.y < v.y); });
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    if (sorted.size() < 3)
+        return sorted;
+
+    // Build the lower chain left to right, then the upper chain right to left, popping anything that doesn't turn left
+    std::vector<Vector2> hull(2 * sorted.size());
+    int size = 0;
+
+    for (int i = 0; i < sorted.size(); i++)
+    {
+        while (size >= 2 && turn(hull[size - 2], hull[size - 1], sorted[i]) <= 0.0)
+            size--;
+        hull[size++] = sorted[i];
+    }
+
+    int const lowerSize = size + 1;
+    for (int i = static_cast<int>(sorted.size()) - 2; i >= 0; i--)
+    {
+        while (size >= lowerSize && turn(hull[size - 2], hull[size - 1], sorted[i]) <= 0.0)
+            size--;
+        hull[size++] = sorted[i];
+    }
+
+    // The last point repeats the first
+    hull.resize(size - 1);
+    return hull;
+}
+
+ConvexPieces WLUW::convexDecomposition(const std::vector<Vector2>& outline)
+{
+    std::vector<Vector2> points = outline;
+    cleanOutline(points);
+
+    ConvexPieces result;
+    if (points.empty())
+        return result;
+
+    std::vector<std::vector<int>> pieces = triangulate(points);
+    mergePieces(points, pieces);
+
+    for (const std::vector<int>& piece : pieces)
+    {
+        if (piece.empty())
+            continue;
+
+        std::vector<Vector2> convex;
+        for (int index : piece)
+            convex.push_back(points[index]);
+
+        // Merging can leave a straight corner where a diagonal met the outline
+        cleanOutline(convex);
+        if (!convex.empty())
+            result.push_back(std::move(convex));
+    }
+
+    return result;
+}
+
+std::vector<Shape> WLUW::makeConvexShapes(const ConvexPieces& pieces, Vector2 pos)
+{
+    std::vector<Shape> shapes;
+    shapes.reserve(pieces.size());
+
+    for (const std::vector<Vector2>& piece : pieces)
+    {
+        std::vector<Vector2> points = piece;
+        shapes.emplace_back(points, pos);
+    }
+
+    return shapes;
+}
+
+WLUW::DecompositionCache::DecompositionCache(const std::string& directory)
+    : directory(directory)
+{
+}
+
+ConvexPieces WLUW::DecompositionCache::decompose(const std::vector<Vector2>& outline)
+{
+    std::string const path = getPath(outline);
+
+    ConvexPieces pieces;
+    if (load(path, outline, pieces))
+    {
+        hits++;
+        return pieces;
+    }
+
+    misses++;
+    pieces = convexDecomposition(outline);
+    save(path, outline, pieces);
+    return pieces;
+}
+
+std::uint64_t WLUW::DecompositionCache::hashOutline(const std::vector<Vector2>& outline)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    // Feed bytes lowest first, so the hash doesn't depend on the machine's byte order
+    auto feed = [&hash](std::uint64_t value) {
+        for (int i = 0; i < 8; i++)
+        {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    feed(outline.size());
+    for (Vector2 p : outline)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &p.x, sizeof(bits));
+        feed(bits);
+        std::memcpy(&bits, &p.y, sizeof(bits));
+        feed(bits);
+    }
+
+    return hash;
+}
+
+std::string WLUW::DecompositionCache::getPath(const std::vector<Vector2>& outline) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.wcd", static_cast<unsigned long long>(hashOutline(outline)));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+bool WLUW::DecompositionCache::load(const std::string& path, const std::vector<Vector2>& outline, ConvexPieces& pieces) const
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    std::uint32_t magic, version;
+    if (!readValue(file, magic) || !readValue(file, version) || magic != CACHE_MAGIC || version != FORMAT_VERSION)
+        return false;
+
+    // A different outline with the same hash, or a file from elsewhere
+    std::vector<Vector2> stored;
+    std::uint32_t const maxCount = static_cast<std::uint32_t>(outline.size());
+    if (!readPoints(file, stored, maxCount) || stored != outline)
+        return false;
+
+    // Pieces never outnumber or outsize the outline
+    std::uint32_t pieceCount;
+    if (!readValue(file, pieceCount) || pieceCount > maxCount)
+        return false;
+
+    pieces.resize(pieceCount);
+    for (std::vector<Vector2>& piece : pieces)
+    {
+        if (!readPoints(file, piece, maxCount))
+            return false;
+    }
+
+    return true;
+}
+
+void WLUW::DecompositionCache::save(const std::string& path, const std::vector<Vector2>& outline, const ConvexPieces& pieces) const
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    // Write beside the final file and rename it into place, so a reader never sees half a file
+    std::string const temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return;
+
+        writeValue(file, CACHE_MAGIC);
+        writeValue(file, FORMAT_VERSION);
+        writePoints(file, outline);
+        writeValue(file, static_cast<std::uint32_t>(pieces.size()));
+        for (const std::vector<Vector2>& piece : pieces)
+            writePoints(file, piece);
+
+        if (!file)
+        {
+            file.close();
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+        std::filesystem::remove(temporary, error);
+}
@@ -0,0 +1,115 @@
+/*****************************************************************//**
+ * \file   ConvexDecomposition.h
+ * \brief  Convex hulls and convex decomposition of concave outlines, with a disk cache
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Shape.h"
+#include "Vector2.h"
+
+namespace WLUW
+{
+	/* Convex pieces of an outline, each a list of points wound counter-clockwise */
+	using ConvexPieces = std::vector<std::vector<Vector2>>;
+
+	/**
+	 * \brief Finds the convex hull of a set of points with Andrew's monotone chain, in O(n log n)
+	 *
+	 * \param points points to wrap, in any order
+	 * \return hull wound counter-clockwise from the lowest leftmost point, without collinear or repeated points
+	 */
+	std::vector<Vector2> convexHull(const std::vector<Vector2>& points);
+
+	/**
+	 * \brief Splits a simple polygon into convex pieces. The outline is triangulated by ear clipping, then
+	 * neighbouring pieces are merged across every diagonal whose removal keeps them convex (Hertel-Mehlhorn).
+	 * The result has at most four times as many pieces as the fewest possible, and convex outlines come back whole
+	 *
+	 * \param outline points of the polygon in either winding. Repeated and collinear points are dropped
+	 * \return convex pieces, empty if the outline has no area
+	 */
+	ConvexPieces convexDecomposition(const std::vector<Vector2>& outline);
+
+	/**
+	 * \brief Build a polygon shape from each convex piece
+	 *
+	 * \param pieces convex pieces, such as from convexDecomposition
+	 * \param pos position of every shape
+	 * \return one shape per piece
+	 */
+	std::vector<Shape> makeConvexShapes(const ConvexPieces& pieces, Vector2 pos = Vector2());
+
+	/**
+	 * \class DecompositionCache ConvexDecomposition.h
+	 * \brief Keeps the convex decompositions of outlines on disk, one file per outline named by a hash of its
+	 * points, so loading a level doesn't decompose the same art again. Files store the outline too, so a hash
+	 * collision or a stale file is recomputed rather than trusted. The cache is only an optimisation: if the
+	 * directory can't be read or written, outlines are simply decomposed every time
+	 */
+	class DecompositionCache
+	{
+	public:
+		/* Bumped whenever the decomposition or file format changes, which retires every old file */
+		static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param directory folder to keep the files in, created when the first file is written
+		 */
+		DecompositionCache(const std::string& directory);
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Get the convex decomposition of an outline, from disk if it was decomposed before
+		 *
+		 * \param outline points of the polygon
+		 * \return convex pieces, exactly as convexDecomposition would return them
+		 */
+		ConvexPieces decompose(const std::vector<Vector2>& outline);
+
+		/**
+		 * \brief Hashes the exact bits of an outline with 64-bit FNV-1a
+		 *
+		 * \param outline points to hash
+		 * \return hash, the same on every platform
+		 */
+		static std::uint64_t hashOutline(const std::vector<Vector2>& outline);
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return number of outlines found on disk */
+		int getHits() const { return hits; };
+
+		/**\return number of outlines which had to be decomposed */
+		int getMisses() const { return misses; };
+
+		/**\return path of the file an outline is kept in */
+		std::string getPath(const std::vector<Vector2>& outline) const;
+
+	private:
+		bool load(const std::string& path, const std::vector<Vector2>& outline, ConvexPieces& pieces) const;
+		void save(const std::string& path, const std::vector<Vector2>& outline, const ConvexPieces& pieces) const;
+
+		std::string directory;	/* Folder holding the files */
+		int hits = 0;			/* Outlines found on disk */
+		int misses = 0;			/* Outlines decomposed */
+	};
+}
@@ -0,0 +1,67 @@
+/*****************************************************************//**
+ * \file   CpuFeatures.cpp
+ * \brief  Implementation of runtime SIMD detection
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include "CpuFeatures.h"
+
+#if WLUW_X86 && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+using namespace WLUW;
+
+/**
+ * \brief Helper function which asks the CPU which instruction sets it supports
+ *
+ * \return the best available SIMD level
+ */
+SimdLevel detectSimdLevel()
+{
+#if WLUW_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx)
+    {
+        // The OS also has to save the upper halves of the YMM registers
+        bool ymmEnabled = (_xgetbv(0) & 0x6) == 0x6;
+
+        __cpuidex(info, 7, 0);
+        avx2 = ymmEnabled && (info[1] & (1 << 5)) != 0;
+    }
+
+    if (avx2)
+        return SimdLevel::AVX2;
+    if (sse2)
+        return SimdLevel::SSE2;
+    return SimdLevel::SCALAR;
+#elif WLUW_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::SSE2;
+    return SimdLevel::SCALAR;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+SimdLevel WLUW::getSimdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
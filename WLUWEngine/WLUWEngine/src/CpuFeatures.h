@@ -0,0 +1,43 @@
+/*****************************************************************//**
+ * \file   CpuFeatures.h
+ * \brief  Runtime detection of the SIMD instruction sets the CPU supports
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+// SIMD kernels are only compiled for x86 targets, everything else uses the scalar paths
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define WLUW_X86 1
+#else
+#define WLUW_X86 0
+#endif
+
+// MSVC lets any function use AVX2 intrinsics, GCC and Clang need each function marked
+#if WLUW_X86 && (defined(__GNUC__) || defined(__clang__))
+#define WLUW_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WLUW_TARGET_AVX2
+#endif
+
+namespace WLUW
+{
+	/**
+	 * /enum WLUW::SimdLevel
+	 * /brief Instruction sets a kernel can be dispatched to, from slowest to fastest
+	 */
+	enum class SimdLevel {
+		SCALAR,
+		SSE2,
+		AVX2
+	};
+
+	/**
+	 * \brief Get the fastest instruction set supported by both the build and the CPU. Detected once on first call
+	 *
+	 * \return the best available SIMD level
+	 */
+	SimdLevel getSimdLevel();
+}
@@ -0,0 +1,319 @@
+/*****************************************************************//**
+ * \file   Fixed.h
+ * \brief  Fixed-point scalar for simulation which must give the same bits on every build
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+namespace WLUW
+{
+	/**
+	 * \class Fixed Fixed.h
+	 * \brief Signed fixed-point number with 16 fractional bits stored in 64 bits. Every operation is integer
+	 * arithmetic, so results don't depend on the compiler, optimisation flags or floating-point unit, which
+	 * lockstep multiplayer and replays need. The resolution is 1/65536 and the range about +-2^47. Products,
+	 * quotients and square roots which would overflow 64 bits are worked out across two words instead, and
+	 * products and quotients beyond the range saturate at its ends. Sums and differences still wrap, so keep
+	 * them inside the range.
+	 *
+	 * Integers convert implicitly. Doubles only convert explicitly, so floating-point values can't sneak into
+	 * a deterministic calculation unnoticed
+	 */
+	class Fixed
+	{
+	public:
+		static constexpr int FRACTION_BITS = 16;								/* Bits after the binary point */
+		static constexpr std::int64_t ONE = std::int64_t(1) << FRACTION_BITS;	/* Raw value of 1 */
+
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor. Creates 0
+		 */
+		constexpr Fixed() noexcept : raw(0)
+		{
+		}
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param value whole number
+		 */
+		constexpr Fixed(int value) noexcept : raw(static_cast<std::int64_t>(value) * ONE)
+		{
+		}
+
+		/**
+		 * \brief Constructor. Rounds to the nearest representable value
+		 *
+		 * \param value number to convert
+		 */
+		explicit constexpr Fixed(double value) noexcept : raw(static_cast<std::int64_t>(value * ONE + (value < 0.0 ? -0.5 : 0.5)))
+		{
+		}
+
+		/**
+		 * \param value raw value, the number times 2^FRACTION_BITS
+		 * \return fixed-point number with the raw value
+		 */
+		static constexpr Fixed fromRaw(std::int64_t value) noexcept
+		{
+			Fixed result;
+			result.raw = value;
+			return result;
+		}
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return raw value, the number times 2^FRACTION_BITS */
+		constexpr std::int64_t getRaw() const noexcept { return raw; };
+
+		/**\return nearest double, for display and debugging */
+		constexpr double toDouble() const noexcept { return static_cast<double>(raw) / ONE; };
+
+		explicit constexpr operator double() const noexcept { return toDouble(); };
+
+		/////////////////////
+		//// Operators
+		/////////////////////
+
+		friend constexpr Fixed operator+(Fixed a, Fixed b) noexcept { return fromRaw(a.raw + b.raw); }
+		friend constexpr Fixed operator-(Fixed a, Fixed b) noexcept { return fromRaw(a.raw - b.raw); }
+		friend constexpr Fixed operator-(Fixed a) noexcept { return fromRaw(-a.raw); }
+
+		// Products and quotients round towards negative infinity, the same on every platform
+		friend constexpr Fixed operator*(Fixed a, Fixed b) noexcept
+		{
+			// Factors below 2^31 raw can't overflow 64 bits, which covers nearly every product
+			if (fitsHalfWord(a.raw) && fitsHalfWord(b.raw))
+				return fromRaw((a.raw * b.raw) >> FRACTION_BITS);
+
+			bool const negative = (a.raw < 0) != (b.raw < 0);
+			WideProduct const product = multiplyWide(magnitude(a.raw), magnitude(b.raw));
+			if ((product.high >> FRACTION_BITS) != 0)
+				return fromMagnitude(negative, std::numeric_limits<std::uint64_t>::max(), false);
+
+			std::uint64_t const shifted = (product.high << (64 - FRACTION_BITS)) | (product.low >> FRACTION_BITS);
+			return fromMagnitude(negative, shifted, (product.low & (ONE - 1)) != 0);
+		}
+
+		friend constexpr Fixed operator/(Fixed a, Fixed b)
+		{
+			if (b.raw == 0)
+				throw("Division by zero");
+
+			// Numerators below 2^47 raw can be scaled up by ONE without overflowing
+			if (fitsScaled(a.raw))
+			{
+				std::int64_t numerator = a.raw * ONE;
+				std::int64_t quotient = numerator / b.raw;
+
+				// Integer division truncates towards zero, step down to match the rounding of the product
+				if ((numerator % b.raw != 0) && ((numerator < 0) != (b.raw < 0)))
+					quotient--;
+
+				return fromRaw(quotient);
+			}
+
+			// Otherwise divide the whole part first, then long divide the remainder one fraction bit at a time
+			bool const negative = (a.raw < 0) != (b.raw < 0);
+			std::uint64_t const divisor = magnitude(b.raw);
+			std::uint64_t const whole = magnitude(a.raw) / divisor;
+			std::uint64_t remainder = magnitude(a.raw) % divisor;
+			if ((whole >> (63 - FRACTION_BITS)) != 0)
+				return fromMagnitude(negative, std::numeric_limits<std::uint64_t>::max(), false);
+
+			std::uint64_t fraction = 0;
+			for (int i = 0; i < FRACTION_BITS; i++)
+			{
+				// remainder is below divisor, which is at most 2^63, so doubling it can't overflow
+				remainder <<= 1;
+				fraction <<= 1;
+				if (remainder >= divisor)
+				{
+					remainder -= divisor;
+					fraction |= 1;
+				}
+			}
+
+			return fromMagnitude(negative, (whole << FRACTION_BITS) | fraction, remainder != 0);
+		}
+
+		constexpr Fixed& operator+=(Fixed other) noexcept { return *this = *this + other; }
+		constexpr Fixed& operator-=(Fixed other) noexcept { return *this = *this - other; }
+		constexpr Fixed& operator*=(Fixed other) noexcept { return *this = *this * other; }
+		constexpr Fixed& operator/=(Fixed other) { return *this = *this / other; }
+
+		friend constexpr bool operator==(Fixed a, Fixed b) noexcept = default;
+		friend constexpr auto operator<=>(Fixed a, Fixed b) noexcept = default;
+
+		/////////////////////
+		//// Functions
+		/////////////////////
+
+		/**
+		 * \brief Square root by the digit-by-digit integer method, exact to the last bit on every platform
+		 *
+		 * \param value number to take the root of, negative numbers give 0
+		 * \return largest fixed-point number whose square doesn't exceed value
+		 */
+		friend constexpr Fixed sqrt(Fixed value) noexcept
+		{
+			if (value.raw <= 0)
+				return Fixed();
+
+			// sqrt(raw / ONE) * ONE == sqrt(raw * ONE)
+			if (fitsScaled(value.raw))
+				return fromRaw(static_cast<std::int64_t>(integerSqrt(static_cast<std::uint64_t>(value.raw) << FRACTION_BITS)));
+
+			// raw * ONE needs two words. sqrt(raw) * 2^8 is at most 2^8 short of the root, so fill in the low
+			// 8 bits one at a time, keeping each while the square stays within raw * ONE
+			std::uint64_t root = integerSqrt(static_cast<std::uint64_t>(value.raw)) << (FRACTION_BITS / 2);
+			std::uint64_t const high = static_cast<std::uint64_t>(value.raw) >> (64 - FRACTION_BITS);
+			std::uint64_t const low = static_cast<std::uint64_t>(value.raw) << FRACTION_BITS;
+			for (std::uint64_t bit = std::uint64_t(1) << (FRACTION_BITS / 2 - 1); bit != 0; bit >>= 1)
+			{
+				WideProduct const square = multiplyWide(root | bit, root | bit);
+				if (square.high < high || (square.high == high && square.low <= low))
+					root |= bit;
+			}
+
+			return fromRaw(static_cast<std::int64_t>(root));
+		}
+
+		/**\return absolute value */
+		friend constexpr Fixed abs(Fixed value) noexcept { return value.raw < 0 ? -value : value; }
+
+	private:
+		/**
+		 * \struct WideProduct
+		 * \brief 128-bit unsigned product, split into two words
+		 */
+		struct WideProduct
+		{
+			std::uint64_t high;	/* Upper 64 bits */
+			std::uint64_t low;	/* Lower 64 bits */
+		};
+
+		/**\return true if the raw value is below 2^31 in magnitude, so the product of two such values fits 64 bits */
+		static constexpr bool fitsHalfWord(std::int64_t value) noexcept { return value >= -(std::int64_t(1) << 31) && value < (std::int64_t(1) << 31); };
+
+		/**\return true if the raw value times ONE fits 64 bits, with room to negate it */
+		static constexpr bool fitsScaled(std::int64_t value) noexcept
+		{
+			return value > -(std::int64_t(1) << (63 - FRACTION_BITS)) && value < (std::int64_t(1) << (63 - FRACTION_BITS));
+		};
+
+		/**\return magnitude of a raw value, exact for the most negative one too */
+		static constexpr std::uint64_t magnitude(std::int64_t value) noexcept
+		{
+			return value < 0 ? std::uint64_t(0) - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+		};
+
+		/**
+		 * \brief Multiply two 64-bit numbers into 128 bits from their 32-bit halves, which every compiler can do
+		 * without a 128-bit type
+		 */
+		static constexpr WideProduct multiplyWide(std::uint64_t a, std::uint64_t b) noexcept
+		{
+			std::uint64_t const aLow = a & 0xFFFFFFFF;
+			std::uint64_t const aHigh = a >> 32;
+			std::uint64_t const bLow = b & 0xFFFFFFFF;
+			std::uint64_t const bHigh = b >> 32;
+
+			std::uint64_t const lowLow = aLow * bLow;
+			std::uint64_t const highLow = aHigh * bLow;
+			std::uint64_t const lowHigh = aLow * bHigh;
+			std::uint64_t const highHigh = aHigh * bHigh;
+
+			// Middle column, carrying from the low word into the high one
+			std::uint64_t const middle = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + (lowHigh & 0xFFFFFFFF);
+			return { highHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32), (middle << 32) | (lowLow & 0xFFFFFFFF) };
+		}
+
+		/**
+		 * \brief Give a rounded down magnitude its sign, saturating at the ends of the range
+		 *
+		 * \param negative whether the result is negative
+		 * \param value magnitude of the result in raw units, rounded towards zero
+		 * \param inexact whether bits were dropped rounding value, which moves negative results down one more
+		 * \return signed result, rounded towards negative infinity
+		 */
+		static constexpr Fixed fromMagnitude(bool negative, std::uint64_t value, bool inexact) noexcept
+		{
+			std::uint64_t const largest = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+			if (!negative)
+				return fromRaw(static_cast<std::int64_t>(value > largest ? largest : value));
+
+			// Saturates at -largest rather than the most negative raw value, to match numeric_limits::lowest
+			if (value >= largest)
+				return fromRaw(-static_cast<std::int64_t>(largest));
+
+			return fromRaw(-static_cast<std::int64_t>(value) - (inexact ? 1 : 0));
+		}
+
+		/**
+		 * \brief Square root of an integer by the digit-by-digit method
+		 *
+		 * \return largest integer whose square doesn't exceed value
+		 */
+		static constexpr std::uint64_t integerSqrt(std::uint64_t value) noexcept
+		{
+			std::uint64_t remainder = value;
+			std::uint64_t root = 0;
+			std::uint64_t bit = std::uint64_t(1) << 62;
+
+			while (bit > remainder)
+				bit >>= 2;
+
+			while (bit != 0)
+			{
+				if (remainder >= root + bit)
+				{
+					remainder -= root + bit;
+					root = (root >> 1) + bit;
+				}
+				else
+				{
+					root >>= 1;
+				}
+				bit >>= 2;
+			}
+
+			return root;
+		}
+
+		std::int64_t raw;	/* Number times 2^FRACTION_BITS */
+	};
+}
+
+namespace std
+{
+	/* Lets generic code ask for the range of a Fixed the same way it does for double */
+	template<>
+	class numeric_limits<WLUW::Fixed>
+	{
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = true;
+		static constexpr bool has_quiet_NaN = false;
+
+		static constexpr WLUW::Fixed min() { return WLUW::Fixed::fromRaw(1); };
+		static constexpr WLUW::Fixed max() { return WLUW::Fixed::fromRaw(std::numeric_limits<std::int64_t>::max()); };
+		static constexpr WLUW::Fixed lowest() { return WLUW::Fixed::fromRaw(std::numeric_limits<std::int64_t>::min() + 1); };
+		static constexpr WLUW::Fixed epsilon() { return WLUW::Fixed::fromRaw(1); };
+	};
+}
@@ -0,0 +1,446 @@
+/*****************************************************************//**
+ * \file   GJK.cpp
+ * \brief  Implementation of the GJK distance and EPA penetration queries
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "GJK.h"
+#include "SATHelpers.h"
+#include "Shape.h"
+
+using namespace WLUW;
+
+// Aliases
+using MTV = std::pair<Vector2, double>;
+
+namespace
+{
+    constexpr int MAX_GJK_ITERATIONS = 64;      /* Cap on GJK iterations, only reached on badly conditioned input */
+    constexpr int MAX_EPA_ITERATIONS = 64;      /* Cap on EPA expansions */
+    constexpr double EPA_TOLERANCE = 1e-10;     /* EPA stops once the polytope is this close to the real boundary */
+    constexpr double EPSILON = 1e-12;           /* Distances below this count as touching */
+
+    /**
+     * \brief Helper function which gets the 2D cross product of two vectors
+     */
+    double cross(Vector2 a, Vector2 b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    /**
+     * \brief Helper function which gets the radius a shape is rounded by. GJK runs on the core and adds this afterwards
+     */
+    double coreRadius(const Shape& shape)
+    {
+        return shape.getShapeType() == ShapeType::CIRCLE ? shape.getWorldRadius() : 0.0;
+    }
+
+    /**
+     * \brief Helper function which gets the support point of a shape's core. A circle's core is its centre
+     *
+     * \param shape shape to search
+     * \param direction direction to search in
+     * \param index vertex to start from, set to the vertex found
+     * \return furthest core point along the direction
+     */
+    Vector2 coreSupport(const Shape& shape, Vector2 direction, int& index)
+    {
+        if (shape.getShapeType() == ShapeType::CIRCLE)
+        {
+            index = 0;
+            return shape.getPosition();
+        }
+
+        index = shape.supportIndex(direction, index);
+        return shape.getWorldPoints()[index];
+    }
+
+    /**
+     * \struct SimplexVertex
+     * \brief Point of the Minkowski difference a - b and the shape points it came from
+     */
+    struct SimplexVertex
+    {
+        Vector2 pointA;     /* Support point on a */
+        Vector2 pointB;     /* Support point on b */
+        Vector2 w;          /* pointA - pointB */
+        double weight;      /* Barycentric weight of this vertex in the closest point */
+        int indexA;         /* Vertex index of pointA */
+        int indexB;         /* Vertex index of pointB */
+    };
+
+    /**
+     * \struct Simplex
+     * \brief Up to three points of the Minkowski difference, reduced each iteration to the smallest set
+     * whose hull contains the point closest to the origin
+     */
+    struct Simplex
+    {
+        SimplexVertex v[3];
+        int count = 0;
+
+        /**\return direction from the simplex towards the origin */
+        Vector2 searchDirection() const
+        {
+            if (count == 1)
+                return -v[0].w;
+
+            // Use the edge normal rather than the closest point, it stays accurate when the origin is close to the edge
+            Vector2 edge = v[1].w - v[0].w;
+            return cross(edge, -v[0].w) > 0.0 ? edge.normal() : -edge.normal();
+        }
+
+        /**
+         * \brief Get the closest points on the two cores
+         *
+         * \param pointA set to the point on a
+         * \param pointB set to the point on b
+         */
+        void witnessPoints(Vector2& pointA, Vector2& pointB) const
+        {
+            pointA = Vector2(0, 0);
+            pointB = Vector2(0, 0);
+
+            for (int i = 0; i < count; i++)
+            {
+                pointA = pointA + v[i].pointA * v[i].weight;
+                pointB = pointB + v[i].pointB * v[i].weight;
+            }
+
+            // A full simplex contains the origin, so the closest points coincide
+            if (count == 3)
+                pointB = pointA;
+        }
+
+        /**
+         * \brief Reduce a segment to the part closest to the origin
+         */
+        void solve2()
+        {
+            Vector2 e12 = v[1].w - v[0].w;
+
+            // Origin is past the first vertex
+            double d12_2 = -v[0].w.dot(e12);
+            if (d12_2 <= 0.0)
+            {
+                v[0].weight = 1.0;
+                count = 1;
+                return;
+            }
+
+            // Origin is past the second vertex
+            double d12_1 = v[1].w.dot(e12);
+            if (d12_1 <= 0.0)
+            {
+                v[1].weight = 1.0;
+                v[0] = v[1];
+                count = 1;
+                return;
+            }
+
+            double inverse = 1.0 / (d12_1 + d12_2);
+            v[0].weight = d12_1 * inverse;
+            v[1].weight = d12_2 * inverse;
+            count = 2;
+        }
+
+        /**
+         * \brief Reduce a triangle to the vertex, edge or interior closest to the origin
+         */
+        void solve3()
+        {
+            Vector2 w1 = v[0].w;
+            Vector2 w2 = v[1].w;
+            Vector2 w3 = v[2].w;
+
+            // Edge regions, d_ij_k is the barycentric weight of the vertex opposite k along edge ij
+            Vector2 e12 = w2 - w1;
+            double d12_1 = w2.dot(e12);
+            double d12_2 = -w1.dot(e12);
+
+            Vector2 e13 = w3 - w1;
+            double d13_1 = w3.dot(e13);
+            double d13_2 = -w1.dot(e13);
+
+            Vector2 e23 = w3 - w2;
+            double d23_1 = w3.dot(e23);
+            double d23_2 = -w2.dot(e23);
+
+            // Triangle region
+            double n123 = cross(e12, e13);
+            double d123_1 = n123 * cross(w2, w3);
+            double d123_2 = n123 * cross(w3, w1);
+            double d123_3 = n123 * cross(w1, w2);
+
+            if (d12_2 <= 0.0 && d13_2 <= 0.0)
+            {
+                v[0].weight = 1.0;
+                count = 1;
+            }
+            else if (d12_1 > 0.0 && d12_2 > 0.0 && d123_3 <= 0.0)
+            {
+                double inverse = 1.0 / (d12_1 + d12_2);
+                v[0].weight = d12_1 * inverse;
+                v[1].weight = d12_2 * inverse;
+                count = 2;
+            }
+            else if (d13_1 > 0.0 && d13_2 > 0.0 && d123_2 <= 0.0)
+            {
+                double inverse = 1.0 / (d13_1 + d13_2);
+                v[0].weight = d13_1 * inverse;
+                v[2].weight = d13_2 * inverse;
+                v[1] = v[2];
+                count = 2;
+            }
+            else if (d12_1 <= 0.0 && d23_2 <= 0.0)
+            {
+                v[1].weight = 1.0;
+                v[0] = v[1];
+                count = 1;
+            }
+            else if (d13_1 <= 0.0 && d23_1 <= 0.0)
+            {
+                v[2].weight = 1.0;
+                v[0] = v[2];
+                count = 1;
+            }
+            else if (d23_1 > 0.0 && d23_2 > 0.0 && d123_1 <= 0.0)
+            {
+                double inverse = 1.0 / (d23_1 + d23_2);
+                v[1].weight = d23_1 * inverse;
+                v[2].weight = d23_2 * inverse;
+                v[0] = v[2];
+                count = 2;
+            }
+            else
+            {
+                // Origin is inside the triangle
+                double inverse = 1.0 / (d123_1 + d123_2 + d123_3);
+                v[0].weight = d123_1 * inverse;
+                v[1].weight = d123_2 * inverse;
+                v[2].weight = d123_3 * inverse;
+                count = 3;
+            }
+        }
+    };
+
+    /**
+     * \brief Helper function which runs GJK on the cores of two shapes
+     *
+     * \param a first shape
+     * \param b second shape
+     * \param offsetB translation applied to b
+     * \param simplex set to the final simplex. Three vertices means the cores overlap
+     * \return number of iterations taken
+     */
+    int runGJK(const Shape& a, const Shape& b, Vector2 offsetB, Simplex& simplex)
+    {
+        int indexA = 0;
+        int indexB = 0;
+
+        // Start from the support points facing each other
+        Vector2 direction = b.getBoundingBox().getCenter() + offsetB - a.getBoundingBox().getCenter();
+        if (direction.dot(direction) < EPSILON * EPSILON)
+            direction = Vector2(1, 0);
+
+        SimplexVertex& first = simplex.v[0];
+        first.pointA = coreSupport(a, direction, indexA);
+        first.pointB = coreSupport(b, -direction, indexB) + offsetB;
+        first.w = first.pointA - first.pointB;
+        first.weight = 1.0;
+        first.indexA = indexA;
+        first.indexB = indexB;
+        simplex.count = 1;
+
+        int iteration = 0;
+        while (iteration < MAX_GJK_ITERATIONS)
+        {
+            // Remember the current vertices so a repeat can be spotted
+            int savedA[3], savedB[3];
+            int savedCount = simplex.count;
+            for (int i = 0; i < savedCount; i++)
+            {
+                savedA[i] = simplex.v[i].indexA;
+                savedB[i] = simplex.v[i].indexB;
+            }
+
+            if (simplex.count == 2)
+                simplex.solve2();
+            else if (simplex.count == 3)
+                simplex.solve3();
+
+            // Origin is inside the simplex
+            if (simplex.count == 3)
+                break;
+
+            // Origin is on the simplex, the cores touch
+            direction = simplex.searchDirection();
+            if (direction.dot(direction) < EPSILON * EPSILON)
+                break;
+
+            SimplexVertex& vertex = simplex.v[simplex.count];
+            vertex.pointA = coreSupport(a, direction, indexA);
+            vertex.pointB = coreSupport(b, -direction, indexB) + offsetB;
+            vertex.w = vertex.pointA - vertex.pointB;
+            vertex.indexA = indexA;
+            vertex.indexB = indexB;
+
+            iteration++;
+
+            // No new support point means no further progress towards the origin
+            bool duplicate = false;
+            for (int i = 0; i < savedCount && !duplicate; i++)
+                duplicate = vertex.indexA == savedA[i] && vertex.indexB == savedB[i];
+
+            if (duplicate)
+                break;
+
+            simplex.count++;
+        }
+
+        // Out of iterations right after adding a vertex, which has no weight yet. Solve once more so the witness
+        // points are sound and a full simplex really contains the origin
+        if (iteration == MAX_GJK_ITERATIONS)
+        {
+            if (simplex.count == 2)
+                simplex.solve2();
+            else if (simplex.count == 3)
+                simplex.solve3();
+        }
+
+        return iteration;
+    }
+
+    /**
+     * \brief Helper function which finds the penetration of two shapes whose cores overlap with EPA
+     *
+     * \param a first shape
+     * \param b second shape
+     * \param simplex triangle from GJK containing the origin
+     * \param scratch holds the polytope
+     * \return MTV which pushes a out of b
+     */
+    MTV runEPA(const Shape& a, const Shape& b, const Simplex& simplex, CollisionScratch& scratch)
+    {
+        int indexA = simplex.v[0].indexA;
+        int indexB = simplex.v[0].indexB;
+
+        // Start from the GJK triangle, wound counter-clockwise
+        std::vector<Vector2>& polytope = scratch.polytope;
+        polytope.clear();
+        polytope.push_back(simplex.v[0].w);
+        polytope.push_back(simplex.v[1].w);
+        polytope.push_back(simplex.v[2].w);
+
+        if (cross(polytope[1] - polytope[0], polytope[2] - polytope[0]) < 0.0)
+            std::swap(polytope[1], polytope[2]);
+
+        Vector2 bestNormal(0, 0);
+        double bestDistance = std::numeric_limits<double>::max();
+
+        for (int iteration = 0; iteration < MAX_EPA_ITERATIONS; iteration++)
+        {
+            // Find the edge of the polytope closest to the origin
+            int closest = -1;
+            bestDistance = std::numeric_limits<double>::max();
+
+            for (int i = 0; i < polytope.size(); i++)
+            {
+                Vector2 edge = polytope[(i + 1) % polytope.size()] - polytope[i];
+                double length = edge.size();
+                if (length < EPSILON)
+                    continue;
+
+                Vector2 normal = -edge.normal() / length;
+                double distance = normal.dot(polytope[i]);
+
+                if (distance < bestDistance)
+                {
+                    closest = i;
+                    bestNormal = normal;
+                    bestDistance = distance;
+                }
+            }
+
+            if (closest == -1)
+                break;
+
+            // Push the edge out to the real boundary of the cores' Minkowski difference
+            Vector2 support = coreSupport(a, bestNormal, indexA) - coreSupport(b, -bestNormal, indexB);
+
+            // The edge is already on the boundary
+            if (support.dot(bestNormal) - bestDistance <= EPA_TOLERANCE)
+                break;
+
+            polytope.insert(polytope.begin() + closest + 1, support);
+        }
+
+        // Rounding grows the Minkowski difference by the radii in every direction, so the depth grows by the same
+        // amount. Moving a against the normal takes the origin out of it
+        return MTV(-bestNormal, bestDistance + coreRadius(a) + coreRadius(b));
+    }
+}
+
+GJKResult WLUW::gjkDistance(const Shape& a, const Shape& b, Vector2 offsetB)
+{
+    Simplex simplex;
+    GJKResult result;
+    result.iterations = runGJK(a, b, offsetB, simplex);
+
+    simplex.witnessPoints(result.pointA, result.pointB);
+    result.distance = simplex.count == 3 ? 0.0 : (result.pointB - result.pointA).size();
+
+    // Move the closest points from the cores out to the rounded surfaces
+    double const radii = coreRadius(a) + coreRadius(b);
+    if (result.distance > radii && result.distance > EPSILON)
+    {
+        Vector2 normal = (result.pointB - result.pointA) / result.distance;
+        result.pointA = result.pointA + normal * coreRadius(a);
+        result.pointB = result.pointB - normal * coreRadius(b);
+        result.distance -= radii;
+    }
+    else
+    {
+        Vector2 middle = (result.pointA + result.pointB) * 0.5;
+        result.pointA = middle;
+        result.pointB = middle;
+        result.distance = 0.0;
+    }
+
+    return result;
+}
+
+MTV WLUW::gjkCollision(const Shape& a, const Shape& b, CollisionScratch& scratch)
+{
+    Simplex simplex;
+    runGJK(a, b, Vector2(0, 0), simplex);
+
+    if (simplex.count < 3)
+    {
+        Vector2 pointA, pointB;
+        simplex.witnessPoints(pointA, pointB);
+
+        double const distance = (pointA - pointB).size();
+        double const radii = coreRadius(a) + coreRadius(b);
+
+        if (distance > radii)
+            return noCollision();
+
+        // Only the rounded parts overlap, the closest points give the answer directly
+        if (distance > EPSILON)
+            return MTV((pointA - pointB) / distance, radii - distance);
+
+        // The cores only just touch, so GJK has no triangle to seed EPA with. This is rare, use the exact routines
+        return Shape::checkCollision(a, b, scratch, CollisionAlgorithm::SAT);
+    }
+
+    return runEPA(a, b, simplex, scratch);
+}
@@ -0,0 +1,53 @@
+/*****************************************************************//**
+ * \file   GJK.h
+ * \brief  GJK distance and EPA penetration queries between convex shapes
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <utility>
+
+#include "CollisionScratch.h"
+#include "Vector2.h"
+
+namespace WLUW
+{
+	class Shape;
+
+	/**
+	 * \struct GJKResult
+	 * \brief Closest points between two shapes
+	 */
+	struct GJKResult
+	{
+		double distance;	/* Gap between the shapes, 0 if they touch or overlap */
+		Vector2 pointA;		/* Point on a closest to b */
+		Vector2 pointB;		/* Point on b closest to a */
+		int iterations;		/* Number of GJK iterations taken */
+	};
+
+	/**
+	 * \brief Finds the closest points between two convex shapes with GJK. Only touches the vertices the
+	 * support searches walk over, so cost grows slowly with the vertex count
+	 *
+	 * \param a first shape
+	 * \param b second shape
+	 * \param offsetB translation applied to b for this query only, so swept queries don't have to move the shape
+	 * \return distance and closest points. When the shapes overlap the distance is 0 and the points are not meaningful
+	 */
+	GJKResult gjkDistance(const Shape& a, const Shape& b, Vector2 offsetB = Vector2(0, 0));
+
+	/**
+	 * \brief Checks for a collision between two convex shapes with GJK, using EPA to find the penetration
+	 * depth when the shapes overlap
+	 *
+	 * \param a first shape
+	 * \param b second shape
+	 * \param scratch working memory for the EPA polytope
+	 * \return the minimum translation vector (MTV), as for Shape::checkCollision
+	 */
+	std::pair<Vector2, double> gjkCollision(const Shape& a, const Shape& b, CollisionScratch& scratch);
+}
@@ -0,0 +1,41 @@
+/*****************************************************************//**
+ * \file   RayCast.h
+ * \brief  Ray and hit types shared by the shape, broadphase and world ray queries
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include "Vector2.h"
+
+namespace WLUW
+{
+	/**
+	 * \struct Ray
+	 * \brief Half-line from an origin, cut off at a maximum distance. A segment is a ray whose maximum
+	 * distance is its length
+	 */
+	struct Ray
+	{
+		Vector2 origin;				/* Start of the ray */
+		Vector2 direction;			/* Unit direction */
+		double maxDistance = 0.0;	/* Distance along direction past which hits are ignored */
+
+		/**\return point at a distance along the ray */
+		Vector2 pointAt(double distance) const { return origin + direction * distance; };
+	};
+
+	/**
+	 * \struct RayHit
+	 * \brief Where a ray or a cast shape first touched something
+	 */
+	struct RayHit
+	{
+		int id = -1;				/* ID of the object hit, -1 if nothing was hit */
+		Vector2 point;				/* World-space point of contact */
+		Vector2 normal;				/* Surface normal of the object hit at the point */
+		double distance = 0.0;		/* Distance travelled along the ray or cast before the hit */
+	};
+}
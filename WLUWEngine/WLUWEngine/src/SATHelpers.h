@@ -0,0 +1,106 @@
+/*****************************************************************//**
+ * \file   SATHelpers.h
+ * \brief  Small helpers shared by the scalar and batched SAT routines
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "Vector2.h"
+
+namespace WLUW
+{
+	/**
+	 * \brief Helper function which gets how far two ranges/projections overlap
+	 *
+	 * \param a first range/projection
+	 * \param b second range/projection
+	 * \return distance one range has to move to stop overlapping the other, or NaN if no overlap
+	 */
+	inline double overlapping(std::pair<double, double> a, std::pair<double, double> b)
+	{
+		if (b.first > a.second || a.first > b.second)
+			return std::numeric_limits<double>::quiet_NaN();
+
+		// Taking the smaller push also handles one range containing the other
+		return std::min(a.second - b.first, b.second - a.first);
+	}
+
+	/**
+	 * \brief Helper function which checks if two unit axes are parallel or opposite
+	 *
+	 * \param u first axis
+	 * \param v second axis
+	 * \return true if projecting onto u and v would give the same overlap
+	 */
+	inline bool sameAxis(Vector2 u, Vector2 v)
+	{
+		return std::abs(u.x * v.y - u.y * v.x) <= 1e-12;
+	}
+
+	/**
+	 * \brief Helper function which merges the SAT axes of two polygons, leaving out the axes b shares with a. Both
+	 * lists must be sorted by angle within the upper half plane, as Shape::getWorldAxes keeps them, so shared axes
+	 * meet in one linear pass instead of every axis of b being checked against every axis of a
+	 *
+	 * \param axisA gets axis i of a
+	 * \param countA number of axes of a
+	 * \param axisB gets axis i of b
+	 * \param countB number of axes of b
+	 * \param axes receives the merged axes, sorted the same way
+	 */
+	template<class AxisA, class AxisB, class Buffer>
+	void mergeAxes(AxisA&& axisA, int countA, AxisB&& axisB, int countB, Buffer& axes)
+	{
+		int i = 0;
+		int j = 0;
+		while (i < countA && j < countB)
+		{
+			Vector2 u = axisA(i);
+			Vector2 v = axisB(j);
+
+			if (sameAxis(u, v))
+			{
+				axes.push_back(u);
+				i++;
+				j++;
+			}
+			else if (u.x * v.y - u.y * v.x > 0.0)
+			{
+				axes.push_back(u);
+				i++;
+			}
+			else
+			{
+				axes.push_back(v);
+				j++;
+			}
+		}
+
+		for (; i < countA; i++)
+			axes.push_back(axisA(i));
+		for (; j < countB; j++)
+			axes.push_back(axisB(j));
+
+		// Axes at the two ends of the half plane are nearly opposite, so they may still be the same
+		if (axes.size() > 1 && sameAxis(axes[0], axes[axes.size() - 1]))
+			axes.pop_back();
+	}
+
+	/**
+	 * \brief Helper function which builds the result for a pair that doesn't collide
+	 *
+	 * \return MTV with a zero axis and NaN overlap
+	 */
+	inline std::pair<Vector2, double> noCollision()
+	{
+		return std::pair<Vector2, double>(Vector2(0, 0), std::numeric_limits<double>::quiet_NaN());
+	}
+}
@@ -7,9 +7,13 @@
  *********************************************************************/
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 
+#include "CollisionKernels.h"
+#include "GJK.h"
+#include "SATHelpers.h"
 #include "Shape.h"
 #include "Vector2.h"
 
@@ -21,28 +25,33 @@ using Proj = std::pair<double, double>;
 using MTV = std::pair<Vector2, double>;
 
 WLUW::Shape::Shape(Vector2 pos)
-    : type(ShapeType::POLYGON), radius(0.f), pos(pos)
+    : type(ShapeType::POLYGON), transform(pos), radius(0.f)
 {
 }
 
-WLUW::Shape::Shape(const Shape& shape) : type(shape.type), pos(shape.pos), radius(shape.radius)
+WLUW::Shape::Shape(const Shape& shape)
+    : type(shape.type), transform(shape.transform), followed(shape.followed), radius(shape.radius)
 {
     this->points = shape.points;
     this->normals = shape.normals;
+    this->twiceArea = shape.twiceArea;
 }
 
 WLUW::Shape::Shape(std::vector<Vector2>& points, Vector2 pos)
-    : type(ShapeType::POLYGON), radius(0.f)
+    : type(ShapeType::POLYGON), transform(pos), radius(0.f)
 {
     this->points.insert(this->points.end(), std::make_move_iterator(points.begin()), std::make_move_iterator(points.end()));
     points.erase(points.begin(), points.end());
+
+    if (this->points.size() > 1)
+        calcNormals();
 }
 
-WLUW::Shape::Shape(double radius, Vector2 pos) : type(ShapeType::CIRCLE), radius(radius)
+WLUW::Shape::Shape(double radius, Vector2 pos) : type(ShapeType::CIRCLE), transform(pos), radius(radius)
 {
 }
 
-WLUW::Shape::Shape(ShapeType type, Vector2 pos) : type(type), radius(0.f)
+WLUW::Shape::Shape(ShapeType type, Vector2 pos) : type(type), transform(pos), radius(0.f)
 {
 }
 
@@ -52,277 +61,659 @@ bool WLUW::operator==(const Shape& lhs, const Shape& rhs)
 }
 
 /**
- * \brief Helper function which gets the length of the union of two ranges/projections
- * 
- * \param a first range/projection
- * \param b second range/projection
- * \return length of the union of a and b, or NaN if no overlap
+ * \brief Helper function which gets the term an edge adds to twice the signed area of a polygon
+ *
+ * \param a start of the edge
+ * \param b end of the edge
+ * \return cross product of a and b
  */
-double overlapping(Proj a, Proj b)
+double areaTerm(Vector2 a, Vector2 b)
 {
-    if (b.first > a.second || a.first > b.second)
-        return std::numeric_limits<double>::quiet_NaN();
-
-    double start = std::max(a.first, b.first);
-    double end = std::min(a.second, b.second);
-
-    return end - start;
+    return a.x * b.y - b.x * a.y;
 }
 
 /**
- * \brief Helper function which calculates circle to circle collision
+ * \brief Helper function which calculates circle to circle collision in closed form
  * 
  * \param a first circle
  * \param b second circle
- * \return Axis between the centre of the two circles
+ * \return the MTV which pushes a out of b
  */
-Axis calcCircleToCircleCollisionAxis(const Shape& a, const Shape& b)
+MTV collideCircles(const Shape& a, const Shape& b, CollisionScratch&, CollisionAlgorithm)
 {
-    if (a.getShapeType() != ShapeType::CIRCLE || b.getShapeType() != ShapeType::CIRCLE)
-    {
-        throw("Atleast one of the shapes was not a circle");
-        return Axis(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
-    }
+    MTV mtv;
+    if (!circleCircleOverlap(a.getPosition(), a.getWorldRadius(), b.getPosition(), b.getWorldRadius(), mtv.first, mtv.second))
+        return noCollision();
 
-    return a.getPosition() - b.getPosition();
+    return mtv;
 }
 
 /**
- * \brief Helper function which calculates circle to polygon collision
+ * \brief Helper function which calculates circle to polygon collision. Finds the edge the circle centre is
+ * furthest in front of, then tests a single axis depending on which Voronoi region of that edge the centre is in
  *
  * \param circle circle shape
  * \param poly polygon shape
- * \return Axes to test for collision
+ * \return the MTV which pushes the circle out of the polygon
  */
-std::vector<Axis> calcCircleToPolygonCollisionAxis(const Shape& circle, const Shape& poly)
+MTV collideCircleWithPolygon(const Shape& circle, const Shape& poly)
 {
-    if (circle.getShapeType() != ShapeType::CIRCLE || poly.getShapeType() != ShapeType::POLYGON)
+    Vector2Array const& points = poly.getWorldPoints();
+    std::vector<Vector2> const& normals = poly.getWorldNormals();
+    int const numPoints = points.size();
+
+    if (numPoints <= 1 || normals.size() != numPoints)
     {
-        throw("Atleast one of the shapes was not a circle");
-        return std::vector<Axis>();
+        throw("Not enough points");
+        return noCollision();
     }
 
-    std::vector<Axis> axes;
-    Vector2 circlePos = circle.getPosition();
+    MTV mtv;
+    if (!circlePolygonOverlap(circle.getPosition(), circle.getWorldRadius(), points, normals.data(), numPoints, mtv.first, mtv.second))
+        return noCollision();
+
+    return mtv;
+}
+
+MTV collideCirclePolygon(const Shape& a, const Shape& b, CollisionScratch&, CollisionAlgorithm)
+{
+    return collideCircleWithPolygon(a, b);
+}
+
+MTV collidePolygonCircle(const Shape& a, const Shape& b, CollisionScratch&, CollisionAlgorithm)
+{
+    MTV mtv = collideCircleWithPolygon(b, a);
+    mtv.first = -mtv.first;
+    return mtv;
+}
 
-    // Generate all axes from centre of circle to polygon vertices
-    for (auto &point : poly.getPoints())
+/**
+ * \brief Helper function which calculates polygon to polygon collision with SAT, or with GJK/EPA for large
+ * polygons under CollisionAlgorithm::AUTO
+ *
+ * \param a first polygon
+ * \param b second polygon
+ * \param scratch holds the axes if there are too many to keep inline, or the GJK/EPA polytope
+ * \param algorithm AUTO or SAT
+ * \return the MTV which pushes a out of b
+ */
+MTV collidePolygons(const Shape& a, const Shape& b, CollisionScratch& scratch, CollisionAlgorithm algorithm)
+{
+    // SAT projects every vertex onto every axis, past a few dozen vertices GJK's support lookups win
+    if (algorithm == CollisionAlgorithm::AUTO
+        && (a.getPoints().size() > Shape::GJK_VERTEX_THRESHOLD || b.getPoints().size() > Shape::GJK_VERTEX_THRESHOLD))
+        return gjkCollision(a, b, scratch);
+
+    std::vector<Vector2> const& axesA = a.getWorldAxes();
+    std::vector<Vector2> const& axesB = b.getWorldAxes();
+
+    // Gather the axes of both shapes, skipping any of b's which a already has
+    AxisBuffer<16> axes(scratch.axes);
+    mergeAxes([&](int i) { return axesA[i]; }, static_cast<int>(axesA.size()),
+        [&](int i) { return axesB[i]; }, static_cast<int>(axesB.size()), axes);
+
+    Vector2Array const& pointsA = a.getWorldPoints();
+    Vector2Array const& pointsB = b.getWorldPoints();
+
+    if (pointsA.empty() || pointsB.empty())
     {
-        axes.emplace_back(point - circlePos);
+        throw("Not enough points");
+        return noCollision();
     }
 
-    return axes;
+    MTV mtv;
+    if (!polygonPolygonOverlap(pointsA, pointsA.size(), pointsB, pointsB.size(),
+        axes, axes.size(), a.getBoundingBox().getCenter(), b.getBoundingBox().getCenter(), mtv.first, mtv.second))
+        return noCollision();
+
+    return mtv;
 }
 
+/* Routine for each pair of shape types, indexed by [a.type][b.type]. Pairs with a circle use closed forms */
+using CollisionFunction = MTV(*)(const Shape&, const Shape&, CollisionScratch&, CollisionAlgorithm);
+static const CollisionFunction collisionTable[2][2] =
+{
+    /* POLYGON */ { collidePolygons,      collidePolygonCircle },
+    /* CIRCLE  */ { collideCirclePolygon, collideCircles }
+};
+
 MTV WLUW::Shape::checkCollision(const Shape& a, const Shape& b)
 {
-    double mtvOverlap = std::numeric_limits<double>::max();
-    Axis mtvAxis;
-    std::vector<Axis> allAxes, axes1, axes2;
+    // An empty scratch only allocates if a polygon has more axes than fit inline
+    CollisionScratch scratch;
+    return checkCollision(a, b, scratch);
+}
+
+MTV WLUW::Shape::checkCollision(const Shape& a, const Shape& b, CollisionScratch& scratch, CollisionAlgorithm algorithm)
+{
+    if (algorithm == CollisionAlgorithm::GJK)
+        return gjkCollision(a, b, scratch);
 
-    // If both shapes are circles
-    if (a.getShapeType() == ShapeType::CIRCLE && b.getShapeType() == ShapeType::CIRCLE)
+    return collisionTable[static_cast<int>(a.getShapeType())][static_cast<int>(b.getShapeType())](a, b, scratch, algorithm);
+}
+
+void WLUW::Shape::calcNormals()
+{
+    // Not enough points to calculate a normal
+    if (this->type == ShapeType::POLYGON && this->points.size() <= 1)
     {
-        Axis axis = calcCircleToCircleCollisionAxis(a, b);
-        axes1.push_back(axis);
+        throw("Not enough points to calculate normals");
+        return;
     }
-    // If one of the shapes is a circle
-    else if (a.getShapeType() == ShapeType::CIRCLE || b.getShapeType() == ShapeType::CIRCLE)
+
+    // No need to precalculate the normals of a circle
+    if (this->type == ShapeType::CIRCLE)
     {
-        // If a is the circle
-        if (a.getShapeType() == ShapeType::CIRCLE)
-        {
-            axes1 = calcCircleToPolygonCollisionAxis(a, b);
-            axes2 = b.getNormals();
-        }
-        // If b is the circle
-        else
+        throw("Circles should not need their normals calculated");
+        return;
+    }
+
+    // Calculate one outward normal per edge, so normals[i] belongs to the edge starting at points[i]
+    this->normals.resize(this->points.size());
+    this->twiceArea = computeNormals(this->points.data(), static_cast<int>(this->points.size()), this->normals.data());
+
+    this->axesDirty = true;
+    this->worldNormalsDirty = true;
+}
+
+void WLUW::Shape::beginEdit()
+{
+    this->editDepth++;
+}
+
+void WLUW::Shape::endEdit()
+{
+    if (this->editDepth <= 0)
+    {
+        throw("endEdit without beginEdit");
+        return;
+    }
+
+    if (--this->editDepth == 0)
+        refreshNormals();
+}
+
+Proj WLUW::Shape::projectOntoAxis(Vector2 axis) const
+{
+    // If shape is a polygon
+    if (this->type == ShapeType::POLYGON)
+    {
+        // Not enough points
+        if (this->points.size() <= 0)
         {
-            axes1 = a.getNormals();
-            axes2 = calcCircleToPolygonCollisionAxis(b, a);
+            throw("Not enough points");
+            return std::make_pair(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
         }
+
+        // Project the points onto the axis and keep the min and max points along the axis
+        updateCache();
+        return this->worldPoints.projectOntoAxis(axis);
     }
-    // Both shapes are polygons
+    // Shape is a circle
     else
     {
-        axes1 = a.getNormals();
-        axes2 = b.getNormals();
+        // Project the centre, then extend by the radius scaled to the axis length
+        double centre = axis.dot(getPosition());
+        double extent = getWorldRadius() * axis.size();
+
+        return Proj(centre - extent, centre + extent);
+    }
+}
+
+int WLUW::Shape::supportIndex(Vector2 direction, int start) const
+{
+    if (this->type == ShapeType::CIRCLE)
+        return 0;
+
+    Vector2Array const& world = getWorldPoints();
+    int const numPoints = world.size();
+
+    if (numPoints <= 0)
+    {
+        throw("Not enough points");
+        return 0;
     }
-    
-    allAxes = axes1;
 
-    for (auto &axis : axes2)
+    // A convex polygon has a single peak along any direction, so walk uphill until the next vertex is lower
+    int best = (start >= 0 && start < numPoints) ? start : 0;
+    double bestDot = direction.dot(world[best]);
+
+    double const nextDot = direction.dot(world[(best + 1) % numPoints]);
+    double const previousDot = direction.dot(world[(best + numPoints - 1) % numPoints]);
+
+    // Level with both neighbours, the start lies inside an edge square to the direction and there is no telling
+    // which way is uphill, so check every vertex
+    if (nextDot == bestDot && previousDot == bestDot)
     {
-        // Don't add vector if any vector currently in newNormal is collinear to this one
-        if (!std::any_of(
-            allAxes.begin(),
-            allAxes.end(),
-            [=](Vector2 vec) { return vec.dot(axis) == vec.size() * axis.size(); })
-            )
+        for (int i = 0; i < numPoints; i++)
         {
-            allAxes.push_back(std::move(axis));
+            double dot = direction.dot(world[i]);
+            if (dot > bestDot)
+            {
+                best = i;
+                bestDot = dot;
+            }
         }
+
+        return best;
     }
 
-    // loop over the axes
-    for (int i = 0; i < allAxes.size(); i++) {
-        Axis axis = axes1[i];
-        // project both shapes onto the axis
-        Proj p1 = a.projectOntoAxis(axis);
-        Proj p2 = b.projectOntoAxis(axis);
+    int const step = nextDot >= previousDot ? 1 : numPoints - 1;
+    int current = best;
+    for (int i = 1; i < numPoints; i++)
+    {
+        current = (current + step) % numPoints;
+        double dot = direction.dot(world[current]);
 
-        // Get overlap
-        double overlap = overlapping(p1, p2);
+        if (dot < bestDot)
+            break;
 
-        // do the projections overlap?
-        if (overlap == std::numeric_limits<double>::quiet_NaN()) {
-            // then we can guarantee that the shapes do not overlap
-            return MTV(Axis(0, 0), overlap);
-        }
-        else {
-            // check for minimum
-            if (overlap < mtvOverlap) {
-                // then set this one as the smallest
-                mtvOverlap = overlap;
-                mtvAxis = axis;
-            }
+        // Collinear vertices leave level stretches on the way up, so walk across ties instead of stopping at them
+        if (dot > bestDot)
+        {
+            best = current;
+            bestDot = dot;
         }
     }
 
-    MTV mtv(mtvAxis, mtvOverlap);
-    return mtv;
+    return best;
 }
 
-void WLUW::Shape::calcNormals()
+Vector2 WLUW::Shape::support(Vector2 direction) const
 {
-    // Not enough points to calculate a normal
-    if (this->type == ShapeType::POLYGON && this->points.size() <= 1)
-    {
-        throw("Not enough points to calculate normals");
-        return;
-    }
+    if (this->type == ShapeType::POLYGON)
+        return getWorldPoints()[supportIndex(direction)];
 
-    // No need to precalculate the normals of a circle
+    double length = direction.size();
+    if (length == 0.0)
+        return getPosition();
+
+    return getPosition() + direction * (getWorldRadius() / length);
+}
+
+bool WLUW::Shape::raycast(const Ray& ray, RayHit& hit) const
+{
+    // Circle, solve |origin + t * direction - centre| = radius for the smaller t
     if (this->type == ShapeType::CIRCLE)
     {
-        throw("Circles should not need their normals calculated");
-        return;
+        Vector2 offset = ray.origin - getPosition();
+        double b = offset.dot(ray.direction);
+        double c = offset.dot(offset) - getWorldRadius() * getWorldRadius();
+
+        // Starting inside, or pointing away from the circle
+        if (c <= 0.0 || b > 0.0)
+            return false;
+
+        double discriminant = b * b - c;
+        if (discriminant < 0.0)
+            return false;
+
+        double distance = -b - std::sqrt(discriminant);
+        if (distance > ray.maxDistance)
+            return false;
+
+        hit.distance = distance;
+        hit.point = ray.pointAt(distance);
+        hit.normal = (hit.point - getPosition()) / getWorldRadius();
+        return true;
     }
 
-    std::vector<Vector2> newNormals;
-    int const numPoints = this->points.size();
+    Vector2Array const& world = getWorldPoints();
+    std::vector<Vector2> const& worldNormals = getWorldNormals();
+
+    if (world.size() < 3 || worldNormals.size() != world.size())
+        return false;
 
-    // Calculate normals
-    for (int i = 0; i < numPoints; i++)
+    // Clip the ray against the plane of every edge. It enters through the last plane it crosses going in
+    double lower = 0.0;
+    double upper = ray.maxDistance;
+    int entryEdge = -1;
+
+    for (int i = 0; i < world.size(); i++)
     {
-        Vector2 p1 = this->points[i];
-        Vector2 p2 = this->points[(i + 1) % numPoints];
+        double numerator = worldNormals[i].dot(world[i] - ray.origin);
+        double denominator = worldNormals[i].dot(ray.direction);
 
-        Vector2 edge = p1 - p2;
-        Vector2 normal = edge.normal().normalized();
+        if (denominator == 0.0)
+        {
+            // Parallel to the edge and outside it
+            if (numerator < 0.0)
+                return false;
+            continue;
+        }
 
-        // Don't add vector if any vector currently in newNormal is collinear to this one
-        if (!std::any_of(
-            newNormals.begin(),
-            newNormals.end(),
-            [=](Vector2 vec) { return vec.dot(normal) == vec.size() * normal.size(); })
-           )
+        double distance = numerator / denominator;
+        if (denominator < 0.0 && distance > lower)
         {
-            newNormals.push_back(std::move(normal));
+            lower = distance;
+            entryEdge = i;
         }
+        else if (denominator > 0.0 && distance < upper)
+        {
+            upper = distance;
+        }
+
+        if (upper < lower)
+            return false;
+    }
+
+    // No plane was crossed going in, so the ray started inside
+    if (entryEdge < 0)
+        return false;
+
+    hit.distance = lower;
+    hit.point = ray.pointAt(lower);
+    hit.normal = worldNormals[entryEdge];
+    return true;
+}
+
+bool WLUW::Shape::containsPoint(Vector2 point) const
+{
+    if (this->type == ShapeType::CIRCLE)
+    {
+        Vector2 offset = point - getPosition();
+        return offset.dot(offset) <= getWorldRadius() * getWorldRadius();
     }
 
-    // Swap in new normals
-    std::swap(this->points, newNormals);
+    Vector2Array const& world = getWorldPoints();
+    std::vector<Vector2> const& worldNormals = getWorldNormals();
+
+    if (world.size() < 3 || worldNormals.size() != world.size())
+        return false;
+
+    // Inside a convex polygon means behind the plane of every edge
+    for (int i = 0; i < world.size(); i++)
+    {
+        if (worldNormals[i].dot(point - world[i]) > 0.0)
+            return false;
+    }
+
+    return true;
 }
 
-Proj WLUW::Shape::projectOntoAxis(Vector2 axis) const
+void WLUW::Shape::updateCache() const
 {
-    // If shape is a polygon
-    if (this->type == ShapeType::POLYGON)
+    // Only look inside the transform when it is a different one or its version moved on
+    const Transform2D& transform = getTransform();
+    if (&transform != this->cachedTransform || transform.getVersion() != this->cachedVersion)
     {
-        // Not enough points
-        if (this->points.size() <= 0)
+        this->cachedTransform = &transform;
+        this->cachedVersion = transform.getVersion();
+        this->worldPointsDirty = true;
+
+        // Translating and scaling leave directions alone
+        if (transform.getRotation() != this->cachedRotation)
         {
-            throw("Not enough points");
-            return std::make_pair(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+            this->cachedRotation = transform.getRotation();
+            this->worldNormalsDirty = true;
         }
+    }
 
-        // Project the points onto the axis and keep the min and max points along the axis
-        double min = axis.dot(this->points[0] + this->pos);
-        double max = min;
+    if (this->axesDirty)
+    {
+        this->axesDirty = false;
+        this->worldNormalsDirty = true;
 
-        for (int i = 1; i < this->points.size(); i++)
+        // Point every axis into the upper half plane so opposite edges give the same axis
+        this->axes = this->normals;
+        for (auto& axis : this->axes)
         {
-            double p = axis.dot(this->points[i] + this->pos);
-            if (p < min)
-                min = p;
-            else if (p > max)
-                max = p;
+            if (axis.y < 0.0 || (axis.y == 0.0 && axis.x < 0.0))
+                axis = -axis;
         }
 
-        return Proj(min, max);
+        // Sort by angle and drop the duplicates, which leaves one axis per edge direction
+        std::sort(this->axes.begin(), this->axes.end(), [](Vector2 u, Vector2 v) { return u.x * v.y - u.y * v.x > 0.0; });
+        this->axes.erase(std::unique(this->axes.begin(), this->axes.end(), sameAxis), this->axes.end());
     }
-    // Shape is a circle
-    else
+
+    if (this->worldNormalsDirty)
     {
-        // Project either end of the circle onto the axis
-        double min = axis.dot(this->pos + axis * this->radius);
-        double max = axis.dot(this->pos - axis * this->radius);
+        this->worldNormalsDirty = false;
+        this->worldNormals.resize(this->normals.size());
+        this->worldAxes.resize(this->axes.size());
 
-        if (min > max) std::swap(min, max); // Swap if min is larger
+        for (int i = 0; i < this->normals.size(); i++)
+            this->worldNormals[i] = transform.rotate(this->normals[i]);
 
-        return Proj(min, max);
+        // Rotated axes stay distinct, but may leave the upper half plane
+        for (int i = 0; i < this->axes.size(); i++)
+        {
+            Vector2 axis = transform.rotate(this->axes[i]);
+            if (axis.y < 0.0 || (axis.y == 0.0 && axis.x < 0.0))
+                axis = -axis;
+            this->worldAxes[i] = axis;
+        }
+
+        // The flipped axes are still sorted, but starting part way round. Start them at the smallest angle again,
+        // so collidePolygons can merge two shapes' axes in one pass
+        auto wrap = std::adjacent_find(this->worldAxes.begin(), this->worldAxes.end(),
+            [](Vector2 u, Vector2 v) { return u.x * v.y - u.y * v.x <= 0.0; });
+        if (wrap != this->worldAxes.end())
+            std::rotate(this->worldAxes.begin(), wrap + 1, this->worldAxes.end());
     }
+
+    if (!this->worldPointsDirty)
+        return;
+
+    this->worldPointsDirty = false;
+    Vector2 const position = transform.getTranslation();
+
+    // Circle bounds are the centre plus or minus the radius
+    if (this->type == ShapeType::CIRCLE)
+    {
+        this->worldPoints.clear();
+        this->bounds = AABB(position - getWorldRadius(), position + getWorldRadius());
+        return;
+    }
+
+    // Overwrite instead of rebuilding, so moving a shape never reallocates
+    this->worldPoints.assign(this->points.data(), static_cast<int>(this->points.size()));
+
+    if (this->points.size() <= 0)
+    {
+        this->bounds = AABB(position, position);
+        return;
+    }
+
+    transform.apply(this->worldPoints, this->worldPoints);
+    this->bounds = this->worldPoints.getBounds();
+}
+
+void WLUW::Shape::setPosition(Vector2 position)
+{
+    if (this->followed != nullptr)
+    {
+        throw("Shape follows another transform");
+        return;
+    }
+
+    this->transform.setTranslation(position);
+}
+
+void WLUW::Shape::setRotation(double angle)
+{
+    if (this->followed != nullptr)
+    {
+        throw("Shape follows another transform");
+        return;
+    }
+
+    this->transform.setRotation(angle);
+}
+
+void WLUW::Shape::setScale(double scale)
+{
+    if (this->followed != nullptr)
+    {
+        throw("Shape follows another transform");
+        return;
+    }
+
+    this->transform.setScale(scale);
+}
+
+void WLUW::Shape::setTransform(const Transform2D& transform)
+{
+    if (this->followed != nullptr)
+    {
+        throw("Shape follows another transform");
+        return;
+    }
+
+    this->transform = transform;
+}
+
+void WLUW::Shape::followTransform(const Transform2D* transform)
+{
+    this->followed = transform;
 }
 
 void WLUW::Shape::addPoint(Vector2 point)
 {
-    this->points.push_back(point);
-    calcNormals(); // Recalculate normals
+    insertPoint(point, static_cast<int>(this->points.size()));
 }
 
 void WLUW::Shape::insertPoint(Vector2 point, int index)
 {
-    if (index < 0 || index > this->points.size())
+    int const count = static_cast<int>(this->points.size());
+    if (index < 0 || index > count)
     {
         throw("out of range");
         return;
     }
 
     this->points.insert(this->points.begin() + index, point);
-    calcNormals(); // Recalculate normals
+    this->worldPointsDirty = true;
+
+    if (count < 2 || !canUpdateEdges())
+    {
+        refreshNormals();
+        return;
+    }
+
+    // The new point splits the edge from prev to next into two
+    Vector2 const prev = this->points[index == 0 ? count : index - 1];
+    Vector2 const next = this->points[(index + 1) % (count + 1)];
+    double const areaChange = areaTerm(prev, point) + areaTerm(point, next) - areaTerm(prev, next);
+
+    this->normals.insert(this->normals.begin() + index, Vector2());
+    updateEdges(areaChange, index == 0 ? count : index - 1, index);
 }
 
 Vector2 WLUW::Shape::removePoint(int index)
 {
-    if (index < 0 || index >= this->points.size())
+    int const count = static_cast<int>(this->points.size());
+    if (index < 0 || index >= count)
     {
         throw("out of range");
         return Vector2();
     }
 
-    // Test if getting the removed value doesn't result in garbage
-    Vector2 removed = this->points.at(index);
-    Vector2 returned = Vector2(removed.x, removed.y);
+    Vector2 const removed = this->points[index];
+
+    // The edges either side of the point merge into one from prev to next
+    Vector2 const prev = this->points[(index + count - 1) % count];
+    Vector2 const next = this->points[(index + 1) % count];
+    double const areaChange = areaTerm(prev, next) - areaTerm(prev, removed) - areaTerm(removed, next);
 
     this->points.erase(this->points.begin() + index);
-    calcNormals(); // Recalculate normals
+    this->worldPointsDirty = true;
 
-    return returned;
+    if (count - 1 < 3 || !canUpdateEdges())
+    {
+        refreshNormals();
+        return removed;
+    }
+
+    this->normals.erase(this->normals.begin() + index);
+    updateEdges(areaChange, index == 0 ? count - 2 : index - 1, -1);
+
+    return removed;
 }
 
 Vector2 WLUW::Shape::swapPoint(int index, Vector2 point)
 {
-    if (index < 0 || index >= this->points.size())
+    int const count = static_cast<int>(this->points.size());
+    if (index < 0 || index >= count)
     {
         throw("out of range");
         return Vector2();
     }
 
-    Vector2 returned = Vector2(point.x, point.y);
-    std::swap(returned, this->points[index]);
-    calcNormals(); // Recalculate normals
+    Vector2 const returned = this->points[index];
+
+    // Only the two edges meeting at the point change
+    int const prev = (index + count - 1) % count;
+    Vector2 const prevPoint = this->points[prev];
+    Vector2 const nextPoint = this->points[(index + 1) % count];
+    double const areaChange = areaTerm(prevPoint, point) + areaTerm(point, nextPoint)
+        - areaTerm(prevPoint, returned) - areaTerm(returned, nextPoint);
+
+    this->points[index] = point;
+    this->worldPointsDirty = true;
+
+    if (count < 3 || !canUpdateEdges())
+    {
+        refreshNormals();
+        return returned;
+    }
+
+    updateEdges(areaChange, prev, index);
 
     return returned;
 }
+
+bool WLUW::Shape::canUpdateEdges() const
+{
+    // Circles throw from refreshNormals, and edits in a batch wait for endEdit
+    return this->type == ShapeType::POLYGON && this->editDepth == 0;
+}
+
+void WLUW::Shape::refreshNormals()
+{
+    // Edits in a batch are picked up by endEdit
+    if (this->editDepth > 0)
+        return;
+
+    // Too few points to have edges yet, which is fine while a polygon is being built
+    if (this->type == ShapeType::POLYGON && this->points.size() <= 1)
+    {
+        this->normals.clear();
+        this->twiceArea = 0.0;
+        this->axesDirty = true;
+        this->worldNormalsDirty = true;
+        return;
+    }
+
+    calcNormals();
+}
+
+void WLUW::Shape::updateEdges(double areaChange, int edgeA, int edgeB)
+{
+    int const count = static_cast<int>(this->points.size());
+    double const area = this->twiceArea + areaChange;
+
+    // The polygon turned inside out, every outward normal flips
+    if ((area < 0.0) != (this->twiceArea < 0.0))
+    {
+        for (auto& normal : this->normals)
+            normal = -normal;
+    }
+
+    this->twiceArea = area;
+    double const winding = area < 0.0 ? -1.0 : 1.0;
+
+    // Same expression as computeNormals, so edited shapes match freshly built ones
+    for (int edge : { edgeA, edgeB })
+    {
+        if (edge < 0)
+            continue;
+
+        Vector2 const side = this->points[edge] - this->points[(edge + 1) % count];
+        this->normals[edge] = side.normal().normalized() * winding;
+    }
+
+    this->axesDirty = true;
+    this->worldNormalsDirty = true;
+}
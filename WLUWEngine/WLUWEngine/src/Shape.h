@@ -10,7 +10,12 @@
 
 #include <vector>
 
+#include "AABB.h"
+#include "CollisionScratch.h"
+#include "RayCast.h"
+#include "Transform2D.h"
 #include "Vector2.h"
+#include "Vector2Array.h"
 
 namespace WLUW
 {
@@ -23,13 +28,27 @@ namespace WLUW
 		CIRCLE
 	};
 
+	/**
+	 * /enum WLUW::CollisionAlgorithm
+	 * /brief Narrowphase used for a pair of shapes
+	 */
+	enum class CollisionAlgorithm {
+		AUTO,	/* For polygon pairs GJK/EPA once either passes Shape::GJK_VERTEX_THRESHOLD vertices, SAT otherwise. Closed form for circles */
+		SAT,	/* Separating axis test, or the closed form routines for circles */
+		GJK		/* GJK distance with EPA for the penetration depth */
+	};
+
 	/**
 	 * \class Shape Shape.h
-	 * \brief Class which defines a convex 2D polygon
+	 * \brief Class which defines a convex 2D polygon. Points and normals are stored in local space and placed in the
+	 * world by a Transform2D, either the shape's own or one it follows
 	 */
 	class Shape
 	{
 	public:
+		/* Polygon pairs where either has more vertices than this use GJK/EPA under CollisionAlgorithm::AUTO */
+		static constexpr int GJK_VERTEX_THRESHOLD = 32;
+
 		/////////////////////
 		//// Constructors
 		/////////////////////
@@ -83,31 +102,98 @@ namespace WLUW
 		/////////////////////
 
 		/**
-		 * \brief Checks for a collision check between 2 shapes
+		 * \brief Checks for a collision check between 2 shapes. Dispatches to a routine specialized for the two shape types
 		 *
 		 * \param a first shape
 		 * \param b second shape
-		 * \return the minimum translation vector (MTV)
+		 * \return the minimum translation vector (MTV) as a unit axis and a depth. Moving a by axis * depth separates
+		 * the shapes. The depth is NaN if the shapes don't collide
 		 */
 		static std::pair<Vector2, double> checkCollision(const Shape& a, const Shape& b);
 
 		/**
-		 * \brief Calculate the normals of the edges of the shape and swap them into this->points
+		 * \brief Checks for a collision between 2 shapes using caller-supplied working memory. Reusing one
+		 * scratch across many checks means no heap allocation once its buffers have grown
+		 *
+		 * \param a first shape
+		 * \param b second shape
+		 * \param scratch working memory for the query
+		 * \param algorithm narrowphase to use for this pair
+		 * \return the minimum translation vector (MTV), as for checkCollision(a, b)
+		 */
+		static std::pair<Vector2, double> checkCollision(const Shape& a, const Shape& b, CollisionScratch& scratch,
+			CollisionAlgorithm algorithm = CollisionAlgorithm::AUTO);
+
+		/**
+		 * \brief Recalculate the outward normals of every edge of the shape. The point editing methods keep the
+		 * normals up to date by themselves, so this is only needed to reset them
 		 */
 		void calcNormals();
 
 		/**
-		 * \brief Gets projection of shape onto an axis
+		 * \brief Start a batch of point edits. Normals aren't touched until the matching endEdit, which rebuilds
+		 * them once. Batches may nest
+		 */
+		void beginEdit();
+
+		/**
+		 * \brief Finish a batch of point edits, rebuilding the normals when the outermost batch ends
+		 */
+		void endEdit();
+
+		/**
+		 * \brief Gets projection of shape onto an axis. Reads the cached world-space points
 		 *
 		 * \param axis axis to project shape on to
 		 * \return pair of doubles representing the min and max of the projection
 		 */
 		std::pair<double, double> projectOntoAxis(Vector2 axis) const;
 
+		/**
+		 * \brief Gets the index of the world point furthest along a direction by hill climbing from a starting vertex.
+		 * Starting from the previous answer makes repeated queries with similar directions close to constant time
+		 *
+		 * \param direction direction to search in, doesn't need to be normalized
+		 * \param start vertex to start climbing from
+		 * \return index into getWorldPoints(). Always 0 for circles
+		 */
+		int supportIndex(Vector2 direction, int start = 0) const;
+
+		/**
+		 * \brief Gets the point of the shape furthest along a direction, in world space
+		 *
+		 * \param direction direction to search in, doesn't need to be normalized
+		 * \return furthest point. Circles return the point on the circumference
+		 */
+		Vector2 support(Vector2 direction) const;
+
+		/**
+		 * \brief Finds where a ray first hits the shape. Rays which start inside the shape don't hit it
+		 *
+		 * \param ray ray to cast, its direction must be unit length
+		 * \param hit set to the point, outward normal and distance of the hit. The ID is left alone
+		 * \return true if the ray hits the shape within its maximum distance
+		 */
+		bool raycast(const Ray& ray, RayHit& hit) const;
+
+		/**
+		 * \brief Checks if a point lies inside the shape. Points on the boundary count as inside
+		 *
+		 * \param point world-space point
+		 * \return true if the shape contains the point
+		 */
+		bool containsPoint(Vector2 point) const;
+
+		/**
+		 * \brief Recompute the world-space caches if the shape changed since they were last built.
+		 * Queries do this on demand. Call it before sharing the shape between threads
+		 */
+		void updateCache() const;
+
 		virtual bool isEqual(Shape other) const
 		{
 			return this->type == other.type
-				&& this->pos == other.pos
+				&& this->getTransform() == other.getTransform()
 				&& this->radius == other.radius
 				&& this->points == other.points
 				&& this->normals == other.normals;
@@ -117,6 +203,9 @@ namespace WLUW
 		//// Modifier Methods
 		/////////////////////
 		
+		// Outside a batch each edit updates only the normals of the edges it touches. Polygons may be built up
+		// from a single point, normals exist once there are two
+
 		/**
 		 * \brief Add point to shape. Point is appended to end of vector.
 		 *
@@ -149,6 +238,43 @@ namespace WLUW
 		 */
 		Vector2 swapPoint(int index, Vector2 point);
 
+		/**
+		 * \brief Move the shape
+		 *
+		 * \param position new position of shape
+		 */
+		void setPosition(Vector2 position);
+
+		/**
+		 * \brief Rotate the shape about its local origin
+		 *
+		 * \param angle rotation in radians, counter-clockwise
+		 */
+		void setRotation(double angle);
+
+		/**
+		 * \brief Scale the shape about its local origin
+		 *
+		 * \param scale uniform scale, greater than 0
+		 */
+		void setScale(double scale);
+
+		/**
+		 * \brief Replace the shape's own transform
+		 *
+		 * \param transform new transform
+		 */
+		void setTransform(const Transform2D& transform);
+
+		/**
+		 * \brief Place the shape with a transform owned by something else, such as a body shared by several shapes.
+		 * The world-space caches are rebuilt the next time they are read after its version changes. The shape's
+		 * own position, rotation and scale can't be set while following
+		 *
+		 * \param transform transform to follow, which must outlive the shape, or nullptr to go back to the shape's own
+		 */
+		void followTransform(const Transform2D* transform);
+
 		/////////////////////
 		//// Getter Methods
 		/////////////////////
@@ -156,24 +282,78 @@ namespace WLUW
 		/**\return type of shape */
 		ShapeType getShapeType() const { return type; };
 
-		/**\return shape position */
-		Vector2 getPosition() const { return pos; };
+		/**\return shape position, the world position of its local origin */
+		Vector2 getPosition() const { return getTransform().getTranslation(); };
 		
-		/**\return radius, if type is circle */
+		/**\return radius in local space, if type is circle */
 		double getRadius() const { return radius; };
 
+		/**\return radius in world space, if type is circle */
+		double getWorldRadius() const { return radius * getTransform().getScale(); };
+
+		/**\return transform placing the shape in the world */
+		Transform2D const& getTransform() const { return followed != nullptr ? *followed : transform; };
+
 		/**\return points defining polygon */
 		std::vector<Vector2> const& getPoints() const { return points; };
 
 		/**\return normal vectors of edges */
 		std::vector<Vector2> const& getNormals() const { return normals; };
 
+		/**\return true between beginEdit and the matching endEdit */
+		bool isEditing() const { return editDepth > 0; };
+
+		/**\return points defining polygon, placed by the transform */
+		Vector2Array const& getWorldPoints() const { updateCache(); return worldPoints; };
+
+		/**\return normal vectors of edges in world space */
+		std::vector<Vector2> const& getWorldNormals() const { updateCache(); return worldNormals; };
+
+		/**\return world normals with parallel and opposite duplicates removed, the axes SAT has to test, sorted by angle */
+		std::vector<Vector2> const& getWorldAxes() const { updateCache(); return worldAxes; };
+
+		/**\return smallest axis-aligned box containing the shape, in world space */
+		AABB const& getBoundingBox() const { updateCache(); return bounds; };
+
 	private:
-		ShapeType type;					/* Type of shape */
-		Vector2 pos;					/* Position of shape */
-		double radius;					/* Radius, if shape is circle */
-		std::vector<Vector2> points;	/* Points defining polygon */
-		std::vector<Vector2> normals;	/* List of unique normal vectors for every edge */
+		/**
+		 * \brief Calculate the normals if there are enough points, or clear them if there aren't. Does nothing in a batch
+		 */
+		void refreshNormals();
+
+		/**\return true if an edit can update its edges in place instead of rebuilding every normal */
+		bool canUpdateEdges() const;
+
+		/**
+		 * \brief Update the normals after an edit of a polygon with at least 3 points
+		 *
+		 * \param areaChange change in twice the signed area, flipping every normal if the winding reversed
+		 * \param edgeA edge to recompute
+		 * \param edgeB another edge to recompute, or -1
+		 */
+		void updateEdges(double areaChange, int edgeA, int edgeB);
+
+		ShapeType type;						/* Type of shape */
+		Transform2D transform;				/* Own placement in the world */
+		const Transform2D* followed = nullptr;	/* Transform followed instead of the own one, if any */
+		double radius;						/* Radius, if shape is circle */
+		std::vector<Vector2> points;		/* Points defining polygon */
+		std::vector<Vector2> normals;		/* Outward unit normal of every edge. normals[i] belongs to the edge from points[i] to points[i + 1] */
+		double twiceArea = 0.0;				/* Twice the signed area, negative when the points wind clockwise */
+		int editDepth = 0;					/* Number of unfinished beginEdit calls */
+
+		// World-space caches, rebuilt lazily after the transform or points change
+		mutable std::vector<Vector2> axes;			/* normals without parallel or opposite duplicates */
+		mutable Vector2Array worldPoints;			/* points placed by the transform, in x and y arrays for the SIMD kernels */
+		mutable std::vector<Vector2> worldNormals;	/* normals in world space */
+		mutable std::vector<Vector2> worldAxes;		/* axes in world space */
+		mutable AABB bounds;						/* Bounding box of worldPoints, or of the circle */
+		mutable bool worldPointsDirty = true;		/* worldPoints and bounds need rebuilding */
+		mutable bool axesDirty = true;				/* axes need rebuilding */
+		mutable bool worldNormalsDirty = true;		/* worldNormals and worldAxes need rebuilding */
+		mutable const Transform2D* cachedTransform = nullptr;	/* Transform the caches were built with */
+		mutable std::uint64_t cachedVersion = 0;				/* Its version when they were built */
+		mutable Vector2 cachedRotation = Vector2(1, 0);			/* Its rotation when they were built */
 	};
 }
 
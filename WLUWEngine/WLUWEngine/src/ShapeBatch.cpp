@@ -0,0 +1,407 @@
+/*****************************************************************//**
+ * \file   ShapeBatch.cpp
+ * \brief  Implementation of the batched SAT narrowphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "SATHelpers.h"
+#include "ShapeBatch.h"
+
+#if WLUW_X86
+#include <immintrin.h>
+#endif
+
+using namespace WLUW;
+
+// Aliases
+using Proj = std::pair<double, double>;
+using MTV = std::pair<Vector2, double>;
+
+/*
+ * Lane data holds one pair per lane, in blocks of 2 * lanes doubles. Block i holds the x components of vector i of
+ * every lane, then their y components, so a single load fetches the same vector of every pair. Lanes with fewer
+ * vectors repeat their last one, which leaves every projection and overlap unchanged
+ */
+namespace
+{
+    /**
+     * \brief Helper function which gets how many pairs the batched SAT collides at once
+     *
+     * \param level instruction set to use
+     * \return number of lanes, 1 if pairs go one at a time
+     */
+    int laneCount(SimdLevel level)
+    {
+#if WLUW_X86
+        if (level == SimdLevel::AVX2)
+            return 4;
+        if (level == SimdLevel::SSE2)
+            return 2;
+#endif
+        return 1;
+    }
+
+    /**
+     * \struct LaneWriter
+     * \brief Appends vectors to one lane of lane data, which must already be large enough
+     */
+    struct LaneWriter
+    {
+        double* data;	/* Lane data */
+        int lane;		/* Lane to write */
+        int lanes;		/* Number of lanes */
+        int count = 0;	/* Number of vectors written */
+
+        void push_back(Vector2 v)
+        {
+            data[2 * lanes * count + lane] = v.x;
+            data[2 * lanes * count + lanes + lane] = v.y;
+            count++;
+        }
+
+        void pop_back() { count--; };
+
+        int size() const { return count; };
+
+        Vector2 operator[](int index) const { return Vector2(data[2 * lanes * index + lane], data[2 * lanes * index + lanes + lane]); };
+
+        /**
+         * \brief Repeat the last vector, which leaves every projection of the lane unchanged
+         *
+         * \param padded number of vectors the lane should end up with
+         */
+        void pad(int padded)
+        {
+            Vector2 const last = (*this)[count - 1];
+            while (count < padded)
+                push_back(last);
+        }
+    };
+
+#if WLUW_X86
+    /**
+     * \brief Helper function which projects one polygon per lane onto one axis per lane, two lanes at a time
+     *
+     * \param vertices lane data of the polygons
+     * \param count number of vertices in every lane
+     * \param ax x components of the axes
+     * \param ay y components of the axes
+     * \param min set to the smallest projection of each lane
+     * \param max set to the largest projection of each lane
+     */
+    void projectLanesSSE2(const double* vertices, int count, __m128d ax, __m128d ay, __m128d& min, __m128d& max)
+    {
+        min = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        max = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+
+        for (int i = 0; i < count; i++)
+        {
+            // Same multiply then add as the projection kernels, so every lane rounds exactly like the single pair path
+            __m128d p = _mm_add_pd(_mm_mul_pd(ax, _mm_loadu_pd(vertices + 4 * i)), _mm_mul_pd(ay, _mm_loadu_pd(vertices + 4 * i + 2)));
+            min = _mm_min_pd(p, min);
+            max = _mm_max_pd(p, max);
+        }
+    }
+
+    /**
+     * \brief Helper function which runs SAT on two pairs at once, one per lane
+     *
+     * \param axes lane data of the axes
+     * \param axisCount number of axes in every lane
+     * \param verticesA lane data of the first polygon of each pair
+     * \param countA number of vertices in every lane of verticesA
+     * \param verticesB lane data of the second polygon of each pair
+     * \param countB number of vertices in every lane of verticesB
+     * \param axisX set to the x component of each lane's axis of least overlap
+     * \param axisY set to its y component
+     * \param depths set to each lane's overlap along that axis, NaN if its polygons are apart
+     */
+    void collideSSE2(const double* axes, int axisCount, const double* verticesA, int countA, const double* verticesB, int countB,
+        double* axisX, double* axisY, double* depths)
+    {
+        __m128d depth = _mm_set1_pd(std::numeric_limits<double>::max());
+        __m128d bestX = _mm_setzero_pd();
+        __m128d bestY = _mm_setzero_pd();
+        __m128d separated = _mm_setzero_pd();
+
+        for (int i = 0; i < axisCount; i++)
+        {
+            __m128d ax = _mm_loadu_pd(axes + 4 * i);
+            __m128d ay = _mm_loadu_pd(axes + 4 * i + 2);
+
+            __m128d minA, maxA, minB, maxB;
+            projectLanesSSE2(verticesA, countA, ax, ay, minA, maxA);
+            projectLanesSSE2(verticesB, countB, ax, ay, minB, maxB);
+
+            // Stop once every lane has found a separating axis
+            separated = _mm_or_pd(separated, _mm_or_pd(_mm_cmpgt_pd(minB, maxA), _mm_cmpgt_pd(minA, maxB)));
+            if (_mm_movemask_pd(separated) == 0x3)
+                break;
+
+            // Keep the first strictly smaller overlap, as the single pair path does. SSE2 has no blend, so mask instead
+            __m128d overlap = _mm_min_pd(_mm_sub_pd(maxB, minA), _mm_sub_pd(maxA, minB));
+            __m128d better = _mm_cmplt_pd(overlap, depth);
+            depth = _mm_or_pd(_mm_and_pd(better, overlap), _mm_andnot_pd(better, depth));
+            bestX = _mm_or_pd(_mm_and_pd(better, ax), _mm_andnot_pd(better, bestX));
+            bestY = _mm_or_pd(_mm_and_pd(better, ay), _mm_andnot_pd(better, bestY));
+        }
+
+        __m128d nan = _mm_set1_pd(std::numeric_limits<double>::quiet_NaN());
+        _mm_storeu_pd(depths, _mm_or_pd(_mm_and_pd(separated, nan), _mm_andnot_pd(separated, depth)));
+        _mm_storeu_pd(axisX, bestX);
+        _mm_storeu_pd(axisY, bestY);
+    }
+
+    /**
+     * \brief Helper function which projects one polygon per lane onto one axis per lane, four lanes at a time
+     */
+    WLUW_TARGET_AVX2 void projectLanesAVX2(const double* vertices, int count, __m256d ax, __m256d ay, __m256d& min, __m256d& max)
+    {
+        min = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+        max = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+
+        for (int i = 0; i < count; i++)
+        {
+            __m256d p = _mm256_add_pd(_mm256_mul_pd(ax, _mm256_loadu_pd(vertices + 8 * i)), _mm256_mul_pd(ay, _mm256_loadu_pd(vertices + 8 * i + 4)));
+            min = _mm256_min_pd(p, min);
+            max = _mm256_max_pd(p, max);
+        }
+    }
+
+    /**
+     * \brief Helper function which runs SAT on four pairs at once, one per lane
+     */
+    WLUW_TARGET_AVX2 void collideAVX2(const double* axes, int axisCount, const double* verticesA, int countA, const double* verticesB,
+        int countB, double* axisX, double* axisY, double* depths)
+    {
+        __m256d depth = _mm256_set1_pd(std::numeric_limits<double>::max());
+        __m256d bestX = _mm256_setzero_pd();
+        __m256d bestY = _mm256_setzero_pd();
+        __m256d separated = _mm256_setzero_pd();
+
+        for (int i = 0; i < axisCount; i++)
+        {
+            __m256d ax = _mm256_loadu_pd(axes + 8 * i);
+            __m256d ay = _mm256_loadu_pd(axes + 8 * i + 4);
+
+            __m256d minA, maxA, minB, maxB;
+            projectLanesAVX2(verticesA, countA, ax, ay, minA, maxA);
+            projectLanesAVX2(verticesB, countB, ax, ay, minB, maxB);
+
+            separated = _mm256_or_pd(separated, _mm256_or_pd(_mm256_cmp_pd(minB, maxA, _CMP_GT_OQ), _mm256_cmp_pd(minA, maxB, _CMP_GT_OQ)));
+            if (_mm256_movemask_pd(separated) == 0xF)
+                break;
+
+            __m256d overlap = _mm256_min_pd(_mm256_sub_pd(maxB, minA), _mm256_sub_pd(maxA, minB));
+            __m256d better = _mm256_cmp_pd(overlap, depth, _CMP_LT_OQ);
+            depth = _mm256_blendv_pd(depth, overlap, better);
+            bestX = _mm256_blendv_pd(bestX, ax, better);
+            bestY = _mm256_blendv_pd(bestY, ay, better);
+        }
+
+        _mm256_storeu_pd(depths, _mm256_blendv_pd(depth, _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN()), separated));
+        _mm256_storeu_pd(axisX, bestX);
+        _mm256_storeu_pd(axisY, bestY);
+    }
+#endif
+}
+
+int WLUW::ShapeBatch::addShape(const Shape& shape)
+{
+    Entry entry;
+    entry.shape = &shape;
+    entry.firstVertex = vertices.size();
+    entry.firstAxis = axes.size();
+    entry.center = shape.getBoundingBox().getCenter();
+
+    vertices.append(shape.getWorldPoints());
+
+    if (shape.getShapeType() == ShapeType::POLYGON)
+    {
+        for (auto& axis : shape.getWorldAxes())
+            axes.push_back(axis);
+    }
+
+    entry.vertexCount = vertices.size() - entry.firstVertex;
+    entry.axisCount = axes.size() - entry.firstAxis;
+
+    entries.push_back(entry);
+    return static_cast<int>(entries.size()) - 1;
+}
+
+void WLUW::ShapeBatch::clear()
+{
+    entries.clear();
+    vertices.clear();
+    axes.clear();
+}
+
+void WLUW::ShapeBatch::checkCollisions(const std::vector<std::pair<int, int>>& pairs, std::vector<MTV>& results,
+    CollisionScratch& scratch, SimdLevel level) const
+{
+    results.clear();
+    results.resize(pairs.size());
+
+    // Polygon pairs wait until there is one for every lane
+    int const lanes = laneCount(level);
+    int group[4];
+    int grouped = 0;
+
+    for (int i = 0; i < pairs.size(); i++)
+    {
+        const Entry& a = entries[pairs[i].first];
+        const Entry& b = entries[pairs[i].second];
+
+        if (a.shape->getShapeType() != ShapeType::POLYGON || b.shape->getShapeType() != ShapeType::POLYGON)
+        {
+            results[i] = Shape::checkCollision(*a.shape, *b.shape, scratch);
+            continue;
+        }
+
+        if (lanes == 1 || a.axisCount == 0 || b.axisCount == 0)
+        {
+            results[i] = collidePolygons(a, b, scratch, level);
+            continue;
+        }
+
+        group[grouped++] = i;
+        if (grouped == lanes)
+        {
+            collideGroup(pairs, group, grouped, lanes, results, scratch);
+            grouped = 0;
+        }
+    }
+
+    if (grouped > 0)
+        collideGroup(pairs, group, grouped, lanes, results, scratch);
+}
+
+MTV WLUW::ShapeBatch::collidePolygons(const Entry& a, const Entry& b, CollisionScratch& scratch, SimdLevel level) const
+{
+    // Gather axes in the same order as Shape::checkCollision so ties resolve the same way
+    AxisBuffer<16> pairAxes(scratch.axes);
+    mergeAxes([&](int i) { return axes.get(a.firstAxis + i); }, a.axisCount,
+        [&](int i) { return axes.get(b.firstAxis + i); }, b.axisCount, pairAxes);
+
+    MTV mtv(Vector2(0, 0), std::numeric_limits<double>::max());
+
+    for (int i = 0; i < pairAxes.size(); i++)
+    {
+        Proj projA = vertices.projectOntoAxis(a.firstVertex, a.vertexCount, pairAxes[i], level);
+        Proj projB = vertices.projectOntoAxis(b.firstVertex, b.vertexCount, pairAxes[i], level);
+        double overlap = overlapping(projA, projB);
+
+        // Found a separating axis, the shapes can't overlap
+        if (std::isnan(overlap))
+            return noCollision();
+
+        if (overlap < mtv.second)
+        {
+            mtv.first = pairAxes[i];
+            mtv.second = overlap;
+        }
+    }
+
+    // Point the axis from b towards a
+    if ((a.center - b.center).dot(mtv.first) < 0.0)
+        mtv.first = -mtv.first;
+
+    return mtv;
+}
+
+void WLUW::ShapeBatch::collideGroup(const std::vector<std::pair<int, int>>& pairs, const int* group, int count, int lanes,
+    std::vector<MTV>& results, CollisionScratch& scratch) const
+{
+    int maxAxes = 0;
+    int maxA = 0;
+    int maxB = 0;
+
+    // Size the lane data for the longest lane first, so gathering only writes
+    for (int lane = 0; lane < count; lane++)
+    {
+        const Entry& a = entries[pairs[group[lane]].first];
+        const Entry& b = entries[pairs[group[lane]].second];
+        maxAxes = std::max(maxAxes, a.axisCount + b.axisCount);
+        maxA = std::max(maxA, a.vertexCount);
+        maxB = std::max(maxB, b.vertexCount);
+    }
+
+    std::size_t const blocks = static_cast<std::size_t>(2 * lanes);
+    if (scratch.laneAxes.size() < blocks * maxAxes)
+        scratch.laneAxes.resize(blocks * maxAxes);
+    if (scratch.laneVerticesA.size() < blocks * maxA)
+        scratch.laneVerticesA.resize(blocks * maxA);
+    if (scratch.laneVerticesB.size() < blocks * maxB)
+        scratch.laneVerticesB.resize(blocks * maxB);
+
+    // Gather each pair's axes and vertices into its lane
+    LaneWriter laneAxes[4];
+    LaneWriter laneA[4];
+    LaneWriter laneB[4];
+    maxAxes = 0;
+
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        const std::pair<int, int>& pair = pairs[group[std::min(lane, count - 1)]];
+        const Entry& a = entries[pair.first];
+        const Entry& b = entries[pair.second];
+
+        laneAxes[lane] = { scratch.laneAxes.data(), lane, lanes };
+        mergeAxes([&](int i) { return axes.get(a.firstAxis + i); }, a.axisCount,
+            [&](int i) { return axes.get(b.firstAxis + i); }, b.axisCount, laneAxes[lane]);
+        maxAxes = std::max(maxAxes, laneAxes[lane].size());
+
+        laneA[lane] = { scratch.laneVerticesA.data(), lane, lanes };
+        for (int i = 0; i < a.vertexCount; i++)
+            laneA[lane].push_back(vertices.get(a.firstVertex + i));
+
+        laneB[lane] = { scratch.laneVerticesB.data(), lane, lanes };
+        for (int i = 0; i < b.vertexCount; i++)
+            laneB[lane].push_back(vertices.get(b.firstVertex + i));
+    }
+
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        laneAxes[lane].pad(maxAxes);
+        laneA[lane].pad(maxA);
+        laneB[lane].pad(maxB);
+    }
+
+    double axisX[4];
+    double axisY[4];
+    double depths[4];
+
+#if WLUW_X86
+    if (lanes == 4)
+        collideAVX2(scratch.laneAxes.data(), maxAxes, scratch.laneVerticesA.data(), maxA, scratch.laneVerticesB.data(), maxB,
+            axisX, axisY, depths);
+    else
+        collideSSE2(scratch.laneAxes.data(), maxAxes, scratch.laneVerticesA.data(), maxA, scratch.laneVerticesB.data(), maxB,
+            axisX, axisY, depths);
+#endif
+
+    for (int lane = 0; lane < count; lane++)
+    {
+        if (std::isnan(depths[lane]))
+        {
+            results[group[lane]] = noCollision();
+            continue;
+        }
+
+        const std::pair<int, int>& pair = pairs[group[lane]];
+        MTV mtv(Vector2(axisX[lane], axisY[lane]), depths[lane]);
+
+        // Point the axis from b towards a
+        if ((entries[pair.first].center - entries[pair.second].center).dot(mtv.first) < 0.0)
+            mtv.first = -mtv.first;
+
+        results[group[lane]] = mtv;
+    }
+}
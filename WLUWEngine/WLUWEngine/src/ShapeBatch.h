@@ -0,0 +1,101 @@
+/*****************************************************************//**
+ * \file   ShapeBatch.h
+ * \brief  Structure-of-arrays shape data for running the narrowphase over many pairs at once
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "CollisionScratch.h"
+#include "CpuFeatures.h"
+#include "Shape.h"
+#include "Vector2.h"
+#include "Vector2Array.h"
+
+namespace WLUW
+{
+	/**
+	 * \class ShapeBatch ShapeBatch.h
+	 * \brief Snapshot of many shapes with their world-space vertices and SAT axes packed into flat x and y arrays.
+	 * Polygon pairs are collided side by side, one pair per SSE2 or AVX2 lane picked at runtime, so even small
+	 * polygons fill the lanes. They give exactly the same MTV as Shape::checkCollision with CollisionAlgorithm::SAT.
+	 * Pairs involving a circle fall back to Shape::checkCollision.
+	 */
+	class ShapeBatch
+	{
+	public:
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Copy a shape into the batch. The shape must outlive the batch
+		 *
+		 * \param shape shape to add
+		 * \return index of the shape within the batch
+		 */
+		int addShape(const Shape& shape);
+
+		/**
+		 * \brief Remove every shape. Buffers keep their capacity
+		 */
+		void clear();
+
+		/**
+		 * \brief Checks for collisions between many pairs of shapes in the batch
+		 *
+		 * \param pairs indices of the two shapes in each pair
+		 * \param results cleared, then filled with the MTV of each pair, in the same order as pairs
+		 * \param scratch working memory reused across pairs
+		 * \param level instruction set to use, defaults to the best the CPU supports
+		 */
+		void checkCollisions(const std::vector<std::pair<int, int>>& pairs, std::vector<std::pair<Vector2, double>>& results,
+			CollisionScratch& scratch, SimdLevel level = getSimdLevel()) const;
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return number of shapes in the batch */
+		int size() const { return static_cast<int>(entries.size()); };
+
+	private:
+		/**
+		 * \struct Entry
+		 * \brief Where a shape's data lives in the flat arrays
+		 */
+		struct Entry
+		{
+			const Shape* shape;		/* Source shape, used for circles */
+			int firstVertex;		/* Index of the first vertex in vertices */
+			int vertexCount;		/* Number of vertices */
+			int firstAxis;			/* Index of the first axis in axes */
+			int axisCount;			/* Number of axes */
+			Vector2 center;			/* Centre of the bounding box, used to orient the MTV */
+		};
+
+		std::pair<Vector2, double> collidePolygons(const Entry& a, const Entry& b, CollisionScratch& scratch, SimdLevel level) const;
+
+		/**
+		 * \brief Collide polygon pairs side by side, one pair per SIMD lane
+		 *
+		 * \param pairs every pair being checked
+		 * \param group indices into pairs of the pairs to collide
+		 * \param count number of pairs in group, at most lanes. Lanes left over repeat the last pair
+		 * \param lanes number of lanes, 2 for SSE2 or 4 for AVX2
+		 * \param results receives the MTV of each pair, at the same index as in pairs
+		 * \param scratch working memory for the lane data
+		 */
+		void collideGroup(const std::vector<std::pair<int, int>>& pairs, const int* group, int count, int lanes,
+			std::vector<std::pair<Vector2, double>>& results, CollisionScratch& scratch) const;
+
+		std::vector<Entry> entries;		/* One entry per shape */
+		Vector2Array vertices;			/* World-space vertices of every shape */
+		Vector2Array axes;				/* SAT axes of every shape */
+	};
+}
@@ -0,0 +1,68 @@
+/*****************************************************************//**
+ * \file   TimeOfImpact.cpp
+ * \brief  Implementation of the swept time of impact query
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include "GJK.h"
+#include "Shape.h"
+#include "TimeOfImpact.h"
+
+using namespace WLUW;
+
+namespace
+{
+    constexpr int MAX_TOI_ITERATIONS = 32;      /* Cap on advancement steps, convergence is usually within a handful */
+    constexpr double TOI_TARGET = 1e-6;         /* Gap left between the shapes at the time of impact */
+    constexpr double TOI_TOLERANCE = 0.25e-6;   /* How close to the target gap counts as touching */
+}
+
+TOIResult WLUW::timeOfImpact(const Shape& a, Vector2 startA, Vector2 endA, const Shape& b, Vector2 startB, Vector2 endB)
+{
+    TOIResult result;
+    result.hit = false;
+    result.time = 1.0;
+    result.normal = Vector2(0, 0);
+    result.iterations = 0;
+
+    // Work in a's frame, where b is offset from where its points are stored and moves by the relative motion
+    Vector2 const offset = (startB - b.getPosition()) - (startA - a.getPosition());
+    Vector2 const motion = (endB - startB) - (endA - startA);
+
+    double time = 0.0;
+    while (result.iterations < MAX_TOI_ITERATIONS)
+    {
+        GJKResult gap = gjkDistance(a, b, offset + motion * time);
+        result.iterations++;
+
+        // Overlapping from the start, leave it to the discrete narrowphase
+        if (gap.distance <= 0.0)
+            return result;
+
+        result.normal = (gap.pointB - gap.pointA) / gap.distance;
+
+        // The gap is convex in time, so it can't shrink faster than its current rate. Moving apart means it never closes
+        double closingSpeed = -motion.dot(result.normal);
+        if (closingSpeed <= 0.0)
+            return result;
+
+        if (gap.distance <= TOI_TARGET + TOI_TOLERANCE)
+        {
+            result.hit = true;
+            result.time = time;
+            return result;
+        }
+
+        // Stop just short of touching, so the shapes are still apart and the normal stays well defined
+        time += (gap.distance - TOI_TARGET) / closingSpeed;
+        if (time > 1.0)
+            return result;
+    }
+
+    // Every step was conservative, so stopping early still leaves the shapes apart
+    result.hit = true;
+    result.time = time;
+    return result;
+}
@@ -0,0 +1,44 @@
+/*****************************************************************//**
+ * \file   TimeOfImpact.h
+ * \brief  Swept time of impact queries between moving convex shapes
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include "Vector2.h"
+
+namespace WLUW
+{
+	class Shape;
+
+	/**
+	 * \struct TOIResult
+	 * \brief First contact between two swept shapes
+	 */
+	struct TOIResult
+	{
+		bool hit;			/* Whether the shapes come into contact during the sweep */
+		double time;		/* Fraction of the sweep at first contact, 1 if there is no hit */
+		Vector2 normal;		/* Contact normal at the time of impact, pointing from a to b */
+		int iterations;		/* Number of advancement steps taken */
+	};
+
+	/**
+	 * \brief Finds when two shapes moving in straight lines first touch, using conservative advancement.
+	 * Each step measures the gap with GJK and advances by the largest amount which can't close it, so thin
+	 * or fast shapes can't be skipped over. Shapes that already overlap at the start report no hit, the
+	 * discrete narrowphase deals with those
+	 *
+	 * \param a first shape
+	 * \param startA position of a at the start of the sweep
+	 * \param endA position of a at the end of the sweep
+	 * \param b second shape
+	 * \param startB position of b at the start of the sweep
+	 * \param endB position of b at the end of the sweep
+	 * \return time of impact. The shapes themselves are not moved
+	 */
+	TOIResult timeOfImpact(const Shape& a, Vector2 startA, Vector2 endA, const Shape& b, Vector2 startB, Vector2 endB);
+}
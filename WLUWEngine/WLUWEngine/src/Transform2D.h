@@ -0,0 +1,214 @@
+/*****************************************************************//**
+ * \file   Transform2D.h
+ * \brief  Rotation, uniform scale and translation placing local-space geometry in the world
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "CpuFeatures.h"
+#include "Vector2.h"
+#include "Vector2Array.h"
+
+namespace WLUW
+{
+	/**
+	 * \class Transform2D Transform2D.h
+	 * \brief Maps a local point p to rotation * (scale * p) + translation. The rotation is kept as its cosine and
+	 * sine so applying it needs no trigonometry. Every change bumps a version number, which lets anything
+	 * caching transformed geometry, such as Shape, skip the work while the transform stays the same
+	 */
+	class Transform2D
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor. Creates the identity transform
+		 */
+		Transform2D()
+		{
+		}
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param translation where the local origin ends up
+		 * \param angle rotation in radians, counter-clockwise
+		 * \param scale uniform scale, greater than 0
+		 */
+		Transform2D(Vector2 translation, double angle = 0.0, double scale = 1.0)
+			: translation(translation), rotation(std::cos(angle), std::sin(angle)), scale(scale)
+		{
+			if (scale <= 0.0)
+				throw("Scale must be positive");
+		}
+
+		Transform2D(const Transform2D& other) = default;
+
+		/**
+		 * \brief Copy assignment. Takes the other transform's value but bumps the own version rather than copying
+		 * the other's, which could match the version a cache last saw of this transform
+		 */
+		Transform2D& operator=(const Transform2D& other)
+		{
+			if (*this == other)
+				return *this;
+
+			translation = other.translation;
+			rotation = other.rotation;
+			scale = other.scale;
+			version++;
+			return *this;
+		}
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Transform a point from local to world space
+		 *
+		 * \param local local-space point
+		 * \return world-space point
+		 */
+		Vector2 apply(Vector2 local) const
+		{
+			Vector2 const xAxis = getXAxis();
+			Vector2 const yAxis = getYAxis();
+
+			// Same order of operations as Vector2Array::transform, so single points match batched ones
+			return Vector2((xAxis.x * local.x + yAxis.x * local.y) + translation.x, (xAxis.y * local.x + yAxis.y * local.y) + translation.y);
+		}
+
+		/**
+		 * \brief Transform many points from local to world space in one pass
+		 *
+		 * \param local local-space points
+		 * \param world overwritten with the world-space points, may be local
+		 * \param level instruction set to use
+		 */
+		void apply(const Vector2Array& local, Vector2Array& world, SimdLevel level = getSimdLevel()) const
+		{
+			// Pure translations skip the multiplies, which also keeps them exact
+			if (isTranslation())
+			{
+				if (&world != &local)
+					world = local;
+				world.add(translation, level);
+				return;
+			}
+
+			world.transform(local, getXAxis(), getYAxis(), translation, level);
+		}
+
+		/**
+		 * \brief Rotate a direction, such as a normal, from local to world space. Uniform scale doesn't change directions
+		 *
+		 * \param local local-space direction
+		 * \return world-space direction
+		 */
+		Vector2 rotate(Vector2 local) const
+		{
+			return Vector2(rotation.x * local.x - rotation.y * local.y, rotation.y * local.x + rotation.x * local.y);
+		}
+
+		/**
+		 * \brief Combine with a transform applied before this one, such as a part's placement within its parent
+		 *
+		 * \param inner transform applied first
+		 * \return transform which applies inner and then this
+		 */
+		Transform2D combine(const Transform2D& inner) const
+		{
+			Transform2D result;
+			result.translation = apply(inner.translation);
+			result.rotation = rotate(inner.rotation);
+			result.scale = scale * inner.scale;
+			return result;
+		}
+
+		friend bool operator==(const Transform2D& a, const Transform2D& b)
+		{
+			return a.translation == b.translation && a.rotation == b.rotation && a.scale == b.scale;
+		}
+
+		/////////////////////
+		//// Getters/Setters
+		/////////////////////
+
+		/**\return where the local origin ends up */
+		Vector2 getTranslation() const { return translation; };
+
+		/**\brief Set where the local origin ends up */
+		void setTranslation(Vector2 translation)
+		{
+			if (translation == this->translation)
+				return;
+
+			this->translation = translation;
+			version++;
+		}
+
+		/**\return cosine and sine of the rotation */
+		Vector2 getRotation() const { return rotation; };
+
+		/**\return rotation in radians, between -pi and pi */
+		double getAngle() const { return std::atan2(rotation.y, rotation.x); };
+
+		/**\brief Set the rotation in radians, counter-clockwise */
+		void setRotation(double angle)
+		{
+			Vector2 rotation(std::cos(angle), std::sin(angle));
+			if (rotation == this->rotation)
+				return;
+
+			this->rotation = rotation;
+			version++;
+		}
+
+		/**\return uniform scale */
+		double getScale() const { return scale; };
+
+		/**\brief Set the uniform scale, which must be greater than 0 */
+		void setScale(double scale)
+		{
+			if (scale <= 0.0)
+			{
+				throw("Scale must be positive");
+				return;
+			}
+
+			if (scale == this->scale)
+				return;
+
+			this->scale = scale;
+			version++;
+		}
+
+		/**\return image of the local x axis, the first column of the matrix */
+		Vector2 getXAxis() const { return rotation * scale; };
+
+		/**\return image of the local y axis, the second column of the matrix */
+		Vector2 getYAxis() const { return rotation.normal() * scale; };
+
+		/**\return true if the transform only translates */
+		bool isTranslation() const { return rotation == Vector2(1, 0) && scale == 1.0; };
+
+		/**\return number which changes whenever the transform does */
+		std::uint64_t getVersion() const { return version; };
+
+	private:
+		Vector2 translation;			/* Where the local origin ends up */
+		Vector2 rotation = Vector2(1, 0);	/* Cosine and sine of the rotation */
+		double scale = 1.0;				/* Uniform scale */
+		std::uint64_t version = 0;		/* Bumped by every change */
+	};
+}
@@ -55,7 +55,7 @@ namespace WLUW
             // Otherwise, create a new ID
             else
             {
-                static const int id = count++;
+                int id = count++;
                 currentlyUsed.insert(id);
                 return id;
             }
@@ -97,4 +97,6 @@ namespace WLUW
 
     template<class T> int TypeIdManager<T>::count = 1;
     template<class T> int TypeIdManager<T>::uniqueClassCounter = 1;
+    template<class T> std::set<int> TypeIdManager<T>::currentlyUsed;
+    template<class T> std::priority_queue<int, std::vector<int>, std::greater<int>> TypeIdManager<T>::reuseableIDs;
 }
@@ -0,0 +1,699 @@
+/*****************************************************************//**
+ * \file   Vector2Array.cpp
+ * \brief  Implementation of the structure-of-arrays vector buffer and its SIMD kernels
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Vector2Array.h"
+
+#if WLUW_X86
+#include <immintrin.h>
+#endif
+
+using namespace WLUW;
+
+// Aliases
+using Proj = std::pair<double, double>;
+
+namespace
+{
+    /**
+     * \struct Kernels
+     * \brief Bulk operations for one instruction set. Each works on separate x and y arrays
+     */
+    struct Kernels
+    {
+        void (*addOffset)(double* xs, double* ys, int count, Vector2 offset);
+        void (*addScaled)(double* xs, double* ys, const double* otherX, const double* otherY, int count, double scale);
+        void (*scale)(double* xs, double* ys, int count, double factor);
+        void (*dot)(const double* xs, const double* ys, int count, Vector2 axis, double* out);
+        Proj (*project)(const double* xs, const double* ys, int count, Vector2 axis);
+        AABB (*bounds)(const double* xs, const double* ys, int count);
+        void (*normalize)(double* xs, double* ys, int count);
+        void (*transform)(const double* sourceX, const double* sourceY, int count, Vector2 xAxis, Vector2 yAxis, Vector2 translation,
+            double* xs, double* ys);
+    };
+
+    /////////////////////
+    //// Scalar
+    /////////////////////
+
+    /**
+     * \brief Helper function which adds an offset to packed vectors one at a time
+     */
+    void addOffsetScalar(double* xs, double* ys, int count, Vector2 offset)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            xs[i] = xs[i] + offset.x;
+            ys[i] = ys[i] + offset.y;
+        }
+    }
+
+    /**
+     * \brief Helper function which adds scaled packed vectors to others one at a time
+     */
+    void addScaledScalar(double* xs, double* ys, const double* otherX, const double* otherY, int count, double scale)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            xs[i] = xs[i] + otherX[i] * scale;
+            ys[i] = ys[i] + otherY[i] * scale;
+        }
+    }
+
+    /**
+     * \brief Helper function which multiplies packed vectors by a number one at a time
+     */
+    void scaleScalar(double* xs, double* ys, int count, double factor)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            xs[i] = xs[i] * factor;
+            ys[i] = ys[i] * factor;
+        }
+    }
+
+    /**
+     * \brief Helper function which dots packed vectors with an axis one at a time
+     */
+    void dotScalar(const double* xs, const double* ys, int count, Vector2 axis, double* out)
+    {
+        for (int i = 0; i < count; i++)
+            out[i] = axis.x * xs[i] + axis.y * ys[i];
+    }
+
+    /**
+     * \brief Helper function which projects packed vectors onto an axis one at a time
+     *
+     * \param xs x components
+     * \param ys y components
+     * \param count number of vectors, at least one
+     * \param axis axis to project onto
+     * \return min and max of the projection
+     */
+    Proj projectScalar(const double* xs, const double* ys, int count, Vector2 axis)
+    {
+        double min = axis.x * xs[0] + axis.y * ys[0];
+        double max = min;
+
+        for (int i = 1; i < count; i++)
+        {
+            double p = axis.x * xs[i] + axis.y * ys[i];
+            min = std::min(min, p);
+            max = std::max(max, p);
+        }
+
+        return Proj(min, max);
+    }
+
+    /**
+     * \brief Helper function which bounds packed vectors one at a time
+     *
+     * \param xs x components
+     * \param ys y components
+     * \param count number of vectors, at least one
+     * \return smallest box containing the vectors
+     */
+    AABB boundsScalar(const double* xs, const double* ys, int count)
+    {
+        Vector2 min(xs[0], ys[0]);
+        Vector2 max = min;
+
+        for (int i = 1; i < count; i++)
+        {
+            min.x = std::min(min.x, xs[i]);
+            min.y = std::min(min.y, ys[i]);
+            max.x = std::max(max.x, xs[i]);
+            max.y = std::max(max.y, ys[i]);
+        }
+
+        return AABB(min, max);
+    }
+
+    /**
+     * \brief Helper function which normalizes packed vectors one at a time
+     */
+    void normalizeScalar(double* xs, double* ys, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            double length = std::sqrt(xs[i] * xs[i] + ys[i] * ys[i]);
+            xs[i] = length != 0.0 ? xs[i] / length : 0.0;
+            ys[i] = length != 0.0 ? ys[i] / length : 0.0;
+        }
+    }
+
+    /**
+     * \brief Helper function which applies an affine transform to packed vectors one at a time
+     */
+    void transformScalar(const double* sourceX, const double* sourceY, int count, Vector2 xAxis, Vector2 yAxis, Vector2 translation,
+        double* xs, double* ys)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            // Read both components before writing, so the source may be the destination
+            double x = sourceX[i];
+            double y = sourceY[i];
+            xs[i] = (xAxis.x * x + yAxis.x * y) + translation.x;
+            ys[i] = (xAxis.y * x + yAxis.y * y) + translation.y;
+        }
+    }
+
+    const Kernels scalarKernels = { addOffsetScalar, addScaledScalar, scaleScalar, dotScalar, projectScalar, boundsScalar,
+        normalizeScalar, transformScalar };
+
+#if WLUW_X86
+    /////////////////////
+    //// SSE2
+    /////////////////////
+
+    // Each kernel handles whole registers and leaves the remainder to the scalar version
+
+    /**
+     * \brief Helper function which adds an offset to packed vectors two at a time
+     */
+    void addOffsetSSE2(double* xs, double* ys, int count, Vector2 offset)
+    {
+        __m128d ox = _mm_set1_pd(offset.x);
+        __m128d oy = _mm_set1_pd(offset.y);
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            _mm_storeu_pd(xs + i, _mm_add_pd(_mm_loadu_pd(xs + i), ox));
+            _mm_storeu_pd(ys + i, _mm_add_pd(_mm_loadu_pd(ys + i), oy));
+        }
+
+        addOffsetScalar(xs + i, ys + i, count - i, offset);
+    }
+
+    /**
+     * \brief Helper function which adds scaled packed vectors to others two at a time
+     */
+    void addScaledSSE2(double* xs, double* ys, const double* otherX, const double* otherY, int count, double scale)
+    {
+        __m128d s = _mm_set1_pd(scale);
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            _mm_storeu_pd(xs + i, _mm_add_pd(_mm_loadu_pd(xs + i), _mm_mul_pd(_mm_loadu_pd(otherX + i), s)));
+            _mm_storeu_pd(ys + i, _mm_add_pd(_mm_loadu_pd(ys + i), _mm_mul_pd(_mm_loadu_pd(otherY + i), s)));
+        }
+
+        addScaledScalar(xs + i, ys + i, otherX + i, otherY + i, count - i, scale);
+    }
+
+    /**
+     * \brief Helper function which multiplies packed vectors by a number two at a time
+     */
+    void scaleSSE2(double* xs, double* ys, int count, double factor)
+    {
+        __m128d f = _mm_set1_pd(factor);
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            _mm_storeu_pd(xs + i, _mm_mul_pd(_mm_loadu_pd(xs + i), f));
+            _mm_storeu_pd(ys + i, _mm_mul_pd(_mm_loadu_pd(ys + i), f));
+        }
+
+        scaleScalar(xs + i, ys + i, count - i, factor);
+    }
+
+    /**
+     * \brief Helper function which dots packed vectors with an axis two at a time
+     */
+    void dotSSE2(const double* xs, const double* ys, int count, Vector2 axis, double* out)
+    {
+        __m128d ax = _mm_set1_pd(axis.x);
+        __m128d ay = _mm_set1_pd(axis.y);
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+            _mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(ax, _mm_loadu_pd(xs + i)), _mm_mul_pd(ay, _mm_loadu_pd(ys + i))));
+
+        dotScalar(xs + i, ys + i, count - i, axis, out + i);
+    }
+
+    /**
+     * \brief Helper function which projects packed vectors onto an axis two at a time
+     */
+    Proj projectSSE2(const double* xs, const double* ys, int count, Vector2 axis)
+    {
+        __m128d ax = _mm_set1_pd(axis.x);
+        __m128d ay = _mm_set1_pd(axis.y);
+        __m128d vmin = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        __m128d vmax = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            // Same multiply then add as Vector2::dot, so every lane rounds exactly like the scalar path
+            __m128d p = _mm_add_pd(_mm_mul_pd(ax, _mm_loadu_pd(xs + i)), _mm_mul_pd(ay, _mm_loadu_pd(ys + i)));
+            vmin = _mm_min_pd(vmin, p);
+            vmax = _mm_max_pd(vmax, p);
+        }
+
+        double mins[2], maxs[2];
+        _mm_storeu_pd(mins, vmin);
+        _mm_storeu_pd(maxs, vmax);
+
+        Proj result(std::min(mins[0], mins[1]), std::max(maxs[0], maxs[1]));
+
+        if (i < count)
+        {
+            Proj rest = projectScalar(xs + i, ys + i, count - i, axis);
+            result.first = std::min(result.first, rest.first);
+            result.second = std::max(result.second, rest.second);
+        }
+
+        return result;
+    }
+
+    /**
+     * \brief Helper function which bounds packed vectors two at a time
+     */
+    AABB boundsSSE2(const double* xs, const double* ys, int count)
+    {
+        __m128d minX = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        __m128d minY = minX;
+        __m128d maxX = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+        __m128d maxY = maxX;
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d x = _mm_loadu_pd(xs + i);
+            __m128d y = _mm_loadu_pd(ys + i);
+            minX = _mm_min_pd(minX, x);
+            minY = _mm_min_pd(minY, y);
+            maxX = _mm_max_pd(maxX, x);
+            maxY = _mm_max_pd(maxY, y);
+        }
+
+        double lanes[4][2];
+        _mm_storeu_pd(lanes[0], minX);
+        _mm_storeu_pd(lanes[1], minY);
+        _mm_storeu_pd(lanes[2], maxX);
+        _mm_storeu_pd(lanes[3], maxY);
+
+        AABB result(Vector2(std::min(lanes[0][0], lanes[0][1]), std::min(lanes[1][0], lanes[1][1])),
+            Vector2(std::max(lanes[2][0], lanes[2][1]), std::max(lanes[3][0], lanes[3][1])));
+
+        if (i < count)
+            result = AABB::combine(result, boundsScalar(xs + i, ys + i, count - i));
+
+        return result;
+    }
+
+    /**
+     * \brief Helper function which normalizes packed vectors two at a time
+     */
+    void normalizeSSE2(double* xs, double* ys, int count)
+    {
+        __m128d zero = _mm_setzero_pd();
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d x = _mm_loadu_pd(xs + i);
+            __m128d y = _mm_loadu_pd(ys + i);
+            __m128d length = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)));
+
+            // Zero lengths divide to NaN, mask those lanes back to zero
+            __m128d nonZero = _mm_cmpneq_pd(length, zero);
+            _mm_storeu_pd(xs + i, _mm_and_pd(nonZero, _mm_div_pd(x, length)));
+            _mm_storeu_pd(ys + i, _mm_and_pd(nonZero, _mm_div_pd(y, length)));
+        }
+
+        normalizeScalar(xs + i, ys + i, count - i);
+    }
+
+    /**
+     * \brief Helper function which applies an affine transform to packed vectors two at a time
+     */
+    void transformSSE2(const double* sourceX, const double* sourceY, int count, Vector2 xAxis, Vector2 yAxis, Vector2 translation,
+        double* xs, double* ys)
+    {
+        __m128d m00 = _mm_set1_pd(xAxis.x);
+        __m128d m10 = _mm_set1_pd(xAxis.y);
+        __m128d m01 = _mm_set1_pd(yAxis.x);
+        __m128d m11 = _mm_set1_pd(yAxis.y);
+        __m128d tx = _mm_set1_pd(translation.x);
+        __m128d ty = _mm_set1_pd(translation.y);
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d x = _mm_loadu_pd(sourceX + i);
+            __m128d y = _mm_loadu_pd(sourceY + i);
+            _mm_storeu_pd(xs + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, x), _mm_mul_pd(m01, y)), tx));
+            _mm_storeu_pd(ys + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, x), _mm_mul_pd(m11, y)), ty));
+        }
+
+        transformScalar(sourceX + i, sourceY + i, count - i, xAxis, yAxis, translation, xs + i, ys + i);
+    }
+
+    const Kernels sse2Kernels = { addOffsetSSE2, addScaledSSE2, scaleSSE2, dotSSE2, projectSSE2, boundsSSE2,
+        normalizeSSE2, transformSSE2 };
+
+    /////////////////////
+    //// AVX2
+    /////////////////////
+
+    // Separate multiplies and adds rather than FMA, to round exactly like the scalar kernels
+
+    /**
+     * \brief Helper function which adds an offset to packed vectors four at a time
+     */
+    WLUW_TARGET_AVX2 void addOffsetAVX2(double* xs, double* ys, int count, Vector2 offset)
+    {
+        __m256d ox = _mm256_set1_pd(offset.x);
+        __m256d oy = _mm256_set1_pd(offset.y);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm256_storeu_pd(xs + i, _mm256_add_pd(_mm256_loadu_pd(xs + i), ox));
+            _mm256_storeu_pd(ys + i, _mm256_add_pd(_mm256_loadu_pd(ys + i), oy));
+        }
+
+        // Leave AVX state before the SSE tail. GCC doesn't always do it before a call, and the switch is slow
+        _mm256_zeroupper();
+        addOffsetScalar(xs + i, ys + i, count - i, offset);
+    }
+
+    /**
+     * \brief Helper function which adds scaled packed vectors to others four at a time
+     */
+    WLUW_TARGET_AVX2 void addScaledAVX2(double* xs, double* ys, const double* otherX, const double* otherY, int count, double scale)
+    {
+        __m256d s = _mm256_set1_pd(scale);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm256_storeu_pd(xs + i, _mm256_add_pd(_mm256_loadu_pd(xs + i), _mm256_mul_pd(_mm256_loadu_pd(otherX + i), s)));
+            _mm256_storeu_pd(ys + i, _mm256_add_pd(_mm256_loadu_pd(ys + i), _mm256_mul_pd(_mm256_loadu_pd(otherY + i), s)));
+        }
+
+        _mm256_zeroupper();
+        addScaledScalar(xs + i, ys + i, otherX + i, otherY + i, count - i, scale);
+    }
+
+    /**
+     * \brief Helper function which multiplies packed vectors by a number four at a time
+     */
+    WLUW_TARGET_AVX2 void scaleAVX2(double* xs, double* ys, int count, double factor)
+    {
+        __m256d f = _mm256_set1_pd(factor);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm256_storeu_pd(xs + i, _mm256_mul_pd(_mm256_loadu_pd(xs + i), f));
+            _mm256_storeu_pd(ys + i, _mm256_mul_pd(_mm256_loadu_pd(ys + i), f));
+        }
+
+        _mm256_zeroupper();
+        scaleScalar(xs + i, ys + i, count - i, factor);
+    }
+
+    /**
+     * \brief Helper function which dots packed vectors with an axis four at a time
+     */
+    WLUW_TARGET_AVX2 void dotAVX2(const double* xs, const double* ys, int count, Vector2 axis, double* out)
+    {
+        __m256d ax = _mm256_set1_pd(axis.x);
+        __m256d ay = _mm256_set1_pd(axis.y);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(ax, _mm256_loadu_pd(xs + i)), _mm256_mul_pd(ay, _mm256_loadu_pd(ys + i))));
+
+        _mm256_zeroupper();
+        dotScalar(xs + i, ys + i, count - i, axis, out + i);
+    }
+
+    /**
+     * \brief Helper function which projects packed vectors onto an axis four at a time
+     */
+    WLUW_TARGET_AVX2 Proj projectAVX2(const double* xs, const double* ys, int count, Vector2 axis)
+    {
+        __m256d ax = _mm256_set1_pd(axis.x);
+        __m256d ay = _mm256_set1_pd(axis.y);
+        __m256d vmin = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+        __m256d vmax = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d p = _mm256_add_pd(_mm256_mul_pd(ax, _mm256_loadu_pd(xs + i)), _mm256_mul_pd(ay, _mm256_loadu_pd(ys + i)));
+            vmin = _mm256_min_pd(vmin, p);
+            vmax = _mm256_max_pd(vmax, p);
+        }
+
+        double mins[4], maxs[4];
+        _mm256_storeu_pd(mins, vmin);
+        _mm256_storeu_pd(maxs, vmax);
+
+        Proj result(std::min(std::min(mins[0], mins[1]), std::min(mins[2], mins[3])),
+            std::max(std::max(maxs[0], maxs[1]), std::max(maxs[2], maxs[3])));
+
+        if (i < count)
+        {
+            _mm256_zeroupper();
+            Proj rest = projectScalar(xs + i, ys + i, count - i, axis);
+            result.first = std::min(result.first, rest.first);
+            result.second = std::max(result.second, rest.second);
+        }
+
+        return result;
+    }
+
+    /**
+     * \brief Helper function which bounds packed vectors four at a time
+     */
+    WLUW_TARGET_AVX2 AABB boundsAVX2(const double* xs, const double* ys, int count)
+    {
+        __m256d minX = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+        __m256d minY = minX;
+        __m256d maxX = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+        __m256d maxY = maxX;
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d x = _mm256_loadu_pd(xs + i);
+            __m256d y = _mm256_loadu_pd(ys + i);
+            minX = _mm256_min_pd(minX, x);
+            minY = _mm256_min_pd(minY, y);
+            maxX = _mm256_max_pd(maxX, x);
+            maxY = _mm256_max_pd(maxY, y);
+        }
+
+        double lanes[4][4];
+        _mm256_storeu_pd(lanes[0], minX);
+        _mm256_storeu_pd(lanes[1], minY);
+        _mm256_storeu_pd(lanes[2], maxX);
+        _mm256_storeu_pd(lanes[3], maxY);
+
+        AABB result(
+            Vector2(std::min(std::min(lanes[0][0], lanes[0][1]), std::min(lanes[0][2], lanes[0][3])),
+                std::min(std::min(lanes[1][0], lanes[1][1]), std::min(lanes[1][2], lanes[1][3]))),
+            Vector2(std::max(std::max(lanes[2][0], lanes[2][1]), std::max(lanes[2][2], lanes[2][3])),
+                std::max(std::max(lanes[3][0], lanes[3][1]), std::max(lanes[3][2], lanes[3][3]))));
+
+        if (i < count)
+        {
+            _mm256_zeroupper();
+            result = AABB::combine(result, boundsScalar(xs + i, ys + i, count - i));
+        }
+
+        return result;
+    }
+
+    /**
+     * \brief Helper function which normalizes packed vectors four at a time
+     */
+    WLUW_TARGET_AVX2 void normalizeAVX2(double* xs, double* ys, int count)
+    {
+        __m256d zero = _mm256_setzero_pd();
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d x = _mm256_loadu_pd(xs + i);
+            __m256d y = _mm256_loadu_pd(ys + i);
+            __m256d length = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)));
+
+            __m256d nonZero = _mm256_cmp_pd(length, zero, _CMP_NEQ_UQ);
+            _mm256_storeu_pd(xs + i, _mm256_and_pd(nonZero, _mm256_div_pd(x, length)));
+            _mm256_storeu_pd(ys + i, _mm256_and_pd(nonZero, _mm256_div_pd(y, length)));
+        }
+
+        _mm256_zeroupper();
+        normalizeScalar(xs + i, ys + i, count - i);
+    }
+
+    /**
+     * \brief Helper function which applies an affine transform to packed vectors four at a time
+     */
+    WLUW_TARGET_AVX2 void transformAVX2(const double* sourceX, const double* sourceY, int count, Vector2 xAxis, Vector2 yAxis,
+        Vector2 translation, double* xs, double* ys)
+    {
+        __m256d m00 = _mm256_set1_pd(xAxis.x);
+        __m256d m10 = _mm256_set1_pd(xAxis.y);
+        __m256d m01 = _mm256_set1_pd(yAxis.x);
+        __m256d m11 = _mm256_set1_pd(yAxis.y);
+        __m256d tx = _mm256_set1_pd(translation.x);
+        __m256d ty = _mm256_set1_pd(translation.y);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d x = _mm256_loadu_pd(sourceX + i);
+            __m256d y = _mm256_loadu_pd(sourceY + i);
+            _mm256_storeu_pd(xs + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m00, x), _mm256_mul_pd(m01, y)), tx));
+            _mm256_storeu_pd(ys + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m10, x), _mm256_mul_pd(m11, y)), ty));
+        }
+
+        _mm256_zeroupper();
+        transformScalar(sourceX + i, sourceY + i, count - i, xAxis, yAxis, translation, xs + i, ys + i);
+    }
+
+    const Kernels avx2Kernels = { addOffsetAVX2, addScaledAVX2, scaleAVX2, dotAVX2, projectAVX2, boundsAVX2,
+        normalizeAVX2, transformAVX2 };
+#endif
+
+    /**
+     * \brief Helper function which picks the kernels for an instruction set
+     *
+     * \param level requested instruction set
+     * \return kernels for that set, or the scalar kernels if it isn't available in this build
+     */
+    const Kernels& selectKernels(SimdLevel level)
+    {
+#if WLUW_X86
+        if (level == SimdLevel::AVX2)
+            return avx2Kernels;
+        if (level == SimdLevel::SSE2)
+            return sse2Kernels;
+#endif
+        return scalarKernels;
+    }
+}
+
+WLUW::Vector2Array::Vector2Array(int count)
+    : xs(count, 0.0), ys(count, 0.0)
+{
+}
+
+void WLUW::Vector2Array::assign(const Vector2* vectors, int count)
+{
+    xs.resize(count);
+    ys.resize(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        xs[i] = vectors[i].x;
+        ys[i] = vectors[i].y;
+    }
+}
+
+void WLUW::Vector2Array::push_back(Vector2 v)
+{
+    xs.push_back(v.x);
+    ys.push_back(v.y);
+}
+
+void WLUW::Vector2Array::append(const Vector2Array& other)
+{
+    xs.insert(xs.end(), other.xs.begin(), other.xs.end());
+    ys.insert(ys.end(), other.ys.begin(), other.ys.end());
+}
+
+void WLUW::Vector2Array::resize(int count)
+{
+    xs.resize(count, 0.0);
+    ys.resize(count, 0.0);
+}
+
+void WLUW::Vector2Array::clear()
+{
+    xs.clear();
+    ys.clear();
+}
+
+void WLUW::Vector2Array::add(Vector2 offset, SimdLevel level)
+{
+    selectKernels(level).addOffset(xs.data(), ys.data(), size(), offset);
+}
+
+void WLUW::Vector2Array::add(const Vector2Array& other, double scale, SimdLevel level)
+{
+    if (other.size() != size())
+    {
+        throw("Arrays are different sizes");
+        return;
+    }
+
+    selectKernels(level).addScaled(xs.data(), ys.data(), other.xs.data(), other.ys.data(), size(), scale);
+}
+
+void WLUW::Vector2Array::scale(double factor, SimdLevel level)
+{
+    selectKernels(level).scale(xs.data(), ys.data(), size(), factor);
+}
+
+void WLUW::Vector2Array::dot(Vector2 axis, double* out, SimdLevel level) const
+{
+    selectKernels(level).dot(xs.data(), ys.data(), size(), axis, out);
+}
+
+Proj WLUW::Vector2Array::projectOntoAxis(Vector2 axis, SimdLevel level) const
+{
+    if (empty())
+    {
+        throw("Not enough points");
+        return Proj(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+    }
+
+    return selectKernels(level).project(xs.data(), ys.data(), size(), axis);
+}
+
+Proj WLUW::Vector2Array::projectOntoAxis(int first, int count, Vector2 axis, SimdLevel level) const
+{
+    return selectKernels(level).project(xs.data() + first, ys.data() + first, count, axis);
+}
+
+AABB WLUW::Vector2Array::getBounds(SimdLevel level) const
+{
+    if (empty())
+    {
+        throw("Not enough points");
+        return AABB();
+    }
+
+    return selectKernels(level).bounds(xs.data(), ys.data(), size());
+}
+
+void WLUW::Vector2Array::normalize(SimdLevel level)
+{
+    selectKernels(level).normalize(xs.data(), ys.data(), size());
+}
+
+void WLUW::Vector2Array::transform(const Vector2Array& source, Vector2 xAxis, Vector2 yAxis, Vector2 translation, SimdLevel level)
+{
+    resize(source.size());
+    selectKernels(level).transform(source.xs.data(), source.ys.data(), size(), xAxis, yAxis, translation, xs.data(), ys.data());
+}
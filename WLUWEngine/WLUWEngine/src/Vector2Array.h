@@ -0,0 +1,203 @@
+/*****************************************************************//**
+ * \file   Vector2Array.h
+ * \brief  Structure-of-arrays buffer of vectors with SIMD bulk operations
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "AABB.h"
+#include "CpuFeatures.h"
+#include "Vector2.h"
+
+namespace WLUW
+{
+	/**
+	 * \class Vector2Array Vector2Array.h
+	 * \brief Array of vectors stored as separate x and y arrays, so bulk operations load two or four components
+	 * per instruction instead of going through Vector2 one element at a time. Every operation takes the
+	 * instruction set to run with, defaulting to the best the CPU supports, and gives bit-identical results on
+	 * all of them because each lane uses the same operations in the same order as the Vector2 operators
+	 */
+	class Vector2Array
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor. Creates an empty array
+		 */
+		Vector2Array()
+		{
+		}
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param count number of zero vectors to start with
+		 */
+		explicit Vector2Array(int count);
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Replace the contents with a copy of some vectors
+		 *
+		 * \param vectors vectors to copy
+		 * \param count number of vectors
+		 */
+		void assign(const Vector2* vectors, int count);
+
+		/**
+		 * \brief Append a vector
+		 *
+		 * \param v vector to append
+		 */
+		void push_back(Vector2 v);
+
+		/**
+		 * \brief Append every vector of another array
+		 *
+		 * \param other vectors to append
+		 */
+		void append(const Vector2Array& other);
+
+		/**
+		 * \brief Change the number of vectors. New vectors are zero
+		 *
+		 * \param count new number of vectors
+		 */
+		void resize(int count);
+
+		/**
+		 * \brief Remove every vector. Buffers keep their capacity
+		 */
+		void clear();
+
+		/**
+		 * \brief Add an offset to every vector
+		 *
+		 * \param offset offset to add
+		 * \param level instruction set to use
+		 */
+		void add(Vector2 offset, SimdLevel level = getSimdLevel());
+
+		/**
+		 * \brief Add a scaled copy of another array element by element, such as velocities times a time step
+		 *
+		 * \param other array of the same size
+		 * \param scale multiplier applied to other first
+		 * \param level instruction set to use
+		 */
+		void add(const Vector2Array& other, double scale = 1.0, SimdLevel level = getSimdLevel());
+
+		/**
+		 * \brief Multiply every vector by a number
+		 *
+		 * \param factor multiplier
+		 * \param level instruction set to use
+		 */
+		void scale(double factor, SimdLevel level = getSimdLevel());
+
+		/**
+		 * \brief Dot every vector with an axis
+		 *
+		 * \param axis axis to dot with
+		 * \param out receives size() results
+		 * \param level instruction set to use
+		 */
+		void dot(Vector2 axis, double* out, SimdLevel level = getSimdLevel()) const;
+
+		/**
+		 * \brief Projects every vector onto an axis, the SAT projection of a polygon's points
+		 *
+		 * \param axis axis to project onto
+		 * \param level instruction set to use
+		 * \return min and max of the projection. Throws if the array is empty
+		 */
+		std::pair<double, double> projectOntoAxis(Vector2 axis, SimdLevel level = getSimdLevel()) const;
+
+		/**
+		 * \brief Projects a range of the vectors onto an axis, for arrays holding the points of many polygons
+		 *
+		 * \param first index of the first vector
+		 * \param count number of vectors, at least one
+		 * \param axis axis to project onto
+		 * \param level instruction set to use
+		 * \return min and max of the projection
+		 */
+		std::pair<double, double> projectOntoAxis(int first, int count, Vector2 axis, SimdLevel level = getSimdLevel()) const;
+
+		/**
+		 * \brief Finds the smallest box containing every vector
+		 *
+		 * \param level instruction set to use
+		 * \return bounding box. Throws if the array is empty
+		 */
+		AABB getBounds(SimdLevel level = getSimdLevel()) const;
+
+		/**
+		 * \brief Scale every vector to unit length. Zero vectors stay zero, as with Vector2::fastNormalize
+		 *
+		 * \param level instruction set to use
+		 */
+		void normalize(SimdLevel level = getSimdLevel());
+
+		/**
+		 * \brief Overwrite this array with an affine transform of another, xAxis * v.x + yAxis * v.y + translation
+		 * for each vector v. A rotation by angle a uses xAxis (cos a, sin a) and yAxis (-sin a, cos a)
+		 *
+		 * \param source vectors to transform, may be this array
+		 * \param xAxis image of the x axis
+		 * \param yAxis image of the y axis
+		 * \param translation offset added last
+		 * \param level instruction set to use
+		 */
+		void transform(const Vector2Array& source, Vector2 xAxis, Vector2 yAxis, Vector2 translation, SimdLevel level = getSimdLevel());
+
+		/////////////////////
+		//// Getters/Setters
+		/////////////////////
+
+		/**\return number of vectors */
+		int size() const { return static_cast<int>(xs.size()); };
+
+		/**\return true if there are no vectors */
+		bool empty() const { return xs.empty(); };
+
+		/**\return vector at an index */
+		Vector2 get(int index) const { return Vector2(xs[index], ys[index]); };
+
+		/**\return vector at an index, so the array can stand in for a Vector2 pointer in templated code */
+		Vector2 operator[](int index) const { return get(index); };
+
+		/**\brief Overwrite the vector at an index */
+		void set(int index, Vector2 v) { xs[index] = v.x; ys[index] = v.y; };
+
+		/**\return x components, size() long */
+		double* getX() { return xs.data(); };
+		const double* getX() const { return xs.data(); };
+
+		/**\return y components, size() long */
+		double* getY() { return ys.data(); };
+		const double* getY() const { return ys.data(); };
+
+		friend bool operator==(const Vector2Array& a, const Vector2Array& b)
+		{
+			return a.xs == b.xs && a.ys == b.ys;
+		}
+
+	private:
+		std::vector<double> xs;	/* x component of every vector */
+		std::vector<double> ys;	/* y component of every vector */
+	};
+}
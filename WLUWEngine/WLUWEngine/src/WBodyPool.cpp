@@ -0,0 +1,359 @@
+/*****************************************************************//**
+ * \file   WBodyPool.cpp
+ * \brief  Implementation of the rigid body pool and its integration kernels
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "WBodyPool.h"
+
+#if WLUW_X86
+#include <immintrin.h>
+#endif
+
+using namespace WLUW;
+
+// Aliases
+using VelocityFunction = void(*)(double*, double*, const double*, const double*, double, double, int);
+using PositionFunction = void(*)(double*, const double*, double, int);
+
+namespace
+{
+    /**
+     * \brief Helper function which updates one velocity component of many bodies one at a time
+     *
+     * \param velocity velocities, updated
+     * \param force accumulated forces, cleared
+     * \param inverseMass 1 / mass of each body
+     * \param gravityScale multiplier on gravity for each body
+     * \param gravity gravity along this component
+     * \param deltaTime time step
+     * \param count number of bodies
+     */
+    void velocityScalar(double* velocity, double* force, const double* inverseMass, const double* gravityScale,
+        double gravity, double deltaTime, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            velocity[i] = velocity[i] + (gravity * gravityScale[i] + force[i] * inverseMass[i]) * deltaTime;
+            force[i] = 0.0;
+        }
+    }
+
+    /**
+     * \brief Helper function which updates one position component of many bodies one at a time
+     *
+     * \param position positions, updated
+     * \param velocity velocities
+     * \param deltaTime time step
+     * \param count number of bodies
+     */
+    void positionScalar(double* position, const double* velocity, double deltaTime, int count)
+    {
+        for (int i = 0; i < count; i++)
+            position[i] = position[i] + velocity[i] * deltaTime;
+    }
+
+#if WLUW_X86
+    /**
+     * \brief Helper function which updates one velocity component of many bodies two at a time
+     */
+    void velocitySSE2(double* velocity, double* force, const double* inverseMass, const double* gravityScale,
+        double gravity, double deltaTime, int count)
+    {
+        __m128d g = _mm_set1_pd(gravity);
+        __m128d dt = _mm_set1_pd(deltaTime);
+        __m128d zero = _mm_setzero_pd();
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            // Same order of operations as the scalar loop so results match exactly
+            __m128d acceleration = _mm_add_pd(_mm_mul_pd(g, _mm_loadu_pd(gravityScale + i)), _mm_mul_pd(_mm_loadu_pd(force + i), _mm_loadu_pd(inverseMass + i)));
+            _mm_storeu_pd(velocity + i, _mm_add_pd(_mm_loadu_pd(velocity + i), _mm_mul_pd(acceleration, dt)));
+            _mm_storeu_pd(force + i, zero);
+        }
+
+        velocityScalar(velocity + i, force + i, inverseMass + i, gravityScale + i, gravity, deltaTime, count - i);
+    }
+
+    /**
+     * \brief Helper function which updates one position component of many bodies two at a time
+     */
+    void positionSSE2(double* position, const double* velocity, double deltaTime, int count)
+    {
+        __m128d dt = _mm_set1_pd(deltaTime);
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+            _mm_storeu_pd(position + i, _mm_add_pd(_mm_loadu_pd(position + i), _mm_mul_pd(_mm_loadu_pd(velocity + i), dt)));
+
+        positionScalar(position + i, velocity + i, deltaTime, count - i);
+    }
+
+    /**
+     * \brief Helper function which updates one velocity component of many bodies four at a time
+     */
+    WLUW_TARGET_AVX2 void velocityAVX2(double* velocity, double* force, const double* inverseMass, const double* gravityScale,
+        double gravity, double deltaTime, int count)
+    {
+        __m256d g = _mm256_set1_pd(gravity);
+        __m256d dt = _mm256_set1_pd(deltaTime);
+        __m256d zero = _mm256_setzero_pd();
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // Separate multiply and add rather than FMA, to round exactly like the scalar loop
+            __m256d acceleration = _mm256_add_pd(_mm256_mul_pd(g, _mm256_loadu_pd(gravityScale + i)), _mm256_mul_pd(_mm256_loadu_pd(force + i), _mm256_loadu_pd(inverseMass + i)));
+            _mm256_storeu_pd(velocity + i, _mm256_add_pd(_mm256_loadu_pd(velocity + i), _mm256_mul_pd(acceleration, dt)));
+            _mm256_storeu_pd(force + i, zero);
+        }
+
+        velocityScalar(velocity + i, force + i, inverseMass + i, gravityScale + i, gravity, deltaTime, count - i);
+    }
+
+    /**
+     * \brief Helper function which updates one position component of many bodies four at a time
+     */
+    WLUW_TARGET_AVX2 void positionAVX2(double* position, const double* velocity, double deltaTime, int count)
+    {
+        __m256d dt = _mm256_set1_pd(deltaTime);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm256_storeu_pd(position + i, _mm256_add_pd(_mm256_loadu_pd(position + i), _mm256_mul_pd(_mm256_loadu_pd(velocity + i), dt)));
+
+        positionScalar(position + i, velocity + i, deltaTime, count - i);
+    }
+#endif
+
+    /**
+     * \brief Helper function which picks the velocity kernel for an instruction set
+     *
+     * \param level requested instruction set
+     * \return kernel for that set, or the scalar kernel if it isn't available in this build
+     */
+    VelocityFunction selectVelocity(SimdLevel level)
+    {
+#if WLUW_X86
+        if (level == SimdLevel::AVX2)
+            return velocityAVX2;
+        if (level == SimdLevel::SSE2)
+            return velocitySSE2;
+#endif
+        return velocityScalar;
+    }
+
+    /**
+     * \brief Helper function which picks the position kernel for an instruction set
+     *
+     * \param level requested instruction set
+     * \return kernel for that set, or the scalar kernel if it isn't available in this build
+     */
+    PositionFunction selectPosition(SimdLevel level)
+    {
+#if WLUW_X86
+        if (level == SimdLevel::AVX2)
+            return positionAVX2;
+        if (level == SimdLevel::SSE2)
+            return positionSSE2;
+#endif
+        return positionScalar;
+    }
+}
+
+int WLUW::WBodyPool::createBody(double inverseMass, double inverseInertia, Vector2 position, double angle, Vector2 velocity, double angularVelocity)
+{
+    int handle;
+    if (!freeHandles.empty())
+    {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    else
+    {
+        handle = static_cast<int>(handleToIndex.size());
+        handleToIndex.push_back(-1);
+    }
+
+    handleToIndex[handle] = size();
+    handles.push_back(handle);
+
+    this->positionX.push_back(position.x);
+    this->positionY.push_back(position.y);
+    this->angle.push_back(angle);
+    this->velocityX.push_back(velocity.x);
+    this->velocityY.push_back(velocity.y);
+    this->angularVelocity.push_back(angularVelocity);
+    this->forceX.push_back(0.0);
+    this->forceY.push_back(0.0);
+    this->torque.push_back(0.0);
+    this->inverseMass.push_back(inverseMass);
+    this->inverseInertia.push_back(inverseInertia);
+    this->gravityScale.push_back(inverseMass > 0.0 ? 1.0 : 0.0);
+    this->sleepTime.push_back(0.0);
+    this->previousX.push_back(position.x);
+    this->previousY.push_back(position.y);
+    this->previousAngle.push_back(angle);
+
+    // New bodies start awake, move the new body to the end of the awake range
+    swapBodies(size() - 1, awakeCount);
+    awakeCount++;
+
+    return handle;
+}
+
+void WLUW::WBodyPool::destroyBody(int handle)
+{
+    if (handle < 0 || handle >= handleToIndex.size() || handleToIndex[handle] == -1)
+    {
+        throw("Invalid body");
+        return;
+    }
+
+    // Move the body out of the awake range, then swap the last body into the hole and drop the last slot
+    setAwake(handle, false);
+    swapBodies(handleToIndex[handle], size() - 1);
+
+    positionX.pop_back();
+    positionY.pop_back();
+    angle.pop_back();
+    velocityX.pop_back();
+    velocityY.pop_back();
+    angularVelocity.pop_back();
+    forceX.pop_back();
+    forceY.pop_back();
+    torque.pop_back();
+    inverseMass.pop_back();
+    inverseInertia.pop_back();
+    gravityScale.pop_back();
+    sleepTime.pop_back();
+    previousX.pop_back();
+    previousY.pop_back();
+    previousAngle.pop_back();
+    handles.pop_back();
+
+    handleToIndex[handle] = -1;
+    freeHandles.push_back(handle);
+}
+
+void WLUW::WBodyPool::swapBodies(int indexA, int indexB)
+{
+    if (indexA == indexB)
+        return;
+
+    std::swap(positionX[indexA], positionX[indexB]);
+    std::swap(positionY[indexA], positionY[indexB]);
+    std::swap(angle[indexA], angle[indexB]);
+    std::swap(velocityX[indexA], velocityX[indexB]);
+    std::swap(velocityY[indexA], velocityY[indexB]);
+    std::swap(angularVelocity[indexA], angularVelocity[indexB]);
+    std::swap(forceX[indexA], forceX[indexB]);
+    std::swap(forceY[indexA], forceY[indexB]);
+    std::swap(torque[indexA], torque[indexB]);
+    std::swap(inverseMass[indexA], inverseMass[indexB]);
+    std::swap(inverseInertia[indexA], inverseInertia[indexB]);
+    std::swap(gravityScale[indexA], gravityScale[indexB]);
+    std::swap(sleepTime[indexA], sleepTime[indexB]);
+    std::swap(previousX[indexA], previousX[indexB]);
+    std::swap(previousY[indexA], previousY[indexB]);
+    std::swap(previousAngle[indexA], previousAngle[indexB]);
+    std::swap(handles[indexA], handles[indexB]);
+
+    handleToIndex[handles[indexA]] = indexA;
+    handleToIndex[handles[indexB]] = indexB;
+}
+
+void WLUW::WBodyPool::setAwake(int handle, bool awake)
+{
+    int index = handleToIndex[handle];
+
+    if (awake)
+    {
+        sleepTime[index] = 0.0;
+        if (index < awakeCount)
+            return;
+
+        swapBodies(index, awakeCount);
+        awakeCount++;
+        return;
+    }
+
+    if (index >= awakeCount)
+        return;
+
+    velocityX[index] = 0.0;
+    velocityY[index] = 0.0;
+    angularVelocity[index] = 0.0;
+    forceX[index] = 0.0;
+    forceY[index] = 0.0;
+    torque[index] = 0.0;
+
+    // Sleeping bodies aren't saved each step, so they have to render where they stopped
+    previousX[index] = positionX[index];
+    previousY[index] = positionY[index];
+    previousAngle[index] = angle[index];
+
+    awakeCount--;
+    swapBodies(index, awakeCount);
+}
+
+void WLUW::WBodyPool::savePreviousState(int count)
+{
+    if (count < 0)
+        count = size();
+
+    std::copy(positionX.begin(), positionX.begin() + count, previousX.begin());
+    std::copy(positionY.begin(), positionY.begin() + count, previousY.begin());
+    std::copy(angle.begin(), angle.begin() + count, previousAngle.begin());
+}
+
+WLUW::Vector2 WLUW::WBodyPool::getInterpolatedPosition(int handle, double alpha) const
+{
+    int index = handleToIndex[handle];
+    return Vector2(previousX[index] + (positionX[index] - previousX[index]) * alpha,
+        previousY[index] + (positionY[index] - previousY[index]) * alpha);
+}
+
+double WLUW::WBodyPool::getInterpolatedAngle(int handle, double alpha) const
+{
+    int index = handleToIndex[handle];
+    return previousAngle[index] + (angle[index] - previousAngle[index]) * alpha;
+}
+
+void WLUW::WBodyPool::integrate(double deltaTime, Vector2 gravity, int count, SimdLevel level)
+{
+    integrateVelocities(deltaTime, gravity, count, level);
+    integratePositions(deltaTime, count, level);
+}
+
+void WLUW::WBodyPool::integrateVelocities(double deltaTime, Vector2 gravity, int count, SimdLevel level)
+{
+    if (count < 0 || count > size())
+        count = size();
+
+    VelocityFunction integrateVelocity = selectVelocity(level);
+
+    // Each component is independent, so run the same kernel over x, y and rotation
+    integrateVelocity(velocityX.data(), forceX.data(), inverseMass.data(), gravityScale.data(), gravity.x, deltaTime, count);
+    integrateVelocity(velocityY.data(), forceY.data(), inverseMass.data(), gravityScale.data(), gravity.y, deltaTime, count);
+    integrateVelocity(angularVelocity.data(), torque.data(), inverseInertia.data(), gravityScale.data(), 0.0, deltaTime, count);
+}
+
+void WLUW::WBodyPool::integratePositions(double deltaTime, int count, SimdLevel level)
+{
+    if (count < 0 || count > size())
+        count = size();
+
+    PositionFunction integratePosition = selectPosition(level);
+
+    integratePosition(positionX.data(), velocityX.data(), deltaTime, count);
+    integratePosition(positionY.data(), velocityY.data(), deltaTime, count);
+    integratePosition(angle.data(), angularVelocity.data(), deltaTime, count);
+}
@@ -0,0 +1,170 @@
+/*****************************************************************//**
+ * \file   WBodyPool.h
+ * \brief  Structure-of-arrays storage for rigid body state
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "Vector2.h"
+
+namespace WLUW
+{
+	/**
+	 * \class WBodyPool WBodyPool.h
+	 * \brief Holds the state of every rigid body in a world as one array per field, so integration is a few
+	 * straight loops over contiguous doubles. Bodies are packed densely and may be reordered, so each body is
+	 * referred to by a handle which stays valid until the body is destroyed. The arrays are indexed by dense index,
+	 * use getIndex to convert a handle. Awake bodies are kept in front of sleeping ones, so passing
+	 * getAwakeCount to the integrators skips every sleeping body
+	 */
+	class WBodyPool
+	{
+	public:
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Add a body to the pool
+		 *
+		 * \param inverseMass 1 / mass, 0 for a body which can't be moved by forces
+		 * \param inverseInertia 1 / moment of inertia, 0 for a body which can't be rotated by torques
+		 * \param position starting position
+		 * \param angle starting rotation in radians
+		 * \param velocity starting linear velocity
+		 * \param angularVelocity starting angular velocity in radians per second
+		 * \return handle of the new body
+		 */
+		int createBody(double inverseMass, double inverseInertia, Vector2 position, double angle, Vector2 velocity, double angularVelocity);
+
+		/**
+		 * \brief Remove a body. Bodies are moved around to close the gap
+		 *
+		 * \param handle handle of the body to remove
+		 */
+		void destroyBody(int handle);
+
+		/**
+		 * \brief Swap two bodies in the dense arrays. Handles keep pointing at the same bodies
+		 *
+		 * \param indexA dense index of the first body
+		 * \param indexB dense index of the second body
+		 */
+		void swapBodies(int indexA, int indexB);
+
+		/**
+		 * \brief Wake a body up or put it to sleep. Sleeping bodies have their velocities and forces cleared,
+		 * woken bodies have their sleep timer reset
+		 *
+		 * \param handle handle of the body
+		 * \param awake whether the body should be awake
+		 */
+		void setAwake(int handle, bool awake);
+
+		/**
+		 * \brief Advance bodies with semi-implicit Euler. Velocities are updated from the accumulated forces and
+		 * gravity first, then positions from the new velocities. Forces are cleared afterwards
+		 *
+		 * \param deltaTime time step
+		 * \param gravity acceleration applied to every body, scaled by its gravity scale
+		 * \param count number of bodies to integrate, starting from dense index 0. -1 for all of them
+		 * \param level instruction set to use, defaults to the best the CPU supports
+		 */
+		void integrate(double deltaTime, Vector2 gravity, int count = -1, SimdLevel level = getSimdLevel());
+
+		/**
+		 * \brief First half of integrate. Updates velocities from forces and gravity, then clears the forces.
+		 * Constraint solvers run between the two halves
+		 *
+		 * \param deltaTime time step
+		 * \param gravity acceleration applied to every body, scaled by its gravity scale
+		 * \param count number of bodies to integrate, starting from dense index 0. -1 for all of them
+		 * \param level instruction set to use, defaults to the best the CPU supports
+		 */
+		void integrateVelocities(double deltaTime, Vector2 gravity, int count = -1, SimdLevel level = getSimdLevel());
+
+		/**
+		 * \brief Second half of integrate. Moves bodies by their velocities
+		 *
+		 * \param deltaTime time step
+		 * \param count number of bodies to integrate, starting from dense index 0. -1 for all of them
+		 * \param level instruction set to use, defaults to the best the CPU supports
+		 */
+		void integratePositions(double deltaTime, int count = -1, SimdLevel level = getSimdLevel());
+
+		/**
+		 * \brief Remember the current positions and angles as the previous state, which rendering interpolates from.
+		 * Call it at the start of each fixed step
+		 *
+		 * \param count number of bodies to save, starting from dense index 0. -1 for all of them
+		 */
+		void savePreviousState(int count = -1);
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**
+		 * \param handle handle of the body
+		 * \param alpha fraction of a step since the last one, 0 gives the previous state and 1 the current one
+		 * \return position blended between the previous and current state
+		 */
+		Vector2 getInterpolatedPosition(int handle, double alpha) const;
+
+		/**
+		 * \param handle handle of the body
+		 * \param alpha fraction of a step since the last one, 0 gives the previous state and 1 the current one
+		 * \return angle blended between the previous and current state
+		 */
+		double getInterpolatedAngle(int handle, double alpha) const;
+
+		/**\return number of bodies */
+		int size() const { return static_cast<int>(handles.size()); };
+
+		/**\return number of awake bodies. They occupy dense indices 0 to getAwakeCount() - 1 */
+		int getAwakeCount() const { return awakeCount; };
+
+		/**\return true if a body is awake */
+		bool isAwake(int handle) const { return handleToIndex[handle] < awakeCount; };
+
+		/**\return dense index of a body */
+		int getIndex(int handle) const { return handleToIndex[handle]; };
+
+		/**\return handle of the body at a dense index */
+		int getHandle(int index) const { return handles[index]; };
+
+		/////////////////////
+		//// Body State
+		/////////////////////
+
+		// One entry per body, indexed by dense index
+		std::vector<double> positionX;			/* Position x */
+		std::vector<double> positionY;			/* Position y */
+		std::vector<double> angle;				/* Rotation in radians */
+		std::vector<double> velocityX;			/* Linear velocity x */
+		std::vector<double> velocityY;			/* Linear velocity y */
+		std::vector<double> angularVelocity;	/* Angular velocity in radians per second */
+		std::vector<double> forceX;				/* Force accumulated since the last step, x */
+		std::vector<double> forceY;				/* Force accumulated since the last step, y */
+		std::vector<double> torque;				/* Torque accumulated since the last step */
+		std::vector<double> inverseMass;		/* 1 / mass, 0 for static bodies */
+		std::vector<double> inverseInertia;		/* 1 / moment of inertia, 0 for bodies which don't rotate */
+		std::vector<double> gravityScale;		/* Multiplier on the world gravity, 0 for static bodies */
+		std::vector<double> sleepTime;			/* Time the body has spent moving slowly enough to sleep */
+		std::vector<double> previousX;			/* Position x at the start of the last step */
+		std::vector<double> previousY;			/* Position y at the start of the last step */
+		std::vector<double> previousAngle;		/* Rotation at the start of the last step */
+
+	private:
+		std::vector<int> handles;				/* Handle of the body at each dense index */
+		std::vector<int> handleToIndex;			/* Dense index of each handle, -1 if unused */
+		std::vector<int> freeHandles;			/* Handles which can be reused */
+		int awakeCount = 0;						/* Number of awake bodies at the front of the arrays */
+	};
+}
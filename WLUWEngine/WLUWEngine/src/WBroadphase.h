@@ -0,0 +1,168 @@
+/*****************************************************************//**
+ * \file   WBroadphase.h
+ * \brief  Interface shared by every broadphase strategy used by WWorld
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "AABB.h"
+#include "RayCast.h"
+#include "Vector2.h"
+
+#ifndef WLUW_COLLISION_BITS_64
+#define WLUW_COLLISION_BITS_64 0
+#endif
+
+namespace WLUW
+{
+	/* Pair of user IDs whose bounding boxes overlap. first is always less than second */
+	using BroadphasePair = std::pair<int, int>;
+
+	/* Called with the user ID of a proxy a ray reached and the ray's current maximum distance. Returns the new
+	 * maximum distance: the hit distance to clip the ray, the value passed in to ignore the proxy, 0 to stop */
+	using RayCastCallback = std::function<double(int userId, double maxDistance)>;
+
+	/* Same as RayCastCallback, with the index of the ray in the batch first */
+	using RayCastBatchCallback = std::function<double(int rayIndex, int userId, double maxDistance)>;
+
+	/* One bit per collision layer. Define WLUW_COLLISION_BITS_64 as 1 for 64 layers rather than 32 */
+#if WLUW_COLLISION_BITS_64
+	using CollisionBits = std::uint64_t;
+#else
+	using CollisionBits = std::uint32_t;
+#endif
+
+	/**
+	 * \struct CollisionFilter
+	 * \brief Which layers a collider is on and which layers it collides with. Two colliders are only paired
+	 * when each one's category shares a bit with the other's mask
+	 */
+	struct CollisionFilter
+	{
+		CollisionBits category = 1;				/* Layers the collider is on */
+		CollisionBits mask = ~CollisionBits(0);	/* Layers the collider collides with */
+
+		/**\return true if the two filters allow a pair */
+		bool collidesWith(const CollisionFilter& other) const
+		{
+			return (category & other.mask) != 0 && (other.category & mask) != 0;
+		}
+	};
+
+	/**
+	 * \class WBroadphase WBroadphase.h
+	 * \brief Abstract broadphase. Tracks one proxy per collider and reports which proxies may be colliding,
+	 * so the narrowphase only runs on pairs whose bounding boxes overlap.
+	 */
+	class WBroadphase
+	{
+	public:
+		virtual ~WBroadphase() {}
+
+		/**
+		 * \brief Create a proxy for a collider
+		 *
+		 * \param aabb tight bounding box of the collider
+		 * \param userId ID reported back in pairs and queries, usually the WObject ID
+		 * \return proxy ID used to move or destroy the proxy
+		 */
+		virtual int createProxy(const AABB& aabb, int userId) = 0;
+
+		/**
+		 * \brief Destroy a proxy
+		 *
+		 * \param proxyId proxy to destroy
+		 */
+		virtual void destroyProxy(int proxyId) = 0;
+
+		/**
+		 * \brief Update the bounding box of a proxy after its collider moved
+		 *
+		 * \param proxyId proxy to move
+		 * \param aabb new tight bounding box of the collider
+		 * \param displacement how far the collider moved since the last update
+		 */
+		virtual void moveProxy(int proxyId, const AABB& aabb, Vector2 displacement) = 0;
+
+		/**
+		 * \brief Find every pair of proxies whose bounding boxes overlap
+		 *
+		 * \param pairs cleared, then filled with the user IDs of each overlapping pair
+		 */
+		virtual void findPairs(std::vector<BroadphasePair>& pairs) = 0;
+
+		/**
+		 * \brief Mark a proxy as asleep or awake. Proxies start awake. Pairs where both proxies are asleep are
+		 * not reported, so resting colliders only cost something in findPairs when an awake proxy overlaps them
+		 *
+		 * \param proxyId proxy to change
+		 * \param awake whether the proxy is awake
+		 */
+		virtual void setProxyAwake(int proxyId, bool awake) = 0;
+
+		/**
+		 * \brief Set the collision filter of a proxy. Proxies start with the default filter, which collides with
+		 * everything. Pairs the filters reject are never reported
+		 *
+		 * \param proxyId proxy to change
+		 * \param filter new filter
+		 */
+		virtual void setProxyFilter(int proxyId, const CollisionFilter& filter) = 0;
+
+		/**
+		 * \brief Report every proxy whose bounding box overlaps a box
+		 *
+		 * \param aabb box to query
+		 * \param callback called with the user ID of each proxy found. Return false to stop the query
+		 */
+		virtual void query(const AABB& aabb, const std::function<bool(int)>& callback) const = 0;
+
+		/**
+		 * \brief Report every proxy whose bounding box a ray passes through. The default searches the box around
+		 * the whole ray, broadphases with a hierarchy override it to skip whatever lies beyond the clipped ray
+		 *
+		 * \param ray ray to cast
+		 * \param callback called with each proxy found, returns the new maximum distance of the ray
+		 */
+		virtual void rayCast(const Ray& ray, const RayCastCallback& callback) const
+		{
+			double maxDistance = ray.maxDistance;
+			Vector2 end = ray.pointAt(maxDistance);
+			AABB bounds(Vector2(std::min(ray.origin.x, end.x), std::min(ray.origin.y, end.y)),
+				Vector2(std::max(ray.origin.x, end.x), std::max(ray.origin.y, end.y)));
+
+			query(bounds, [&](int userId) {
+				maxDistance = callback(userId, maxDistance);
+				return maxDistance > 0.0;
+			});
+		}
+
+		/**
+		 * \brief Cast many rays at once. The default casts them one at a time, broadphases with a hierarchy
+		 * override it to walk the hierarchy once for the whole batch
+		 *
+		 * \param rays rays to cast
+		 * \param callback called with each ray and proxy found, returns the new maximum distance of that ray
+		 */
+		virtual void rayCastBatch(const std::vector<Ray>& rays, const RayCastBatchCallback& callback) const
+		{
+			for (int i = 0; i < rays.size(); i++)
+				rayCast(rays[i], [&](int userId, double maxDistance) { return callback(i, userId, maxDistance); });
+		}
+
+		/**
+		 * \param proxyId proxy to look up
+		 * \return user ID the proxy was created with
+		 */
+		virtual int getUserId(int proxyId) const = 0;
+	};
+}
@@ -0,0 +1,190 @@
+/*****************************************************************//**
+ * \file   WCollider.h
+ * \brief  Component which gives a WObject a collision shape
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include "CompoundShape.h"
+#include "RayCast.h"
+#include "Shape.h"
+#include "WBroadphase.h"
+#include "WComponentBase.h"
+
+namespace WLUW
+{
+	/**
+	 * \class WCollider WCollider.h
+	 * \brief Collision component. WWorld registers the shape of every object with a collider in its broadphase.
+	 * The shape is either a single convex Shape or a CompoundShape made of several, and the placement and query
+	 * methods here work the same for both
+	 */
+	class WCollider : public WComponent<WCollider>
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param shape collision shape of the object
+		 */
+		WCollider(const Shape& shape) : shape(shape)
+		{
+		}
+
+		/**
+		 * \brief Constructor for a collider made of several convex shapes
+		 *
+		 * \param compound collision shape of the object
+		 */
+		WCollider(const CompoundShape& compound) : compound(std::make_unique<CompoundShape>(compound))
+		{
+		}
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Finds where a ray first hits the collider
+		 *
+		 * \param ray ray to cast, its direction must be unit length
+		 * \param hit set to the point, outward normal and distance of the hit. The ID is left alone
+		 * \return true if the ray hits within its maximum distance
+		 */
+		bool raycast(const Ray& ray, RayHit& hit) const { return compound ? compound->raycast(ray, hit) >= 0 : shape.raycast(ray, hit); };
+
+		/**
+		 * \brief Checks if a point lies inside the collider
+		 *
+		 * \param point world-space point
+		 * \return true if the collider contains the point
+		 */
+		bool containsPoint(Vector2 point) const { return compound ? compound->containsPoint(point) : shape.containsPoint(point); };
+
+		/**
+		 * \brief Move the collider
+		 *
+		 * \param position new position
+		 */
+		void setPosition(Vector2 position)
+		{
+			if (compound)
+				compound->setPosition(position);
+			else
+				shape.setPosition(position);
+		}
+
+		/**
+		 * \brief Rotate the collider about its local origin
+		 *
+		 * \param angle rotation in radians, counter-clockwise
+		 */
+		void setRotation(double angle)
+		{
+			if (compound)
+				compound->setRotation(angle);
+			else
+				shape.setRotation(angle);
+		}
+
+		/////////////////////
+		//// Getters/Setters
+		/////////////////////
+
+		/**\return collision shape. Unused by compound colliders, see getCompound */
+		Shape& getShape() { return shape; };
+
+		/**\return collision shape. Unused by compound colliders, see getCompound */
+		const Shape& getShape() const { return shape; };
+
+		/**\return true if the collider is a compound shape */
+		bool isCompound() const { return compound != nullptr; };
+
+		/**\return compound shape, null if the collider is a single shape */
+		CompoundShape* getCompound() { return compound.get(); };
+
+		/**\return compound shape, null if the collider is a single shape */
+		const CompoundShape* getCompound() const { return compound.get(); };
+
+		/**\return position of the collider */
+		Vector2 getPosition() const { return compound ? compound->getPosition() : shape.getPosition(); };
+
+		/**\return transform placing the collider in the world */
+		Transform2D const& getTransform() const { return compound ? compound->getTransform() : shape.getTransform(); };
+
+		/**\return smallest axis-aligned box containing the collider, in world space */
+		AABB const& getBoundingBox() const { return compound ? compound->getBoundingBox() : shape.getBoundingBox(); };
+
+		/**\return broadphase proxy ID, -1 if not in a world */
+		int getProxyId() const { return proxyId; };
+
+		/**
+		 * \brief Set the broadphase proxy ID. Called by WWorld
+		 *
+		 * \param id proxy ID
+		 */
+		void setProxyId(int id) { proxyId = id; };
+
+		/**\return true if the collider is swept each update instead of only tested where it ends up */
+		bool isContinuous() const { return continuous; };
+
+		/**
+		 * \brief Turn continuous collision detection on or off. Sweeping costs extra, so only flag small fast
+		 * objects such as projectiles which could otherwise pass straight through thin shapes in one update.
+		 * Compound colliders are never swept, though single shapes are swept against them
+		 *
+		 * \param enabled whether to sweep the collider
+		 */
+		void setContinuous(bool enabled) { continuous = enabled; };
+
+		/**\return friction coefficient */
+		double getFriction() const { return friction; };
+
+		/**
+		 * \brief Set the friction coefficient. Touching colliders use the geometric mean of their coefficients
+		 *
+		 * \param coefficient friction coefficient, 0 for frictionless
+		 */
+		void setFriction(double coefficient) { friction = coefficient; };
+
+		/**\return collision layers of the collider */
+		const CollisionFilter& getFilter() const { return filter; };
+
+		/**
+		 * \brief Set the collision layers of the collider. Only read when the collider is added to a world, use
+		 * WWorld::setCollisionFilter to change the layers of a collider which is already in one
+		 *
+		 * \param newFilter layers the collider is on and collides with
+		 */
+		void setFilter(const CollisionFilter& newFilter) { filter = newFilter; };
+
+		/**\return true if the collider only reports overlaps */
+		bool isSensor() const { return sensor; };
+
+		/**
+		 * \brief Turn the collider into a sensor. Sensors report what overlaps them through WWorld's sensor
+		 * events, but nothing is ever pushed out of them. Sensors don't detect each other
+		 *
+		 * \param enabled whether the collider is a sensor
+		 */
+		void setSensor(bool enabled) { sensor = enabled; };
+
+	private:
+		Shape shape;								/* Collision shape */
+		std::unique_ptr<CompoundShape> compound;	/* Compound collision shape, used instead of shape if set */
+		int proxyId = -1;							/* Broadphase proxy owned by the world */
+		bool continuous = false;					/* Whether the collider is swept */
+		bool sensor = false;						/* Whether the collider only reports overlaps */
+		double friction = 0.3;						/* Friction coefficient */
+		CollisionFilter filter;						/* Collision layers */
+	};
+}
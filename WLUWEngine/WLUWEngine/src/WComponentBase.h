@@ -12,6 +12,12 @@
 
 namespace WLUW
 {
+	/**
+	* \struct ComponentTag WComponentBase.h
+	* \brief Tag giving component classes a TypeIdManager counter of their own, apart from the one used for other classes
+	*/
+	struct ComponentTag;
+
 	/**
 	* \class WComponentBase WComponentBase.h
 	* \brief Abstract parent ComponentBase class for all components
@@ -19,14 +25,11 @@ namespace WLUW
 	class WComponentBase
 	{
 	private:
-		static int id;	/* Unique ID for each component class */
-		TypeIdManager<WComponentBase> idManager;
+		int id;	/* Unique ID of the component class */
 
 	protected:
-		WComponentBase()
+		WComponentBase(int id) : id(id)
 		{
-			if (id == 0)
-				id = idManager.getClassUniqueID<decltype(this)>();
 		};
 
 	public:
@@ -35,12 +38,31 @@ namespace WLUW
 		//////////////
 		//// Methods
 		//////////////
-		
+
 		int getComponentId() { return id; }
 	};
 
 	inline WComponentBase::~WComponentBase() {}
 
-	int WComponentBase::id = 0;
+	/**
+	* \class WComponent WComponentBase.h
+	* \tparam T Component class deriving from this
+	* \brief Parent class for components which gives each component class its own unique ID
+	*/
+	template<class T>
+	class WComponent : public WComponentBase
+	{
+	protected:
+		WComponent() : WComponentBase(getStaticComponentId())
+		{
+		};
+
+	public:
+		/**\return ID shared by every component of type T */
+		static int getStaticComponentId()
+		{
+			return TypeIdManager<ComponentTag>::getClassUniqueID<T>();
+		}
+	};
 }
 
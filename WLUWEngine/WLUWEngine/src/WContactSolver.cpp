@@ -0,0 +1,357 @@
+/*****************************************************************//**
+ * \file   WContactSolver.cpp
+ * \brief  Implementation of the sequential impulse contact solver
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "WContactSolver.h"
+
+using namespace WLUW;
+
+namespace
+{
+    constexpr double BAUMGARTE = 0.2;       /* Fraction of the penetration corrected per step */
+    constexpr double LINEAR_SLOP = 0.01;    /* Penetration allowed before correcting, keeps resting contacts touching */
+
+    /**
+     * \brief Helper function which computes the 2D cross product of two vectors
+     */
+    double cross(Vector2 a, Vector2 b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    /**
+     * \brief Helper function which computes the cross product of a scalar (rotation about z) and a vector
+     */
+    Vector2 cross(double s, Vector2 v)
+    {
+        return Vector2(-s * v.y, s * v.x);
+    }
+
+    /**
+     * \brief Helper function which checks whether impulses can move a body. Sleeping bodies act as static
+     */
+    bool isDynamic(const WBodyPool& bodies, int index)
+    {
+        return index >= 0 && index < bodies.getAwakeCount() && (bodies.inverseMass[index] > 0.0 || bodies.inverseInertia[index] > 0.0);
+    }
+
+    /**
+     * \struct BodyState
+     * \brief Velocity and mass of one side of a constraint. Sides without a body act as static
+     */
+    struct BodyState
+    {
+        Vector2 velocity;
+        double angularVelocity = 0.0;
+        double inverseMass = 0.0;
+        double inverseInertia = 0.0;
+    };
+
+    /**
+     * \brief Helper function which reads the state of a body. Bodies which can't be moved get no inverse mass
+     */
+    BodyState loadBody(const WBodyPool& bodies, int index)
+    {
+        BodyState state;
+        if (index < 0)
+            return state;
+
+        state.velocity = Vector2(bodies.velocityX[index], bodies.velocityY[index]);
+        state.angularVelocity = bodies.angularVelocity[index];
+
+        if (isDynamic(bodies, index))
+        {
+            state.inverseMass = bodies.inverseMass[index];
+            state.inverseInertia = bodies.inverseInertia[index];
+        }
+        return state;
+    }
+
+    /**
+     * \brief Helper function which writes the velocity of a body back. Static bodies are never written, they
+     * may be shared between islands solved on different threads
+     */
+    void storeBody(WBodyPool& bodies, int index, const BodyState& state)
+    {
+        if (!isDynamic(bodies, index))
+            return;
+
+        bodies.velocityX[index] = state.velocity.x;
+        bodies.velocityY[index] = state.velocity.y;
+        bodies.angularVelocity[index] = state.angularVelocity;
+    }
+
+    /**
+     * \brief Helper function which applies an impulse to both sides of a contact point
+     */
+    void applyImpulse(BodyState& a, BodyState& b, Vector2 anchorA, Vector2 anchorB, Vector2 impulse)
+    {
+        a.velocity = a.velocity - impulse * a.inverseMass;
+        a.angularVelocity -= a.inverseInertia * cross(anchorA, impulse);
+        b.velocity = b.velocity + impulse * b.inverseMass;
+        b.angularVelocity += b.inverseInertia * cross(anchorB, impulse);
+    }
+
+    /**
+     * \brief Helper function which computes the velocity of b relative to a at a contact point
+     */
+    Vector2 relativeVelocity(const BodyState& a, const BodyState& b, Vector2 anchorA, Vector2 anchorB)
+    {
+        return b.velocity + cross(b.angularVelocity, anchorB) - a.velocity - cross(a.angularVelocity, anchorA);
+    }
+}
+
+void WLUW::WContactSolver::solve(WBodyPool& bodies, const std::vector<SolverContact>& contacts, double deltaTime)
+{
+    buildIslands(bodies, contacts);
+
+    int const islandCount = getIslandCount();
+    int const workerCount = std::min(threadCount, islandCount);
+
+    if (workerCount <= 1)
+    {
+        for (int i = 0; i < islandCount; i++)
+            solveIsland(bodies, i, deltaTime);
+        return;
+    }
+
+    if (!this->workers)
+        this->workers = std::make_unique<WWorkerPool>();
+
+    // Threads take the next unsolved island until there are none left. Which thread solves an island doesn't
+    // change the result, since islands share no dynamic bodies
+    std::atomic<int> nextIsland = 0;
+    this->workers->run(workerCount, [&]() {
+        for (int island = nextIsland++; island < islandCount; island = nextIsland++)
+            solveIsland(bodies, island, deltaTime);
+    });
+}
+
+void WLUW::WContactSolver::updateSleep(WBodyPool& bodies, const std::vector<SolverContact>& contacts, double deltaTime)
+{
+    int const awakeCount = bodies.getAwakeCount();
+
+    // Bodies woken since the last solve aren't in any island yet. Waking keeps the other bodies where they are,
+    // so joining the islands again takes them in without breaking up the rest
+    if (parents.size() != awakeCount)
+        joinIslands(bodies, contacts);
+
+    double const linearTolerance = linearSleepTolerance * linearSleepTolerance;
+    double const angularTolerance = angularSleepTolerance * angularSleepTolerance;
+    islandSleepTimes.assign(awakeCount, std::numeric_limits<double>::infinity());
+
+    // An island can only sleep as soon as its most restless body can
+    for (int i = 0; i < awakeCount; i++)
+    {
+        double linearSpeed = bodies.velocityX[i] * bodies.velocityX[i] + bodies.velocityY[i] * bodies.velocityY[i];
+        double angularSpeed = bodies.angularVelocity[i] * bodies.angularVelocity[i];
+
+        if (linearSpeed > linearTolerance || angularSpeed > angularTolerance)
+            bodies.sleepTime[i] = 0.0;
+        else
+            bodies.sleepTime[i] += deltaTime;
+
+        int root = findRoot(i);
+        islandSleepTimes[root] = std::min(islandSleepTimes[root], bodies.sleepTime[i]);
+    }
+
+    // Collect handles first, putting a body to sleep reorders the awake range
+    sleepingHandles.clear();
+    for (int i = 0; i < awakeCount; i++)
+    {
+        if (islandSleepTimes[findRoot(i)] >= timeToSleep)
+            sleepingHandles.push_back(bodies.getHandle(i));
+    }
+
+    for (int handle : sleepingHandles)
+        bodies.setAwake(handle, false);
+}
+
+int WLUW::WContactSolver::findRoot(int index)
+{
+    // Path halving keeps the trees shallow without recursion
+    while (parents[index] != index)
+    {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+
+    return index;
+}
+
+void WLUW::WContactSolver::joinIslands(const WBodyPool& bodies, const std::vector<SolverContact>& contacts)
+{
+    parents.resize(bodies.getAwakeCount());
+    std::iota(parents.begin(), parents.end(), 0);
+
+    // Contacts between two dynamic bodies join their islands. Static bodies don't carry anything across,
+    // so they don't join islands together
+    for (const SolverContact& contact : contacts)
+    {
+        int indexA = contact.bodyA >= 0 ? bodies.getIndex(contact.bodyA) : -1;
+        int indexB = contact.bodyB >= 0 ? bodies.getIndex(contact.bodyB) : -1;
+
+        if (!isDynamic(bodies, indexA) || !isDynamic(bodies, indexB))
+            continue;
+
+        int rootA = findRoot(indexA);
+        int rootB = findRoot(indexB);
+        if (rootA != rootB)
+            parents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+    }
+}
+
+void WLUW::WContactSolver::buildIslands(WBodyPool& bodies, const std::vector<SolverContact>& contacts)
+{
+    joinIslands(bodies, contacts);
+
+    // Number the islands in the order their first contact appears, so the numbering only depends on the input
+    islandIds.assign(bodies.getAwakeCount(), -1);
+    constraintIslands.resize(contacts.size());
+    islandStarts.assign(1, 0);
+
+    for (int i = 0; i < contacts.size(); i++)
+    {
+        int indexA = contacts[i].bodyA >= 0 ? bodies.getIndex(contacts[i].bodyA) : -1;
+        int indexB = contacts[i].bodyB >= 0 ? bodies.getIndex(contacts[i].bodyB) : -1;
+        int dynamicIndex = isDynamic(bodies, indexA) ? indexA : isDynamic(bodies, indexB) ? indexB : -1;
+
+        constraintIslands[i] = -1;
+        if (dynamicIndex < 0 || contacts[i].manifold->pointCount == 0)
+            continue;
+
+        int root = findRoot(dynamicIndex);
+        if (islandIds[root] < 0)
+        {
+            islandIds[root] = static_cast<int>(islandStarts.size()) - 1;
+            islandStarts.push_back(0);
+        }
+
+        constraintIslands[i] = islandIds[root];
+        islandStarts[islandIds[root] + 1]++;
+    }
+
+    // Counting sort the contacts by island, keeping their order within each island
+    for (int i = 1; i < islandStarts.size(); i++)
+        islandStarts[i] += islandStarts[i - 1];
+
+    constraints.resize(islandStarts.back());
+    cursors.assign(islandStarts.begin(), islandStarts.end() - 1);
+
+    for (int i = 0; i < contacts.size(); i++)
+    {
+        if (constraintIslands[i] < 0)
+            continue;
+
+        Constraint& constraint = constraints[cursors[constraintIslands[i]]++];
+        constraint.indexA = contacts[i].bodyA >= 0 ? bodies.getIndex(contacts[i].bodyA) : -1;
+        constraint.indexB = contacts[i].bodyB >= 0 ? bodies.getIndex(contacts[i].bodyB) : -1;
+        constraint.normal = -contacts[i].manifold->normal;
+        constraint.friction = contacts[i].friction;
+        constraint.manifold = contacts[i].manifold;
+    }
+}
+
+void WLUW::WContactSolver::solveIsland(WBodyPool& bodies, int island, double deltaTime)
+{
+    int const first = islandStarts[island];
+    int const last = islandStarts[island + 1];
+
+    // Prepare the points and apply last update's impulses
+    for (int c = first; c < last; c++)
+    {
+        Constraint& constraint = constraints[c];
+        ContactManifold& manifold = *constraint.manifold;
+        BodyState a = loadBody(bodies, constraint.indexA);
+        BodyState b = loadBody(bodies, constraint.indexB);
+
+        Vector2 const centreA = constraint.indexA >= 0 ? Vector2(bodies.positionX[constraint.indexA], bodies.positionY[constraint.indexA]) : Vector2(0, 0);
+        Vector2 const centreB = constraint.indexB >= 0 ? Vector2(bodies.positionX[constraint.indexB], bodies.positionY[constraint.indexB]) : Vector2(0, 0);
+        Vector2 const normal = constraint.normal;
+        Vector2 const tangent(normal.y, -normal.x);
+
+        for (int i = 0; i < manifold.pointCount; i++)
+        {
+            ContactPoint& point = manifold.points[i];
+            ConstraintPoint& solverPoint = constraint.points[i];
+
+            solverPoint.anchorA = point.position - centreA;
+            solverPoint.anchorB = point.position - centreB;
+
+            double rnA = cross(solverPoint.anchorA, normal);
+            double rnB = cross(solverPoint.anchorB, normal);
+            double normalMass = a.inverseMass + b.inverseMass + a.inverseInertia * rnA * rnA + b.inverseInertia * rnB * rnB;
+            solverPoint.normalMass = normalMass > 0.0 ? 1.0 / normalMass : 0.0;
+
+            double rtA = cross(solverPoint.anchorA, tangent);
+            double rtB = cross(solverPoint.anchorB, tangent);
+            double tangentMass = a.inverseMass + b.inverseMass + a.inverseInertia * rtA * rtA + b.inverseInertia * rtB * rtB;
+            solverPoint.tangentMass = tangentMass > 0.0 ? 1.0 / tangentMass : 0.0;
+
+            solverPoint.bias = -BAUMGARTE / deltaTime * std::max(0.0, point.depth - LINEAR_SLOP);
+
+            applyImpulse(a, b, solverPoint.anchorA, solverPoint.anchorB, normal * point.normalImpulse + tangent * point.tangentImpulse);
+        }
+
+        storeBody(bodies, constraint.indexA, a);
+        storeBody(bodies, constraint.indexB, b);
+    }
+
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        for (int c = first; c < last; c++)
+        {
+            Constraint& constraint = constraints[c];
+            ContactManifold& manifold = *constraint.manifold;
+            BodyState a = loadBody(bodies, constraint.indexA);
+            BodyState b = loadBody(bodies, constraint.indexB);
+
+            Vector2 const normal = constraint.normal;
+            Vector2 const tangent(normal.y, -normal.x);
+
+            // Friction first, so the normal impulses get the last word on penetration
+            for (int i = 0; i < manifold.pointCount; i++)
+            {
+                ContactPoint& point = manifold.points[i];
+                ConstraintPoint& solverPoint = constraint.points[i];
+
+                double tangentSpeed = relativeVelocity(a, b, solverPoint.anchorA, solverPoint.anchorB).dot(tangent);
+                double maxFriction = constraint.friction * point.normalImpulse;
+
+                // Clamp the accumulated impulse, not the increment, so earlier iterations can be undone
+                double oldImpulse = point.tangentImpulse;
+                point.tangentImpulse = std::clamp(oldImpulse - solverPoint.tangentMass * tangentSpeed, -maxFriction, maxFriction);
+
+                applyImpulse(a, b, solverPoint.anchorA, solverPoint.anchorB, tangent * (point.tangentImpulse - oldImpulse));
+            }
+
+            for (int i = 0; i < manifold.pointCount; i++)
+            {
+                ContactPoint& point = manifold.points[i];
+                ConstraintPoint& solverPoint = constraint.points[i];
+
+                double normalSpeed = relativeVelocity(a, b, solverPoint.anchorA, solverPoint.anchorB).dot(normal);
+
+                // Contacts can only push
+                double oldImpulse = point.normalImpulse;
+                point.normalImpulse = std::max(oldImpulse - solverPoint.normalMass * (normalSpeed + solverPoint.bias), 0.0);
+
+                applyImpulse(a, b, solverPoint.anchorA, solverPoint.anchorB, normal * (point.normalImpulse - oldImpulse));
+            }
+
+            storeBody(bodies, constraint.indexA, a);
+            storeBody(bodies, constraint.indexB, b);
+        }
+    }
+}
@@ -0,0 +1,165 @@
+/*****************************************************************//**
+ * \file   WContactSolver.h
+ * \brief  Sequential impulse solver for contacts between rigid bodies
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ContactManifold.h"
+#include "Vector2.h"
+#include "WBodyPool.h"
+#include "WWorkerPool.h"
+
+namespace WLUW
+{
+	/**
+	 * \struct SolverContact
+	 * \brief Touching pair handed to the solver
+	 */
+	struct SolverContact
+	{
+		int bodyA;					/* Handle of a's body, -1 if a has no body */
+		int bodyB;					/* Handle of b's body, -1 if b has no body */
+		ContactManifold* manifold;	/* Contacts of the pair. Accumulated impulses are written back for warm starting */
+		double friction;			/* Friction coefficient of the pair */
+	};
+
+	/**
+	 * \class WContactSolver WContactSolver.h
+	 * \brief Resolves contacts by applying impulses to body velocities, one point at a time, over several
+	 * iterations. Bodies linked by contacts are grouped into islands, and islands never share a dynamic body,
+	 * so each island is solved by a single worker thread without locking. An island is always solved in the
+	 * same order whichever thread takes it, so the result doesn't depend on the number of threads. The worker
+	 * threads are started by the first solve which needs them and reused by every solve after it.
+	 * Islands are also the unit of sleeping: an island is put to sleep once all of its bodies have been
+	 * nearly still for long enough, and sleeping bodies are treated as static
+	 */
+	class WContactSolver
+	{
+	public:
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Apply contact impulses to the velocities of the bodies. Positions are left alone, integrate
+		 * them afterwards
+		 *
+		 * \param bodies body state
+		 * \param contacts touching pairs
+		 * \param deltaTime time step the velocities will be integrated over
+		 */
+		void solve(WBodyPool& bodies, const std::vector<SolverContact>& contacts, double deltaTime);
+
+		/**
+		 * \brief Advance the sleep timers of the awake bodies and put to sleep every island whose bodies have
+		 * all been below the sleep tolerances for the time to sleep. Uses the islands of the last solve, joined
+		 * again from the contacts if bodies woke since
+		 *
+		 * \param bodies body state, the same pool passed to solve
+		 * \param contacts touching pairs, the same ones passed to solve
+		 * \param deltaTime time step
+		 */
+		void updateSleep(WBodyPool& bodies, const std::vector<SolverContact>& contacts, double deltaTime);
+
+		/////////////////////
+		//// Getters/Setters
+		/////////////////////
+
+		/**\return number of velocity iterations per solve */
+		int getIterations() const { return iterations; };
+
+		/**
+		 * \brief Set the number of velocity iterations. More iterations make stacks stiffer
+		 *
+		 * \param count iterations per solve
+		 */
+		void setIterations(int count) { iterations = count; };
+
+		/**\return maximum number of threads islands are spread across */
+		int getThreadCount() const { return threadCount; };
+
+		/**
+		 * \brief Set the maximum number of threads islands are spread across. 1 solves everything on the calling thread.
+		 * Workers already started are kept, a solve only wakes as many as it needs
+		 *
+		 * \param count thread count
+		 */
+		void setThreadCount(int count) { threadCount = count < 1 ? 1 : count; };
+
+		/**
+		 * \brief Set how slowly a body must move to count towards sleeping
+		 *
+		 * \param linear linear speed
+		 * \param angular angular speed in radians per second
+		 */
+		void setSleepTolerance(double linear, double angular) { linearSleepTolerance = linear; angularSleepTolerance = angular; };
+
+		/**
+		 * \brief Set how long an island must stay below the sleep tolerances before it sleeps
+		 *
+		 * \param time time to sleep, infinity to never sleep
+		 */
+		void setTimeToSleep(double time) { timeToSleep = time; };
+
+		/**\return time an island must stay still before it sleeps */
+		double getTimeToSleep() const { return timeToSleep; };
+
+		/**\return number of islands found by the last solve */
+		int getIslandCount() const { return static_cast<int>(islandStarts.size()) - 1; };
+
+	private:
+		/**
+		 * \struct ConstraintPoint
+		 * \brief Per point data which doesn't change during the iterations
+		 */
+		struct ConstraintPoint
+		{
+			Vector2 anchorA;		/* Contact point relative to a's centre */
+			Vector2 anchorB;		/* Contact point relative to b's centre */
+			double normalMass;		/* Inverse of the effective mass along the normal */
+			double tangentMass;		/* Inverse of the effective mass along the tangent */
+			double bias;			/* Velocity which pushes the bodies apart to correct penetration */
+		};
+
+		/**
+		 * \struct Constraint
+		 * \brief Contact prepared for solving
+		 */
+		struct Constraint
+		{
+			int indexA;					/* Dense index of a's body, -1 if it has none */
+			int indexB;					/* Dense index of b's body, -1 if it has none */
+			Vector2 normal;				/* Unit axis from a towards b */
+			double friction;			/* Friction coefficient */
+			ContactManifold* manifold;	/* Manifold the impulses are kept in */
+			ConstraintPoint points[2];	/* One per manifold point */
+		};
+
+		int findRoot(int index);
+		void joinIslands(const WBodyPool& bodies, const std::vector<SolverContact>& contacts);
+		void buildIslands(WBodyPool& bodies, const std::vector<SolverContact>& contacts);
+		void solveIsland(WBodyPool& bodies, int island, double deltaTime);
+
+		int iterations = 8;							/* Velocity iterations per solve */
+		int threadCount = 1;						/* Maximum worker threads */
+		double linearSleepTolerance = 0.05;			/* Linear speed below which a body may sleep */
+		double angularSleepTolerance = 0.035;		/* Angular speed below which a body may sleep, about 2 degrees per second */
+		double timeToSleep = 0.5;					/* Time an island must be still before it sleeps */
+		std::vector<int> parents;					/* Union-find parent of each awake body, by dense index */
+		std::vector<int> islandIds;					/* Island of each union-find root, -1 if not numbered yet */
+		std::vector<int> islandStarts;				/* First constraint of each island in constraints, plus the end */
+		std::vector<int> cursors;					/* Next free constraint of each island while sorting */
+		std::vector<int> constraintIslands;			/* Island of each contact, -1 if it has no dynamic body */
+		std::vector<Constraint> constraints;		/* Constraints grouped by island */
+		std::vector<double> islandSleepTimes;		/* Shortest sleep timer of each union-find root */
+		std::vector<int> sleepingHandles;			/* Bodies put to sleep by updateSleep */
+		std::unique_ptr<WWorkerPool> workers;		/* Threads islands are spread across, created by the first solve using them */
+	};
+}
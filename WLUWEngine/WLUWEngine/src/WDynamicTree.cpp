@@ -0,0 +1,558 @@
+/*****************************************************************//**
+ * \file   WDynamicTree.cpp
+ * \brief  Implementation of the dynamic bounding volume tree broadphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "WDynamicTree.h"
+
+using namespace WLUW;
+
+namespace
+{
+    /**
+     * \brief Traversal stack which lives on the call stack until it outgrows its fixed capacity
+     */
+    class TraversalStack
+    {
+    public:
+        void push(int value)
+        {
+            if (count < CAPACITY)
+                fixed[count] = value;
+            else
+                overflow.push_back(value);
+            count++;
+        }
+
+        int pop()
+        {
+            count--;
+            if (count < CAPACITY)
+                return fixed[count];
+
+            int value = overflow.back();
+            overflow.pop_back();
+            return value;
+        }
+
+        bool empty() const { return count == 0; };
+
+    private:
+        static constexpr int CAPACITY = 256;
+        int fixed[CAPACITY];
+        std::vector<int> overflow;
+        int count = 0;
+    };
+}
+
+WLUW::WDynamicTree::WDynamicTree(double margin, double displacementMultiplier)
+    : root(NULL_NODE), freeList(NULL_NODE), proxyCount(0), margin(margin), displacementMultiplier(displacementMultiplier)
+{
+}
+
+int WLUW::WDynamicTree::createProxy(const AABB& aabb, int userId)
+{
+    int proxyId = allocateNode();
+
+    nodes[proxyId].aabb = aabb.fattened(margin);
+    nodes[proxyId].userId = userId;
+    nodes[proxyId].awake = true;
+    nodes[proxyId].filter = CollisionFilter();
+    nodes[proxyId].height = 0;
+
+    insertLeaf(proxyId);
+    proxyCount++;
+
+    return proxyId;
+}
+
+void WLUW::WDynamicTree::destroyProxy(int proxyId)
+{
+    if (proxyId < 0 || proxyId >= nodes.size() || !nodes[proxyId].isLeaf())
+    {
+        throw("Invalid proxy");
+        return;
+    }
+
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    proxyCount--;
+}
+
+void WLUW::WDynamicTree::moveProxy(int proxyId, const AABB& aabb, Vector2 displacement)
+{
+    moveProxyChecked(proxyId, aabb, displacement);
+}
+
+bool WLUW::WDynamicTree::moveProxyChecked(int proxyId, const AABB& aabb, Vector2 displacement)
+{
+    // Predict where the collider is heading and extend the fat box that way
+    AABB fatAABB = aabb.fattened(margin);
+    Vector2 d = displacement * displacementMultiplier;
+
+    if (d.x < 0.0)
+        fatAABB.min.x += d.x;
+    else
+        fatAABB.max.x += d.x;
+
+    if (d.y < 0.0)
+        fatAABB.min.y += d.y;
+    else
+        fatAABB.max.y += d.y;
+
+    // Nothing to do while the collider is still inside its fat box, unless that box has grown far too large
+    const AABB& treeAABB = nodes[proxyId].aabb;
+    if (treeAABB.contains(aabb) && fatAABB.fattened(4.0 * margin).contains(treeAABB))
+        return false;
+
+    removeLeaf(proxyId);
+    nodes[proxyId].aabb = fatAABB;
+    insertLeaf(proxyId);
+
+    return true;
+}
+
+void WLUW::WDynamicTree::findPairs(std::vector<BroadphasePair>& pairs)
+{
+    pairs.clear();
+
+    for (int i = 0; i < nodes.size(); i++)
+    {
+        // Skip internal and free nodes. Sleeping leaves don't search, awake leaves find them
+        if (nodes[i].height != 0 || !nodes[i].awake)
+            continue;
+
+        int userId = nodes[i].userId;
+        traverse(nodes[i].aabb, [&](int proxyId)
+            {
+                // Pairs of awake leaves are found from both ends, only keep them from the lower proxy
+                bool const lowerEnd = proxyId > i || (proxyId != i && !nodes[proxyId].awake);
+                if (lowerEnd && nodes[i].filter.collidesWith(nodes[proxyId].filter))
+                {
+                    int otherId = nodes[proxyId].userId;
+                    pairs.emplace_back(std::min(userId, otherId), std::max(userId, otherId));
+                }
+                return true;
+            });
+    }
+}
+
+void WLUW::WDynamicTree::query(const AABB& aabb, const std::function<bool(int)>& callback) const
+{
+    traverse(aabb, [&](int proxyId) { return callback(nodes[proxyId].userId); });
+}
+
+void WLUW::WDynamicTree::rayCast(const Ray& ray, const RayCastCallback& callback) const
+{
+    if (root == NULL_NODE)
+        return;
+
+    double maxDistance = ray.maxDistance;
+    Ray clipped = ray;
+
+    TraversalStack stack;
+    stack.push(root);
+
+    while (!stack.empty())
+    {
+        const TreeNode& node = nodes[stack.pop()];
+
+        // Test against the ray as clipped by the hits so far, so nodes behind the nearest hit are skipped
+        double distance;
+        clipped.maxDistance = maxDistance;
+        if (!node.aabb.raycast(clipped, distance))
+            continue;
+
+        if (node.isLeaf())
+        {
+            maxDistance = callback(node.userId, maxDistance);
+            if (maxDistance <= 0.0)
+                return;
+        }
+        else
+        {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+void WLUW::WDynamicTree::rayCastBatch(const std::vector<Ray>& rays, const RayCastBatchCallback& callback) const
+{
+    if (root == NULL_NODE || rays.empty())
+        return;
+
+    /**
+     * \brief Node waiting to be visited, with the range of the rays which reached its parent
+     */
+    struct Entry
+    {
+        int node;
+        int begin;
+        int end;
+    };
+
+    std::vector<Ray> clipped = rays;
+    std::vector<int> active(rays.size());
+    for (int i = 0; i < rays.size(); i++)
+        active[i] = i;
+
+    std::vector<Entry> stack;
+    stack.push_back({ root, 0, static_cast<int>(active.size()) });
+
+    while (!stack.empty())
+    {
+        Entry entry = stack.back();
+        stack.pop_back();
+        const TreeNode& node = nodes[entry.node];
+
+        // Everything past the entry's range belongs to subtrees which are already finished
+        active.resize(entry.end);
+
+        // Keep the rays which reach this node at the end of the active list. Both children share the range
+        int begin = static_cast<int>(active.size());
+        for (int i = entry.begin; i < entry.end; i++)
+        {
+            int ray = active[i];
+            double distance;
+            if (clipped[ray].maxDistance > 0.0 && node.aabb.raycast(clipped[ray], distance))
+                active.push_back(ray);
+        }
+
+        int end = static_cast<int>(active.size());
+        if (begin == end)
+            continue;
+
+        if (node.isLeaf())
+        {
+            for (int i = begin; i < end; i++)
+            {
+                int ray = active[i];
+                clipped[ray].maxDistance = callback(ray, node.userId, clipped[ray].maxDistance);
+            }
+        }
+        else
+        {
+            stack.push_back({ node.child1, begin, end });
+            stack.push_back({ node.child2, begin, end });
+        }
+    }
+}
+
+template<class Callback>
+void WLUW::WDynamicTree::traverse(const AABB& aabb, Callback&& callback) const
+{
+    if (root == NULL_NODE)
+        return;
+
+    TraversalStack stack;
+    stack.push(root);
+
+    while (!stack.empty())
+    {
+        const TreeNode& node = nodes[stack.pop()];
+
+        if (!node.aabb.overlaps(aabb))
+            continue;
+
+        if (node.isLeaf())
+        {
+            // Leaves are the only nodes without children, so the node index is the proxy ID
+            if (!callback(static_cast<int>(&node - nodes.data())))
+                return;
+        }
+        else
+        {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+int WLUW::WDynamicTree::allocateNode()
+{
+    int node;
+
+    // Reuse a freed node if there is one, otherwise grow the pool
+    if (freeList != NULL_NODE)
+    {
+        node = freeList;
+        freeList = nodes[node].parent;
+    }
+    else
+    {
+        node = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    nodes[node].parent = NULL_NODE;
+    nodes[node].child1 = NULL_NODE;
+    nodes[node].child2 = NULL_NODE;
+    nodes[node].height = 0;
+    nodes[node].userId = -1;
+
+    return node;
+}
+
+void WLUW::WDynamicTree::freeNode(int node)
+{
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+}
+
+void WLUW::WDynamicTree::insertLeaf(int leaf)
+{
+    if (root == NULL_NODE)
+    {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Find the best sibling by walking down the tree, picking the child which grows the least
+    AABB leafAABB = nodes[leaf].aabb;
+    int index = root;
+
+    while (!nodes[index].isLeaf())
+    {
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        double area = nodes[index].aabb.perimeter();
+        double combinedArea = AABB::combine(nodes[index].aabb, leafAABB).perimeter();
+
+        // Cost of creating a new parent for this node and the new leaf
+        double cost = 2.0 * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        double inheritanceCost = 2.0 * (combinedArea - area);
+
+        double cost1 = AABB::combine(leafAABB, nodes[child1].aabb).perimeter() + inheritanceCost;
+        if (!nodes[child1].isLeaf())
+            cost1 -= nodes[child1].aabb.perimeter();
+
+        double cost2 = AABB::combine(leafAABB, nodes[child2].aabb).perimeter() + inheritanceCost;
+        if (!nodes[child2].isLeaf())
+            cost2 -= nodes[child2].aabb.perimeter();
+
+        // Descend according to the minimum cost
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    int sibling = index;
+
+    // Create a new parent for the leaf and its sibling
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].aabb = AABB::combine(leafAABB, nodes[sibling].aabb);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE)
+    {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        root = newParent;
+    }
+
+    // Walk back up the tree fixing heights and boxes
+    index = nodes[leaf].parent;
+    while (index != NULL_NODE)
+    {
+        index = balance(index);
+
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[index].aabb = AABB::combine(nodes[child1].aabb, nodes[child2].aabb);
+
+        index = nodes[index].parent;
+    }
+}
+
+void WLUW::WDynamicTree::removeLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == NULL_NODE)
+    {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // Destroy the parent and connect the sibling to the grandparent
+    if (nodes[grandParent].child1 == parent)
+        nodes[grandParent].child1 = sibling;
+    else
+        nodes[grandParent].child2 = sibling;
+
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    // Adjust ancestor bounds
+    int index = grandParent;
+    while (index != NULL_NODE)
+    {
+        index = balance(index);
+
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        nodes[index].aabb = AABB::combine(nodes[child1].aabb, nodes[child2].aabb);
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+
+        index = nodes[index].parent;
+    }
+}
+
+int WLUW::WDynamicTree::balance(int iA)
+{
+    TreeNode& A = nodes[iA];
+    if (A.isLeaf() || A.height < 2)
+        return iA;
+
+    int iB = A.child1;
+    int iC = A.child2;
+    TreeNode& B = nodes[iB];
+    TreeNode& C = nodes[iC];
+
+    int heightDifference = C.height - B.height;
+
+    // Rotate C up
+    if (heightDifference > 1)
+    {
+        int iF = C.child1;
+        int iG = C.child2;
+        TreeNode& F = nodes[iF];
+        TreeNode& G = nodes[iG];
+
+        // Swap A and C
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        // A's old parent should point to C
+        if (C.parent != NULL_NODE)
+        {
+            if (nodes[C.parent].child1 == iA)
+                nodes[C.parent].child1 = iC;
+            else
+                nodes[C.parent].child2 = iC;
+        }
+        else
+        {
+            root = iC;
+        }
+
+        // Rotate
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb = AABB::combine(B.aabb, G.aabb);
+            C.aabb = AABB::combine(A.aabb, F.aabb);
+
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb = AABB::combine(B.aabb, F.aabb);
+            C.aabb = AABB::combine(A.aabb, G.aabb);
+
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+
+        return iC;
+    }
+
+    // Rotate B up
+    if (heightDifference < -1)
+    {
+        int iD = B.child1;
+        int iE = B.child2;
+        TreeNode& D = nodes[iD];
+        TreeNode& E = nodes[iE];
+
+        // Swap A and B
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        // A's old parent should point to B
+        if (B.parent != NULL_NODE)
+        {
+            if (nodes[B.parent].child1 == iA)
+                nodes[B.parent].child1 = iB;
+            else
+                nodes[B.parent].child2 = iB;
+        }
+        else
+        {
+            root = iB;
+        }
+
+        // Rotate
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb = AABB::combine(C.aabb, E.aabb);
+            B.aabb = AABB::combine(A.aabb, D.aabb);
+
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb = AABB::combine(C.aabb, D.aabb);
+            B.aabb = AABB::combine(A.aabb, E.aabb);
+
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
@@ -0,0 +1,129 @@
+/*****************************************************************//**
+ * \file   WDynamicTree.h
+ * \brief  Dynamic bounding volume tree broadphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "AABB.h"
+#include "WBroadphase.h"
+
+namespace WLUW
+{
+	/**
+	 * \class WDynamicTree WDynamicTree.h
+	 * \brief Broadphase which keeps proxies in a balanced binary tree of fat bounding boxes.
+	 * Each leaf stores a box grown by a margin, so a collider only has to be reinserted once it
+	 * leaves its fat box instead of every time it moves.
+	 */
+	class WDynamicTree : public WBroadphase
+	{
+	public:
+		static constexpr int NULL_NODE = -1;
+
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor
+		 *
+		 * \param margin distance every leaf box is grown by
+		 * \param displacementMultiplier how far ahead along its displacement a moved leaf box is extended
+		 */
+		WDynamicTree(double margin = 0.1, double displacementMultiplier = 2.0);
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		int createProxy(const AABB& aabb, int userId) override;
+		void destroyProxy(int proxyId) override;
+		void moveProxy(int proxyId, const AABB& aabb, Vector2 displacement) override;
+		void findPairs(std::vector<BroadphasePair>& pairs) override;
+		void query(const AABB& aabb, const std::function<bool(int)>& callback) const override;
+		void rayCast(const Ray& ray, const RayCastCallback& callback) const override;
+
+		/**
+		 * \brief Cast many rays in one walk of the tree. Each node is tested against the rays which reached its
+		 * parent, so rays travelling together share the upper levels of the walk instead of repeating it
+		 *
+		 * \param rays rays to cast
+		 * \param callback called with each ray and proxy found, returns the new maximum distance of that ray
+		 */
+		void rayCastBatch(const std::vector<Ray>& rays, const RayCastBatchCallback& callback) const override;
+		void setProxyAwake(int proxyId, bool awake) override { nodes[proxyId].awake = awake; };
+		void setProxyFilter(int proxyId, const CollisionFilter& filter) override { nodes[proxyId].filter = filter; };
+		int getUserId(int proxyId) const override { return nodes[proxyId].userId; };
+
+		/**
+		 * \brief Moves a proxy and reports whether the tree had to reinsert it
+		 *
+		 * \param proxyId proxy to move
+		 * \param aabb new tight bounding box
+		 * \param displacement how far the collider moved since the last update
+		 * \return true if the proxy left its fat box and was reinserted
+		 */
+		bool moveProxyChecked(int proxyId, const AABB& aabb, Vector2 displacement);
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return fat bounding box of a proxy */
+		const AABB& getFatAABB(int proxyId) const { return nodes[proxyId].aabb; };
+
+		/**\return height of the tree, 0 if empty */
+		int getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; };
+
+		/**\return number of live proxies */
+		int getProxyCount() const { return proxyCount; };
+
+	private:
+		/**
+		 * \struct TreeNode
+		 * \brief Node of the tree. Leaves hold proxies, internal nodes hold the union of their children
+		 */
+		struct TreeNode
+		{
+			AABB aabb;				/* Fat box for leaves, union of children for internal nodes */
+			int parent;				/* Parent node, or next free node while on the free list */
+			int child1;				/* First child, NULL_NODE for leaves */
+			int child2;				/* Second child, NULL_NODE for leaves */
+			int height;				/* 0 for leaves, -1 for free nodes */
+			int userId;				/* User ID of a leaf */
+			CollisionFilter filter;	/* Collision filter of a leaf */
+			bool awake;				/* False while a leaf's collider is asleep */
+
+			bool isLeaf() const { return child1 == NULL_NODE; };
+		};
+
+		int allocateNode();
+		void freeNode(int node);
+		void insertLeaf(int leaf);
+		void removeLeaf(int leaf);
+
+		/**
+		 * \brief Rotates the subtree rooted at a node if its children's heights differ by more than one
+		 *
+		 * \param a node to balance
+		 * \return index of the new subtree root
+		 */
+		int balance(int a);
+
+		template<class Callback>
+		void traverse(const AABB& aabb, Callback&& callback) const;
+
+		std::vector<TreeNode> nodes;	/* Node pool, indexed by node ID */
+		int root;						/* Root node */
+		int freeList;					/* First free node in the pool */
+		int proxyCount;					/* Number of live leaves */
+		double margin;					/* Amount leaf boxes are grown by */
+		double displacementMultiplier;	/* Amount leaf boxes are extended along their motion */
+	};
+}
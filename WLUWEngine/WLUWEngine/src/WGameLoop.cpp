@@ -0,0 +1,67 @@
+/*****************************************************************//**
+ * \file   WGameLoop.cpp
+ * \brief  Implementation of the fixed timestep main loop
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include "WGameLoop.h"
+#include "WTimer.h"
+
+using namespace WLUW;
+
+WLUW::WGameLoop::WGameLoop(int tickRate, int maxTicksPerFrame)
+    : tickRate(tickRate), maxTicksPerFrame(maxTicksPerFrame)
+{
+    if (tickRate <= 0 || maxTicksPerFrame <= 0)
+    {
+        throw("Tick rate and ticks per frame must be positive");
+        return;
+    }
+}
+
+void WLUW::WGameLoop::run(const InputFunction& input, const UpdateFunction& update, const RenderFunction& render)
+{
+    WTimer timer;
+    running = true;
+
+    while (running)
+    {
+        if (!input())
+            break;
+
+        advance(timer.lap(), update);
+        render(getAlpha());
+    }
+
+    running = false;
+}
+
+int WLUW::WGameLoop::advance(std::int64_t elapsedNanoseconds, const UpdateFunction& update)
+{
+    if (elapsedNanoseconds > 0)
+        accumulator += elapsedNanoseconds * tickRate;
+
+    // Catching up on a long frame makes the next frame longer still. Past the limit, drop whole ticks but keep
+    // the fraction so rendering stays smooth
+    std::int64_t const due = accumulator / NANOSECONDS_PER_SECOND;
+    if (due > maxTicksPerFrame)
+    {
+        droppedTicks += due - maxTicksPerFrame;
+        accumulator -= (due - maxTicksPerFrame) * NANOSECONDS_PER_SECOND;
+    }
+
+    double const deltaTime = getTickLength();
+    int ticks = 0;
+
+    while (accumulator >= NANOSECONDS_PER_SECOND)
+    {
+        update(deltaTime);
+        accumulator -= NANOSECONDS_PER_SECOND;
+        tick++;
+        ticks++;
+    }
+
+    return ticks;
+}
@@ -0,0 +1,117 @@
+/*****************************************************************//**
+ * \file   WGameLoop.h
+ * \brief  Main loop which runs the simulation at a fixed rate and renders as often as it can
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace WLUW
+{
+	/**
+	 * \class WGameLoop WGameLoop.h
+	 * \brief Fixed timestep loop. Real time is banked in an accumulator and spent in whole ticks of a fixed
+	 * length, so the simulation behaves the same however fast frames come. Time is counted in integer
+	 * nanoseconds scaled by the tick rate, so a tick rate like 30 Hz which doesn't divide a second into whole
+	 * nanoseconds still never drifts. When a frame takes so long that catching up would take even longer, the
+	 * ticks past the limit are dropped and the game slows down instead of stalling. Rendering is handed the
+	 * fraction of a tick left in the accumulator, to blend the last two simulated states with
+	 *
+	 * \code
+	 * WGameLoop loop(30);
+	 * loop.run(
+	 *     [&]() { return pollEvents(); },
+	 *     [&](double deltaTime) { world.step(deltaTime); },
+	 *     [&](double alpha) { draw(body.getInterpolatedPosition(alpha)); });
+	 * \endcode
+	 */
+	class WGameLoop
+	{
+	public:
+		/* Handles input once per frame. Returns false to leave the loop */
+		using InputFunction = std::function<bool()>;
+
+		/* Advances the simulation by one tick of the given length in seconds */
+		using UpdateFunction = std::function<void(double deltaTime)>;
+
+		/* Draws a frame. Receives the fraction of a tick since the last update */
+		using RenderFunction = std::function<void(double alpha)>;
+
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param tickRate simulation ticks per second
+		 * \param maxTicksPerFrame most ticks run for one frame before the rest of the time is dropped
+		 */
+		WGameLoop(int tickRate = 60, int maxTicksPerFrame = 8);
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Run frames until the input function returns false or stop is called
+		 *
+		 * \param input called first every frame
+		 * \param update called once per tick
+		 * \param render called last every frame
+		 */
+		void run(const InputFunction& input, const UpdateFunction& update, const RenderFunction& render);
+
+		/**
+		 * \brief Bank real time and run every whole tick it pays for. run calls this each frame, call it
+		 * directly to drive the loop from elsewhere
+		 *
+		 * \param elapsedNanoseconds real time since the last call
+		 * \param update called once per tick
+		 * \return number of ticks run
+		 */
+		int advance(std::int64_t elapsedNanoseconds, const UpdateFunction& update);
+
+		/**
+		 * \brief Leave run after the current frame
+		 */
+		void stop() { running = false; };
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return number of ticks run so far */
+		std::int64_t getTick() const { return tick; };
+
+		/**\return simulated time so far in seconds */
+		double getTime() const { return static_cast<double>(tick) / tickRate; };
+
+		/**\return length of a tick in seconds */
+		double getTickLength() const { return 1.0 / tickRate; };
+
+		/**\return simulation ticks per second */
+		int getTickRate() const { return tickRate; };
+
+		/**\return fraction of a tick banked in the accumulator, between 0 and 1 */
+		double getAlpha() const { return static_cast<double>(accumulator) / NANOSECONDS_PER_SECOND; };
+
+		/**\return number of ticks dropped because frames ran too long */
+		std::int64_t getDroppedTicks() const { return droppedTicks; };
+
+	private:
+		static constexpr std::int64_t NANOSECONDS_PER_SECOND = 1000000000;
+
+		int tickRate;					/* Ticks per second */
+		int maxTicksPerFrame;			/* Ticks run per frame before dropping time */
+		std::int64_t accumulator = 0;	/* Banked time in nanoseconds times the tick rate. A tick costs one second's worth */
+		std::int64_t tick = 0;			/* Ticks run so far */
+		std::int64_t droppedTicks = 0;	/* Ticks dropped so far */
+		bool running = false;			/* Cleared by stop */
+	};
+}
@@ -0,0 +1,212 @@
+/*****************************************************************//**
+ * \file   WLayeredBroadphase.cpp
+ * \brief  Implementation of the layered broadphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "WDynamicTree.h"
+#include "WLayeredBroadphase.h"
+
+using namespace WLUW;
+
+WLUW::WLayeredBroadphase::WLayeredBroadphase(const std::vector<CollisionBits>& layerCategories, const Factory& factory)
+    : layerCategories(layerCategories)
+{
+    if (layerCategories.empty())
+    {
+        throw("Layered broadphase needs at least one layer");
+        return;
+    }
+
+    for (int i = 0; i < layerCategories.size(); i++)
+        layers.push_back(factory ? factory() : std::make_unique<WDynamicTree>());
+
+    layerPairs.assign(layers.size() * layers.size(), true);
+}
+
+int WLUW::WLayeredBroadphase::createProxy(const AABB& aabb, int userId)
+{
+    int proxyId;
+
+    if (freeList != -1)
+    {
+        proxyId = freeList;
+        freeList = proxies[proxyId].userId;
+    }
+    else
+    {
+        proxyId = static_cast<int>(proxies.size());
+        proxies.emplace_back();
+    }
+
+    Proxy& proxy = proxies[proxyId];
+    proxy.aabb = aabb;
+    proxy.userId = userId;
+    proxy.filter = CollisionFilter();
+    proxy.layer = findLayer(proxy.filter.category);
+    proxy.innerId = layers[proxy.layer]->createProxy(aabb, proxyId);
+    proxy.awake = true;
+    proxy.alive = true;
+
+    return proxyId;
+}
+
+void WLUW::WLayeredBroadphase::destroyProxy(int proxyId)
+{
+    if (proxyId < 0 || proxyId >= proxies.size() || !proxies[proxyId].alive)
+    {
+        throw("Invalid proxy");
+        return;
+    }
+
+    Proxy& proxy = proxies[proxyId];
+    layers[proxy.layer]->destroyProxy(proxy.innerId);
+
+    proxy.alive = false;
+    proxy.userId = freeList;
+    freeList = proxyId;
+}
+
+void WLUW::WLayeredBroadphase::moveProxy(int proxyId, const AABB& aabb, Vector2 displacement)
+{
+    Proxy& proxy = proxies[proxyId];
+    proxy.aabb = aabb;
+    layers[proxy.layer]->moveProxy(proxy.innerId, aabb, displacement);
+}
+
+void WLUW::WLayeredBroadphase::findPairs(std::vector<BroadphasePair>& pairs)
+{
+    pairs.clear();
+    int const layerCount = getLayerCount();
+
+    // Pairs inside a layer come from its own broadphase, which already applies sleeping and filters
+    for (int i = 0; i < layerCount; i++)
+    {
+        if (!getLayersCollide(i, i))
+            continue;
+
+        layers[i]->findPairs(layerScratch);
+        for (const BroadphasePair& pair : layerScratch)
+        {
+            int a = proxies[pair.first].userId;
+            int b = proxies[pair.second].userId;
+            pairs.emplace_back(std::min(a, b), std::max(a, b));
+        }
+    }
+
+    // Pairs across layers are found by searching the other layers with each awake proxy. A pair of awake
+    // proxies is found from both ends, only keep it from the lower layer
+    for (int proxyId = 0; proxyId < proxies.size(); proxyId++)
+    {
+        const Proxy& proxy = proxies[proxyId];
+        if (!proxy.alive || !proxy.awake)
+            continue;
+
+        for (int layer = 0; layer < layerCount; layer++)
+        {
+            if (layer == proxy.layer || !getLayersCollide(proxy.layer, layer))
+                continue;
+
+            layers[layer]->query(proxy.aabb, [&](int otherId) {
+                const Proxy& other = proxies[otherId];
+
+                if ((proxy.layer < layer || !other.awake) && proxy.filter.collidesWith(other.filter))
+                    pairs.emplace_back(std::min(proxy.userId, other.userId), std::max(proxy.userId, other.userId));
+                return true;
+            });
+        }
+    }
+}
+
+void WLUW::WLayeredBroadphase::setProxyAwake(int proxyId, bool awake)
+{
+    Proxy& proxy = proxies[proxyId];
+    proxy.awake = awake;
+    layers[proxy.layer]->setProxyAwake(proxy.innerId, awake);
+}
+
+void WLUW::WLayeredBroadphase::setProxyFilter(int proxyId, const CollisionFilter& filter)
+{
+    Proxy& proxy = proxies[proxyId];
+    proxy.filter = filter;
+
+    // Move the proxy if its new category belongs to another layer
+    int layer = findLayer(filter.category);
+    if (layer != proxy.layer)
+    {
+        layers[proxy.layer]->destroyProxy(proxy.innerId);
+        proxy.layer = layer;
+        proxy.innerId = layers[layer]->createProxy(proxy.aabb, proxyId);
+        layers[layer]->setProxyAwake(proxy.innerId, proxy.awake);
+    }
+
+    layers[layer]->setProxyFilter(proxy.innerId, filter);
+}
+
+void WLUW::WLayeredBroadphase::query(const AABB& aabb, const std::function<bool(int)>& callback) const
+{
+    bool stopped = false;
+
+    for (const std::unique_ptr<WBroadphase>& layer : layers)
+    {
+        layer->query(aabb, [&](int proxyId) {
+            stopped = !callback(proxies[proxyId].userId);
+            return !stopped;
+        });
+
+        if (stopped)
+            return;
+    }
+}
+
+void WLUW::WLayeredBroadphase::rayCast(const Ray& ray, const RayCastCallback& callback) const
+{
+    // Carry the clipped distance from layer to layer so later layers skip what lies behind earlier hits
+    Ray clipped = ray;
+
+    for (const std::unique_ptr<WBroadphase>& layer : layers)
+    {
+        layer->rayCast(clipped, [&](int proxyId, double maxDistance) {
+            clipped.maxDistance = callback(proxies[proxyId].userId, maxDistance);
+            return clipped.maxDistance;
+        });
+
+        if (clipped.maxDistance <= 0.0)
+            return;
+    }
+}
+
+void WLUW::WLayeredBroadphase::rayCastBatch(const std::vector<Ray>& rays, const RayCastBatchCallback& callback) const
+{
+    std::vector<Ray> clipped = rays;
+
+    for (const std::unique_ptr<WBroadphase>& layer : layers)
+    {
+        layer->rayCastBatch(clipped, [&](int rayIndex, int proxyId, double maxDistance) {
+            clipped[rayIndex].maxDistance = callback(rayIndex, proxies[proxyId].userId, maxDistance);
+            return clipped[rayIndex].maxDistance;
+        });
+    }
+}
+
+void WLUW::WLayeredBroadphase::setLayersCollide(int layerA, int layerB, bool collide)
+{
+    layerPairs[layerA * getLayerCount() + layerB] = collide;
+    layerPairs[layerB * getLayerCount() + layerA] = collide;
+}
+
+int WLUW::WLayeredBroadphase::findLayer(CollisionBits category) const
+{
+    for (int i = 0; i < layerCategories.size(); i++)
+    {
+        if ((layerCategories[i] & category) != 0)
+            return i;
+    }
+
+    return getLayerCount() - 1;
+}
@@ -0,0 +1,121 @@
+/*****************************************************************//**
+ * \file   WLayeredBroadphase.h
+ * \brief  Broadphase which keeps each group of collision layers in its own structure
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "AABB.h"
+#include "WBroadphase.h"
+
+namespace WLUW
+{
+	/**
+	 * \class WLayeredBroadphase WLayeredBroadphase.h
+	 * \brief Broadphase made of one inner broadphase per layer. Proxies are routed to a layer by their filter
+	 * category, and pairs are only searched for between layers which are allowed to collide. A level can put
+	 * its static geometry in one layer and never pair it with itself, so the static tree is only searched by
+	 * awake proxies of the other layers and static colliders never pay for each other
+	 *
+	 * \code
+	 * // Layer 0 holds static geometry, layer 1 everything else
+	 * auto broadphase = std::make_unique<WLayeredBroadphase>(std::vector<CollisionBits>{ STATIC_BIT, ~STATIC_BIT });
+	 * broadphase->setLayersCollide(0, 0, false);
+	 * \endcode
+	 */
+	class WLayeredBroadphase : public WBroadphase
+	{
+	public:
+		/* Creates the inner broadphase of a layer */
+		using Factory = std::function<std::unique_ptr<WBroadphase>()>;
+
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param layerCategories categories routed to each layer. A proxy goes in the first layer sharing a bit
+		 * with its category, or the last layer if none do
+		 * \param factory creates the inner broadphase of each layer, a WDynamicTree if empty
+		 */
+		WLayeredBroadphase(const std::vector<CollisionBits>& layerCategories, const Factory& factory = Factory());
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		int createProxy(const AABB& aabb, int userId) override;
+		void destroyProxy(int proxyId) override;
+		void moveProxy(int proxyId, const AABB& aabb, Vector2 displacement) override;
+		void findPairs(std::vector<BroadphasePair>& pairs) override;
+		void setProxyAwake(int proxyId, bool awake) override;
+		void query(const AABB& aabb, const std::function<bool(int)>& callback) const override;
+		void rayCast(const Ray& ray, const RayCastCallback& callback) const override;
+		void rayCastBatch(const std::vector<Ray>& rays, const RayCastBatchCallback& callback) const override;
+		int getUserId(int proxyId) const override { return proxies[proxyId].userId; };
+
+		/**
+		 * \brief Set the collision filter of a proxy. Moves the proxy to another layer if its category changed layer
+		 *
+		 * \param proxyId proxy to change
+		 * \param filter new filter
+		 */
+		void setProxyFilter(int proxyId, const CollisionFilter& filter) override;
+
+		/**
+		 * \brief Choose whether pairs are searched for between two layers. Every layer pair is searched by default
+		 *
+		 * \param layerA first layer
+		 * \param layerB second layer, may be the same as layerA
+		 * \param collide whether to search the pair of layers
+		 */
+		void setLayersCollide(int layerA, int layerB, bool collide);
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return number of layers */
+		int getLayerCount() const { return static_cast<int>(layers.size()); };
+
+		/**\return layer a proxy is in */
+		int getLayer(int proxyId) const { return proxies[proxyId].layer; };
+
+		/**\return true if pairs are searched for between two layers */
+		bool getLayersCollide(int layerA, int layerB) const { return layerPairs[layerA * getLayerCount() + layerB]; };
+
+	private:
+		/**
+		 * \struct Proxy
+		 * \brief Tracked collider. Inner proxies are created with the outer proxy ID as their user ID
+		 */
+		struct Proxy
+		{
+			AABB aabb;				/* Tight bounding box */
+			int userId;				/* User ID, or next free proxy while on the free list */
+			int layer;				/* Layer the proxy is in */
+			int innerId;			/* Proxy ID in the layer's broadphase */
+			CollisionFilter filter;	/* Collision filter */
+			bool awake;				/* False while the collider is asleep */
+			bool alive;				/* False while on the free list */
+		};
+
+		int findLayer(CollisionBits category) const;
+
+		std::vector<std::unique_ptr<WBroadphase>> layers;	/* Inner broadphase of each layer */
+		std::vector<CollisionBits> layerCategories;		/* Categories routed to each layer */
+		std::vector<bool> layerPairs;						/* Whether each pair of layers is searched, row-major */
+		std::vector<Proxy> proxies;							/* Proxy pool, indexed by proxy ID */
+		int freeList = -1;									/* First free proxy */
+		std::vector<BroadphasePair> layerScratch;			/* Pairs found inside one layer */
+	};
+}
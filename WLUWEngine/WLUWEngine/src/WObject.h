@@ -91,6 +91,19 @@ namespace WLUW
 		 */
 		int removeComponent(int key);
 
+		/**
+		 * \brief Get an attached component by type.
+		 * 
+		 * \tparam T Type of component to get
+		 * \return Pointer to the component, or nullptr if none of that type is attached
+		 */
+		template<class T>
+		T* getComponent()
+		{
+			auto found = componentMap.find(T::getStaticComponentId());
+			return found != componentMap.end() ? static_cast<T*>(found->second.get()) : nullptr;
+		}
+
 		/////////////////////
 		//// Getters/Setters
 		/////////////////////
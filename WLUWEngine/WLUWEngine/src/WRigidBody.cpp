@@ -0,0 +1,174 @@
+/*****************************************************************//**
+ * \file   WRigidBody.cpp
+ * \brief  Implementation of the rigid body component
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include "WRigidBody.h"
+
+WLUW::WRigidBody::WRigidBody(double mass, double inertia) : mass(mass), inertia(inertia)
+{
+}
+
+void WLUW::WRigidBody::applyForce(Vector2 force)
+{
+    if (pool == nullptr)
+    {
+        this->force = this->force + force;
+        return;
+    }
+
+    pool->setAwake(handle, true);
+
+    int index = pool->getIndex(handle);
+    pool->forceX[index] += force.x;
+    pool->forceY[index] += force.y;
+}
+
+void WLUW::WRigidBody::applyTorque(double torque)
+{
+    if (pool == nullptr)
+    {
+        this->torque += torque;
+        return;
+    }
+
+    pool->setAwake(handle, true);
+    pool->torque[pool->getIndex(handle)] += torque;
+}
+
+void WLUW::WRigidBody::attach(WBodyPool& pool, Vector2 position)
+{
+    if (this->pool != nullptr)
+    {
+        throw("Body is already attached");
+        return;
+    }
+
+    this->position = position;
+    this->pool = &pool;
+    this->handle = pool.createBody(getInverseMass(), getInverseInertia(), position, angle, velocity, angularVelocity);
+
+    int index = pool.getIndex(handle);
+    pool.forceX[index] = force.x;
+    pool.forceY[index] = force.y;
+    pool.torque[index] = torque;
+}
+
+void WLUW::WRigidBody::detach()
+{
+    if (pool == nullptr)
+        return;
+
+    int index = pool->getIndex(handle);
+    position = Vector2(pool->positionX[index], pool->positionY[index]);
+    angle = pool->angle[index];
+    velocity = Vector2(pool->velocityX[index], pool->velocityY[index]);
+    angularVelocity = pool->angularVelocity[index];
+    force = Vector2(pool->forceX[index], pool->forceY[index]);
+    torque = pool->torque[index];
+
+    pool->destroyBody(handle);
+    pool = nullptr;
+    handle = -1;
+}
+
+void WLUW::WRigidBody::setAwake(bool awake)
+{
+    if (pool != nullptr)
+        pool->setAwake(handle, awake);
+}
+
+WLUW::Vector2 WLUW::WRigidBody::getPosition() const
+{
+    if (pool == nullptr)
+        return position;
+
+    int index = pool->getIndex(handle);
+    return Vector2(pool->positionX[index], pool->positionY[index]);
+}
+
+void WLUW::WRigidBody::setPosition(Vector2 position)
+{
+    if (pool == nullptr)
+    {
+        this->position = position;
+        return;
+    }
+
+    pool->setAwake(handle, true);
+
+    int index = pool->getIndex(handle);
+    pool->positionX[index] = position.x;
+    pool->positionY[index] = position.y;
+}
+
+double WLUW::WRigidBody::getAngle() const
+{
+    return pool == nullptr ? angle : pool->angle[pool->getIndex(handle)];
+}
+
+void WLUW::WRigidBody::setAngle(double angle)
+{
+    if (pool == nullptr)
+    {
+        this->angle = angle;
+        return;
+    }
+
+    pool->setAwake(handle, true);
+    pool->angle[pool->getIndex(handle)] = angle;
+}
+
+WLUW::Vector2 WLUW::WRigidBody::getVelocity() const
+{
+    if (pool == nullptr)
+        return velocity;
+
+    int index = pool->getIndex(handle);
+    return Vector2(pool->velocityX[index], pool->velocityY[index]);
+}
+
+void WLUW::WRigidBody::setVelocity(Vector2 velocity)
+{
+    if (pool == nullptr)
+    {
+        this->velocity = velocity;
+        return;
+    }
+
+    pool->setAwake(handle, true);
+
+    int index = pool->getIndex(handle);
+    pool->velocityX[index] = velocity.x;
+    pool->velocityY[index] = velocity.y;
+}
+
+double WLUW::WRigidBody::getAngularVelocity() const
+{
+    return pool == nullptr ? angularVelocity : pool->angularVelocity[pool->getIndex(handle)];
+}
+
+void WLUW::WRigidBody::setAngularVelocity(double angularVelocity)
+{
+    if (pool == nullptr)
+    {
+        this->angularVelocity = angularVelocity;
+        return;
+    }
+
+    pool->setAwake(handle, true);
+    pool->angularVelocity[pool->getIndex(handle)] = angularVelocity;
+}
+
+WLUW::Vector2 WLUW::WRigidBody::getInterpolatedPosition(double alpha) const
+{
+    return pool == nullptr ? position : pool->getInterpolatedPosition(handle, alpha);
+}
+
+double WLUW::WRigidBody::getInterpolatedAngle(double alpha) const
+{
+    return pool == nullptr ? angle : pool->getInterpolatedAngle(handle, alpha);
+}
@@ -0,0 +1,147 @@
+/*****************************************************************//**
+ * \file   WRigidBody.h
+ * \brief  Component which lets a WObject be moved by forces and collisions
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include "Vector2.h"
+#include "WBodyPool.h"
+#include "WComponentBase.h"
+
+namespace WLUW
+{
+	/**
+	 * \class WRigidBody WRigidBody.h
+	 * \brief Rigid body component. Once its object is added to a WWorld the state lives in the world's WBodyPool
+	 * and this component is only a handle to it. Before that, and after the object is removed again, the state
+	 * is kept in the component itself, so it can be set up before the object is added
+	 */
+	class WRigidBody : public WComponent<WRigidBody>
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Constructor
+		 *
+		 * \param mass mass of the body, 0 for a static body
+		 * \param inertia moment of inertia, 0 for a body which doesn't rotate
+		 */
+		WRigidBody(double mass = 1.0, double inertia = 1.0);
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Accumulate a force through the centre of mass. Forces are cleared every step. Wakes the body
+		 *
+		 * \param force force to apply
+		 */
+		void applyForce(Vector2 force);
+
+		/**
+		 * \brief Accumulate a torque. Torques are cleared every step. Wakes the body
+		 *
+		 * \param torque torque to apply
+		 */
+		void applyTorque(double torque);
+
+		/**
+		 * \brief Move the state into a pool. Called by WWorld
+		 *
+		 * \param pool pool to store the body in
+		 * \param position starting position, normally taken from the object's collider
+		 */
+		void attach(WBodyPool& pool, Vector2 position);
+
+		/**
+		 * \brief Copy the state back out of the pool and remove it from there. Called by WWorld
+		 */
+		void detach();
+
+		/////////////////////
+		//// Getters/Setters
+		/////////////////////
+
+		/**\return true if the body's state is held by a world */
+		bool isAttached() const { return pool != nullptr; };
+
+		/**\return true if the body is being simulated. Bodies which aren't attached count as awake */
+		bool isAwake() const { return pool == nullptr || pool->isAwake(handle); };
+
+		/**
+		 * \brief Wake the body up or put it to sleep. Has no effect while not attached. Setting the position,
+		 * angle or velocities also wakes the body
+		 *
+		 * \param awake whether the body should be awake
+		 */
+		void setAwake(bool awake);
+
+		/**\return handle of the body in its pool, -1 if not attached */
+		int getHandle() const { return handle; };
+
+		/**\return mass, 0 for a static body */
+		double getMass() const { return mass; };
+
+		/**\return moment of inertia */
+		double getInertia() const { return inertia; };
+
+		/**\return 1 / mass, 0 for a static body */
+		double getInverseMass() const { return mass > 0.0 ? 1.0 / mass : 0.0; };
+
+		/**\return 1 / moment of inertia, 0 for a body which doesn't rotate */
+		double getInverseInertia() const { return inertia > 0.0 ? 1.0 / inertia : 0.0; };
+
+		Vector2 getPosition() const;
+		void setPosition(Vector2 position);
+
+		/**\return rotation in radians */
+		double getAngle() const;
+		void setAngle(double angle);
+
+		Vector2 getVelocity() const;
+		void setVelocity(Vector2 velocity);
+
+		/**\return angular velocity in radians per second */
+		double getAngularVelocity() const;
+		void setAngularVelocity(double angularVelocity);
+
+		/**
+		 * \brief Gets the position to draw the body at between two fixed steps
+		 *
+		 * \param alpha interpolation factor from WGameLoop::getAlpha
+		 * \return position blended between the last two steps. The current position if not in a world
+		 */
+		Vector2 getInterpolatedPosition(double alpha) const;
+
+		/**
+		 * \brief Gets the angle to draw the body at between two fixed steps
+		 *
+		 * \param alpha interpolation factor from WGameLoop::getAlpha
+		 * \return angle blended between the last two steps. The current angle if not in a world
+		 */
+		double getInterpolatedAngle(double alpha) const;
+
+	private:
+		double mass;					/* Mass, 0 for static */
+		double inertia;					/* Moment of inertia, 0 for no rotation */
+
+		// State used while not attached to a pool
+		Vector2 position;				/* Position */
+		double angle = 0.0;				/* Rotation in radians */
+		Vector2 velocity;				/* Linear velocity */
+		double angularVelocity = 0.0;	/* Angular velocity */
+		Vector2 force;					/* Accumulated force */
+		double torque = 0.0;			/* Accumulated torque */
+
+		WBodyPool* pool = nullptr;		/* Pool holding the state while attached */
+		int handle = -1;				/* Handle in the pool */
+	};
+}
@@ -0,0 +1,401 @@
+/*****************************************************************//**
+ * \file   WSpatialHashGrid.cpp
+ * \brief  Implementation of the uniform spatial hash grid broadphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "WSpatialHashGrid.h"
+
+using namespace WLUW;
+
+namespace
+{
+    constexpr std::int64_t EMPTY_KEY = std::numeric_limits<std::int64_t>::min();   /* Key of a slot which never held a cell */
+    constexpr int CELL_LIMIT = 1 << 30;                                             /* Cell coordinates are clamped to +/- this */
+    constexpr int INITIAL_TABLE_SIZE = 1024;                                        /* Starting number of slots in the cell table */
+    constexpr int MIN_CELL_CAPACITY = 4;                                            /* Smallest run a cell gets when it has to move */
+
+    /**
+     * \brief Helper function which hashes packed cell coordinates
+     *
+     * \param key packed cell coordinates
+     * \param mask table size minus one
+     * \return slot to start probing from
+     */
+    std::size_t hashKey(std::int64_t key, std::size_t mask)
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(h >> 32) & mask;
+    }
+
+    /**
+     * \brief Helper function which converts a coordinate to a cell coordinate
+     *
+     * \param value coordinate
+     * \param inverseCellSize 1 / cell size
+     * \return cell coordinate, clamped so it can always be packed
+     */
+    int toCell(double value, double inverseCellSize)
+    {
+        double cell = std::floor(value * inverseCellSize);
+        return static_cast<int>(std::clamp(cell, -static_cast<double>(CELL_LIMIT), static_cast<double>(CELL_LIMIT)));
+    }
+}
+
+WLUW::WSpatialHashGrid::WSpatialHashGrid(double cellSize)
+    : freeList(-1), cellSize(cellSize), inverseCellSize(1.0 / cellSize), usedCells(0), occupiedSlots(0), wastedItems(0), cellsDirty(false)
+{
+    cells.resize(INITIAL_TABLE_SIZE, Cell{ EMPTY_KEY, 0, 0, 0 });
+}
+
+int WLUW::WSpatialHashGrid::createProxy(const AABB& aabb, int userId)
+{
+    int proxyId;
+
+    if (freeList != -1)
+    {
+        proxyId = freeList;
+        freeList = proxies[proxyId].userId;
+    }
+    else
+    {
+        proxyId = static_cast<int>(proxies.size());
+        proxies.emplace_back();
+    }
+
+    Proxy& proxy = proxies[proxyId];
+    proxy.aabb = aabb;
+    proxy.range = computeRange(aabb);
+    proxy.userId = userId;
+    proxy.alive = true;
+    proxy.awake = true;
+    proxy.filter = CollisionFilter();
+
+    insertEntries(proxyId, proxy.range, NO_CELLS);
+
+    return proxyId;
+}
+
+void WLUW::WSpatialHashGrid::destroyProxy(int proxyId)
+{
+    if (proxyId < 0 || proxyId >= proxies.size() || !proxies[proxyId].alive)
+    {
+        throw("Invalid proxy");
+        return;
+    }
+
+    removeEntries(proxyId, proxies[proxyId].range, NO_CELLS);
+
+    proxies[proxyId].alive = false;
+    proxies[proxyId].userId = freeList;
+    freeList = proxyId;
+}
+
+void WLUW::WSpatialHashGrid::moveProxy(int proxyId, const AABB& aabb, Vector2)
+{
+    Proxy& proxy = proxies[proxyId];
+    proxy.aabb = aabb;
+
+    // Only re-bucket when the proxy crossed into a different set of cells, and then only in the cells it left or entered
+    CellRange range = computeRange(aabb);
+    if (range == proxy.range)
+        return;
+
+    CellRange const previous = proxy.range;
+    proxy.range = range;
+    removeEntries(proxyId, previous, range);
+    insertEntries(proxyId, range, previous);
+}
+
+void WLUW::WSpatialHashGrid::findPairs(std::vector<BroadphasePair>& pairs)
+{
+    pairs.clear();
+    rebuildCells();
+
+    for (const Cell& cell : cells)
+    {
+        if (cell.key == EMPTY_KEY || cell.count < 2)
+            continue;
+
+        int cellX = static_cast<int>(cell.key >> 32);
+        int cellY = static_cast<int>(static_cast<std::int32_t>(cell.key & 0xFFFFFFFF));
+        const int* items = cellItems.data() + cell.start;
+
+        for (int i = 0; i < cell.count; i++)
+        {
+            const Proxy& a = proxies[items[i]];
+
+            for (int j = i + 1; j < cell.count; j++)
+            {
+                const Proxy& b = proxies[items[j]];
+
+                if ((!a.awake && !b.awake) || !a.filter.collidesWith(b.filter) || !a.aabb.overlaps(b.aabb))
+                    continue;
+
+                // Two proxies can share many cells, only report the pair from the lowest shared one
+                if (cellX != std::max(a.range.minX, b.range.minX) || cellY != std::max(a.range.minY, b.range.minY))
+                    continue;
+
+                pairs.emplace_back(std::min(a.userId, b.userId), std::max(a.userId, b.userId));
+            }
+        }
+    }
+}
+
+void WLUW::WSpatialHashGrid::query(const AABB& aabb, const std::function<bool(int)>& callback) const
+{
+    rebuildCells();
+
+    CellRange range = computeRange(aabb);
+    double cellCount = (static_cast<double>(range.maxX) - range.minX + 1) * (static_cast<double>(range.maxY) - range.minY + 1);
+
+    // A query covering more cells than exist is cheaper as a linear scan
+    if (cellCount > usedCells)
+    {
+        for (const Proxy& proxy : proxies)
+        {
+            if (proxy.alive && proxy.aabb.overlaps(aabb) && !callback(proxy.userId))
+                return;
+        }
+        return;
+    }
+
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            int cellIndex = findCell(x, y);
+            if (cellIndex == -1)
+                continue;
+
+            const Cell& cell = cells[cellIndex];
+            for (int i = cell.start; i < cell.start + cell.count; i++)
+            {
+                const Proxy& proxy = proxies[cellItems[i]];
+
+                // Only report a proxy from the first cell it shares with the query
+                if (x != std::max(range.minX, proxy.range.minX) || y != std::max(range.minY, proxy.range.minY))
+                    continue;
+
+                if (proxy.aabb.overlaps(aabb) && !callback(proxy.userId))
+                    return;
+            }
+        }
+    }
+}
+
+void WLUW::WSpatialHashGrid::setCellSize(double size)
+{
+    if (size <= 0.0)
+    {
+        throw("Cell size must be positive");
+        return;
+    }
+
+    cellSize = size;
+    inverseCellSize = 1.0 / size;
+
+    for (Proxy& proxy : proxies)
+    {
+        if (proxy.alive)
+            proxy.range = computeRange(proxy.aabb);
+    }
+
+    cellsDirty = true;
+}
+
+WSpatialHashGrid::CellRange WLUW::WSpatialHashGrid::computeRange(const AABB& aabb) const
+{
+    return CellRange
+    {
+        toCell(aabb.min.x, inverseCellSize),
+        toCell(aabb.min.y, inverseCellSize),
+        toCell(aabb.max.x, inverseCellSize),
+        toCell(aabb.max.y, inverseCellSize)
+    };
+}
+
+int WLUW::WSpatialHashGrid::findCell(int x, int y) const
+{
+    std::int64_t key = packKey(x, y);
+    std::size_t mask = cells.size() - 1;
+
+    // Linear probe until the key or a never-used slot is found
+    for (std::size_t slot = hashKey(key, mask);; slot = (slot + 1) & mask)
+    {
+        if (cells[slot].key == key)
+            return static_cast<int>(slot);
+        if (cells[slot].key == EMPTY_KEY)
+            return -1;
+    }
+}
+
+int WLUW::WSpatialHashGrid::findOrCreateCell(int x, int y) const
+{
+    std::int64_t key = packKey(x, y);
+    std::size_t mask = cells.size() - 1;
+
+    for (std::size_t slot = hashKey(key, mask);; slot = (slot + 1) & mask)
+    {
+        if (cells[slot].key == key)
+            return static_cast<int>(slot);
+
+        if (cells[slot].key == EMPTY_KEY)
+        {
+            // Keep the table at most half full, so probes stay short. Past that the next layout grows it
+            if ((occupiedSlots + 1) * 2 > cells.size())
+                return -1;
+
+            cells[slot] = Cell{ key, static_cast<int>(cellItems.size()), 0, 0 };
+            occupiedSlots++;
+            return static_cast<int>(slot);
+        }
+    }
+}
+
+void WLUW::WSpatialHashGrid::insertEntries(int proxyId, const CellRange& range, const CellRange& skip)
+{
+    // A full layout is already due, and will place the proxy from its range
+    if (cellsDirty)
+        return;
+
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            if (skip.contains(x, y))
+                continue;
+
+            int cellIndex = findOrCreateCell(x, y);
+            if (cellIndex == -1)
+            {
+                cellsDirty = true;
+                return;
+            }
+
+            // A full run moves to the end of cellItems with twice the room. The old run is wasted until the next layout
+            Cell& cell = cells[cellIndex];
+            if (cell.count == cell.capacity)
+            {
+                int const start = static_cast<int>(cellItems.size());
+                int const capacity = std::max(MIN_CELL_CAPACITY, cell.capacity * 2);
+                cellItems.resize(cellItems.size() + capacity);
+                std::copy(cellItems.begin() + cell.start, cellItems.begin() + cell.start + cell.count, cellItems.begin() + start);
+
+                wastedItems += cell.capacity;
+                cell.start = start;
+                cell.capacity = capacity;
+            }
+
+            if (cell.count == 0)
+                usedCells++;
+            cellItems[cell.start + cell.count++] = proxyId;
+        }
+    }
+
+    // Lay everything out afresh once more of cellItems is wasted than used
+    if (wastedItems > cellItems.size() / 2)
+        cellsDirty = true;
+}
+
+void WLUW::WSpatialHashGrid::removeEntries(int proxyId, const CellRange& range, const CellRange& keep)
+{
+    if (cellsDirty)
+        return;
+
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            if (keep.contains(x, y))
+                continue;
+
+            // Swap the last proxy of the run into the hole. Emptied cells keep their slot until the next layout
+            Cell& cell = cells[findCell(x, y)];
+            int* items = cellItems.data() + cell.start;
+            int* found = std::find(items, items + cell.count, proxyId);
+            *found = items[--cell.count];
+
+            if (cell.count == 0)
+                usedCells--;
+        }
+    }
+}
+
+void WLUW::WSpatialHashGrid::rebuildCells() const
+{
+    if (!cellsDirty)
+        return;
+
+    // Every entry could be in its own cell, size the table so it stays at most half full without growing midway
+    std::size_t entryCount = 0;
+    for (const Proxy& proxy : proxies)
+    {
+        if (proxy.alive)
+            entryCount += (static_cast<std::size_t>(proxy.range.maxX) - proxy.range.minX + 1) * (static_cast<std::size_t>(proxy.range.maxY) - proxy.range.minY + 1);
+    }
+
+    std::size_t tableSize = cells.size();
+    while (tableSize < entryCount * 2)
+        tableSize *= 2;
+
+    cells.assign(tableSize, Cell{ EMPTY_KEY, 0, 0, 0 });
+    occupiedSlots = 0;
+
+    // Counting sort. Count the proxies in each cell, remembering which cell every entry went to
+    entryCells.clear();
+    for (const Proxy& proxy : proxies)
+    {
+        if (!proxy.alive)
+            continue;
+
+        for (int x = proxy.range.minX; x <= proxy.range.maxX; x++)
+        {
+            for (int y = proxy.range.minY; y <= proxy.range.maxY; y++)
+            {
+                int cellIndex = findOrCreateCell(x, y);
+                cells[cellIndex].count++;
+                entryCells.push_back(cellIndex);
+            }
+        }
+    }
+
+    // Turn the counts into where each cell's run starts. Runs get half as much room again, so proxies can move
+    // into a cell without moving its run
+    int start = 0;
+    for (Cell& cell : cells)
+    {
+        cell.start = start;
+        cell.capacity = cell.count + cell.count / 2;
+        start += cell.capacity;
+        cell.count = 0;
+    }
+
+    // Drop every proxy into its cells' runs, visiting the entries in the same order as they were counted
+    cellItems.resize(start);
+    std::size_t entry = 0;
+    for (int proxyId = 0; proxyId < proxies.size(); proxyId++)
+    {
+        const Proxy& proxy = proxies[proxyId];
+        if (!proxy.alive)
+            continue;
+
+        std::size_t entryEnd = entry + (static_cast<std::size_t>(proxy.range.maxX) - proxy.range.minX + 1) * (static_cast<std::size_t>(proxy.range.maxY) - proxy.range.minY + 1);
+        for (; entry < entryEnd; entry++)
+        {
+            Cell& cell = cells[entryCells[entry]];
+            cellItems[cell.start + cell.count++] = proxyId;
+        }
+    }
+
+    usedCells = occupiedSlots;
+    wastedItems = 0;
+    cellsDirty = false;
+}
@@ -0,0 +1,158 @@
+/*****************************************************************//**
+ * \file   WSpatialHashGrid.h
+ * \brief  Uniform spatial hash grid broadphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "AABB.h"
+#include "WBroadphase.h"
+
+namespace WLUW
+{
+	/**
+	 * \class WSpatialHashGrid WSpatialHashGrid.h
+	 * \brief Broadphase which buckets proxies into a uniform grid of square cells. Works best when most
+	 * colliders are about the size of a cell. Cells live in one open-addressed array, and the proxies of every
+	 * cell sit back to back in one flat array, laid out by a counting sort with some room left in each run.
+	 * Moves within the same cells are free. A proxy which is added, removed or crosses into different cells only
+	 * updates the runs of the cells it left or entered. A run that runs out of room moves to the end of the
+	 * array, and the whole layout is only redone once more of the array is wasted than used.
+	 */
+	class WSpatialHashGrid : public WBroadphase
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor
+		 *
+		 * \param cellSize width and height of each cell
+		 */
+		WSpatialHashGrid(double cellSize = 1.0);
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		int createProxy(const AABB& aabb, int userId) override;
+		void destroyProxy(int proxyId) override;
+		/**
+		 * \brief Update the box of a proxy. The grid keeps no fat boxes, so the displacement isn't needed
+		 */
+		void moveProxy(int proxyId, const AABB& aabb, Vector2) override;
+		void findPairs(std::vector<BroadphasePair>& pairs) override;
+		void query(const AABB& aabb, const std::function<bool(int)>& callback) const override;
+		void setProxyAwake(int proxyId, bool awake) override { proxies[proxyId].awake = awake; };
+		void setProxyFilter(int proxyId, const CollisionFilter& filter) override { proxies[proxyId].filter = filter; };
+		int getUserId(int proxyId) const override { return proxies[proxyId].userId; };
+
+		/**
+		 * \brief Change the cell size. Every proxy is re-bucketed
+		 *
+		 * \param size new width and height of each cell
+		 */
+		void setCellSize(double size);
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return width and height of each cell */
+		double getCellSize() const { return cellSize; };
+
+		/**\return number of cells holding at least one proxy */
+		int getCellCount() const { rebuildCells(); return usedCells; };
+
+	private:
+		/**
+		 * \struct CellRange
+		 * \brief Inclusive range of cell coordinates covered by a box
+		 */
+		struct CellRange
+		{
+			int minX, minY, maxX, maxY;
+
+			bool contains(int x, int y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; };
+
+			bool operator==(const CellRange& other) const
+			{
+				return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+			}
+		};
+
+		/**
+		 * \struct Proxy
+		 * \brief Tracked collider
+		 */
+		struct Proxy
+		{
+			AABB aabb;			/* Tight bounding box */
+			CellRange range;	/* Cells the box covers */
+			int userId;			/* User ID, or next free proxy while on the free list */
+			CollisionFilter filter;	/* Collision filter */
+			bool alive;			/* False while on the free list */
+			bool awake;			/* False while the collider is asleep */
+		};
+
+		/**
+		 * \struct Cell
+		 * \brief Slot in the cell table, pointing at the cell's run of proxies in cellItems
+		 */
+		struct Cell
+		{
+			std::int64_t key;	/* Packed cell coordinates */
+			int start;			/* First entry of the cell in cellItems */
+			int count;			/* Number of proxies overlapping the cell */
+			int capacity;		/* Entries reserved for the cell in cellItems */
+		};
+
+		static std::int64_t packKey(int x, int y)
+		{
+			return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+		}
+
+		static constexpr CellRange NO_CELLS = { 0, 0, -1, -1 };	/* Range covering no cells */
+
+		CellRange computeRange(const AABB& aabb) const;
+		int findCell(int x, int y) const;
+		int findOrCreateCell(int x, int y) const;
+
+		/**
+		 * \brief Add a proxy to the runs of the cells of a range, except those also in another range
+		 */
+		void insertEntries(int proxyId, const CellRange& range, const CellRange& skip);
+
+		/**
+		 * \brief Remove a proxy from the runs of the cells of a range, except those also in another range
+		 */
+		void removeEntries(int proxyId, const CellRange& range, const CellRange& keep);
+
+		/**
+		 * \brief Lay the proxies out cell by cell again if the layout was dropped since the last one
+		 */
+		void rebuildCells() const;
+
+		std::vector<Proxy> proxies;	/* Proxy pool, indexed by proxy ID */
+		int freeList;				/* First free proxy */
+		double cellSize;			/* Width and height of each cell */
+		double inverseCellSize;		/* 1 / cellSize */
+
+		// Cell layout, updated as proxies change cells and laid out afresh lazily once it gets too wasteful
+		mutable std::vector<Cell> cells;		/* Open-addressed cell table, size is a power of two */
+		mutable std::vector<int> cellItems;		/* Proxy IDs grouped by cell, with room left after each run */
+		mutable std::vector<int> entryCells;	/* Cell of each entry of cellItems, in proxy order, while rebuilding */
+		mutable int usedCells;					/* Cells holding at least one proxy */
+		mutable int occupiedSlots;				/* Slots of the cell table in use, emptied cells included */
+		mutable std::size_t wastedItems;		/* Entries of cellItems left behind by runs which moved */
+		mutable bool cellsDirty;				/* The layout must be redone before it is read */
+	};
+}
@@ -0,0 +1,281 @@
+/*****************************************************************//**
+ * \file   WSweepAndPrune.cpp
+ * \brief  Implementation of the sweep-and-prune broadphase
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "WSweepAndPrune.h"
+
+using namespace WLUW;
+
+int WLUW::WSweepAndPrune::createProxy(const AABB& aabb, int userId)
+{
+    int proxyId;
+
+    if (freeList != -1)
+    {
+        proxyId = freeList;
+        freeList = proxies[proxyId].userId;
+    }
+    else
+    {
+        proxyId = static_cast<int>(proxies.size());
+        proxies.emplace_back();
+    }
+
+    Proxy& proxy = proxies[proxyId];
+    proxy.aabb = aabb;
+    proxy.userId = userId;
+    proxy.alive = true;
+    proxy.awake = true;
+    proxy.filter = CollisionFilter();
+    maxWidth = std::max(maxWidth, aabb.max.x - aabb.min.x);
+
+    // Append the endpoints, the next update sorts them into place and finds the new pairs on the way
+    for (int axis = 0; axis < 2; axis++)
+    {
+        proxy.minIndex[axis] = static_cast<int>(endpoints[axis].size());
+        endpoints[axis].push_back({ aabb.min[axis], proxyId << 1 });
+
+        proxy.maxIndex[axis] = static_cast<int>(endpoints[axis].size());
+        endpoints[axis].push_back({ aabb.max[axis], (proxyId << 1) | 1 });
+    }
+
+    sorted = false;
+
+    return proxyId;
+}
+
+void WLUW::WSweepAndPrune::destroyProxy(int proxyId)
+{
+    if (proxyId < 0 || proxyId >= proxies.size() || !proxies[proxyId].alive)
+    {
+        throw("Invalid proxy");
+        return;
+    }
+
+    // Remove both endpoints from each axis and fix up the indices of everything after them
+    for (int axis = 0; axis < 2; axis++)
+    {
+        std::vector<Endpoint>& axisEndpoints = endpoints[axis];
+        int first = proxies[proxyId].minIndex[axis];
+
+        axisEndpoints.erase(
+            std::remove_if(axisEndpoints.begin() + first, axisEndpoints.end(), [=](const Endpoint& e) { return e.proxy() == proxyId; }),
+            axisEndpoints.end());
+
+        for (int i = first; i < axisEndpoints.size(); i++)
+            setEndpointIndex(axis, i);
+    }
+
+    // Drop every pair the proxy was part of
+    std::vector<std::uint64_t> doomed;
+    for (std::uint64_t key : pairSet)
+    {
+        if (static_cast<int>(key >> 32) == proxyId || static_cast<int>(key & 0xFFFFFFFF) == proxyId)
+            doomed.push_back(key);
+    }
+
+    for (std::uint64_t key : doomed)
+        removePair(static_cast<int>(key >> 32), static_cast<int>(key & 0xFFFFFFFF));
+
+    // Keep the ID out of circulation until the removals have been reported
+    proxies[proxyId].alive = false;
+    pendingFree.push_back(proxyId);
+}
+
+void WLUW::WSweepAndPrune::moveProxy(int proxyId, const AABB& aabb, Vector2)
+{
+    Proxy& proxy = proxies[proxyId];
+    proxy.aabb = aabb;
+    maxWidth = std::max(maxWidth, aabb.max.x - aabb.min.x);
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        endpoints[axis][proxy.minIndex[axis]].value = aabb.min[axis];
+        endpoints[axis][proxy.maxIndex[axis]].value = aabb.max[axis];
+    }
+
+    sorted = false;
+}
+
+void WLUW::WSweepAndPrune::findPairs(std::vector<BroadphasePair>& pairs)
+{
+    updatePairs();
+
+    pairs.clear();
+    pairs.reserve(pairSet.size());
+
+    for (std::uint64_t key : pairSet)
+    {
+        // Pairs of sleeping or filtered proxies stay tracked, they just aren't reported
+        const Proxy& a = proxies[static_cast<int>(key >> 32)];
+        const Proxy& b = proxies[static_cast<int>(key & 0xFFFFFFFF)];
+        if ((!a.awake && !b.awake) || !a.filter.collidesWith(b.filter))
+            continue;
+
+        pairs.push_back(toUserPair(key));
+    }
+}
+
+void WLUW::WSweepAndPrune::updatePairs()
+{
+    addedPairs.clear();
+    removedPairs.clear();
+
+    sortAxis(0);
+    sortAxis(1);
+    sorted = true;
+
+    // A pair can be added and removed again within one update. Its changes alternate, so only a pair with an
+    // addition or a removal left over once they cancel out has changed
+    std::sort(changedPairs.begin(), changedPairs.end(), [](const ChangedPair& lhs, const ChangedPair& rhs) { return lhs.key < rhs.key; });
+    for (std::size_t first = 0, last = 0; first < changedPairs.size(); first = last)
+    {
+        int net = 0;
+        for (last = first; last < changedPairs.size() && changedPairs[last].key == changedPairs[first].key; last++)
+            net += changedPairs[last].added ? 1 : -1;
+
+        if (net > 0)
+            addedPairs.push_back(changedPairs[first].userPair);
+        else if (net < 0)
+            removedPairs.push_back(changedPairs[first].userPair);
+    }
+
+    changedPairs.clear();
+    std::sort(addedPairs.begin(), addedPairs.end());
+    std::sort(removedPairs.begin(), removedPairs.end());
+
+    // Destroyed proxies have been reported, their IDs can be reused now
+    for (int proxyId : pendingFree)
+    {
+        proxies[proxyId].userId = freeList;
+        freeList = proxyId;
+    }
+    pendingFree.clear();
+
+    // Boxes may have shrunk since they widened maxWidth, tighten it again
+    maxWidth = 0.0;
+    for (const Proxy& proxy : proxies)
+    {
+        if (proxy.alive)
+            maxWidth = std::max(maxWidth, proxy.aabb.max.x - proxy.aabb.min.x);
+    }
+}
+
+void WLUW::WSweepAndPrune::query(const AABB& aabb, const std::function<bool(int)>& callback) const
+{
+    // Endpoints are stale until the next update, fall back to checking every proxy
+    if (!sorted)
+    {
+        for (const Proxy& proxy : proxies)
+        {
+            if (proxy.alive && proxy.aabb.overlaps(aabb) && !callback(proxy.userId))
+                return;
+        }
+        return;
+    }
+
+    // Every overlapping proxy starts before the end of the query along x, and no earlier than the widest box
+    // before its start. Search for the first endpoint which could belong to one
+    const std::vector<Endpoint>& axisEndpoints = endpoints[0];
+    auto first = std::lower_bound(axisEndpoints.begin(), axisEndpoints.end(), aabb.min.x - maxWidth,
+        [](const Endpoint& endpoint, double value) { return endpoint.value < value; });
+
+    for (auto endpoint = first; endpoint != axisEndpoints.end(); ++endpoint)
+    {
+        if (endpoint->value > aabb.max.x)
+            break;
+
+        if (endpoint->isMax())
+            continue;
+
+        const Proxy& proxy = proxies[endpoint->proxy()];
+        if (proxy.aabb.overlaps(aabb) && !callback(proxy.userId))
+            return;
+    }
+}
+
+void WLUW::WSweepAndPrune::sortAxis(int axis)
+{
+    std::vector<Endpoint>& axisEndpoints = endpoints[axis];
+
+    for (int i = 1; i < axisEndpoints.size(); i++)
+    {
+        Endpoint moving = axisEndpoints[i];
+        int j = i - 1;
+
+        if (!moving.sortsBefore(axisEndpoints[j]))
+            continue;
+
+        // Shift the endpoint left. Every endpoint it passes is a potential change in overlap
+        while (j >= 0 && moving.sortsBefore(axisEndpoints[j]))
+        {
+            const Endpoint& passed = axisEndpoints[j];
+            int a = moving.proxy();
+            int b = passed.proxy();
+
+            if (a != b)
+            {
+                bool overlapping = proxies[a].aabb.overlaps(proxies[b].aabb);
+
+                // A lower end passing an upper end means the boxes started overlapping along this axis
+                if (!moving.isMax() && passed.isMax() && overlapping)
+                    addPair(a, b);
+                // An upper end passing a lower end means they separated along this axis
+                else if (moving.isMax() && !passed.isMax() && !overlapping)
+                    removePair(a, b);
+            }
+
+            axisEndpoints[j + 1] = passed;
+            setEndpointIndex(axis, j + 1);
+            j--;
+        }
+
+        axisEndpoints[j + 1] = moving;
+        setEndpointIndex(axis, j + 1);
+    }
+}
+
+void WLUW::WSweepAndPrune::setEndpointIndex(int axis, int index)
+{
+    const Endpoint& endpoint = endpoints[axis][index];
+
+    if (endpoint.isMax())
+        proxies[endpoint.proxy()].maxIndex[axis] = index;
+    else
+        proxies[endpoint.proxy()].minIndex[axis] = index;
+}
+
+void WLUW::WSweepAndPrune::addPair(int a, int b)
+{
+    std::uint64_t key = pairKey(a, b);
+    if (pairSet.count(key))
+        return;
+
+    changedPairs.push_back({ key, true, toUserPair(key) });
+    pairSet.insert(key);
+}
+
+void WLUW::WSweepAndPrune::removePair(int a, int b)
+{
+    std::uint64_t key = pairKey(a, b);
+    if (!pairSet.count(key))
+        return;
+
+    changedPairs.push_back({ key, false, toUserPair(key) });
+    pairSet.erase(key);
+}
+
+BroadphasePair WLUW::WSweepAndPrune::toUserPair(std::uint64_t key) const
+{
+    int a = proxies[static_cast<int>(key >> 32)].userId;
+    int b = proxies[static_cast<int>(key & 0xFFFFFFFF)].userId;
+
+    return BroadphasePair(std::min(a, b), std::max(a, b));
+}
@@ -0,0 +1,148 @@
+/*****************************************************************//**
+ * \file   WSweepAndPrune.h
+ * \brief  Sweep-and-prune broadphase with temporal coherence
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "AABB.h"
+#include "WBroadphase.h"
+
+namespace WLUW
+{
+	/**
+	 * \class WSweepAndPrune WSweepAndPrune.h
+	 * \brief Broadphase which keeps the box endpoints of every proxy sorted along both axes. The arrays stay
+	 * sorted between updates and are fixed up with insertion sort, so scenes with little motion cost close to
+	 * linear time. Pairs are tracked persistently and each update reports which pairs were added and removed.
+	 */
+	class WSweepAndPrune : public WBroadphase
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor
+		 */
+		WSweepAndPrune()
+		{
+		}
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		int createProxy(const AABB& aabb, int userId) override;
+		void destroyProxy(int proxyId) override;
+		void moveProxy(int proxyId, const AABB& aabb, Vector2) override;
+		void query(const AABB& aabb, const std::function<bool(int)>& callback) const override;
+		void setProxyAwake(int proxyId, bool awake) override { proxies[proxyId].awake = awake; };
+		void setProxyFilter(int proxyId, const CollisionFilter& filter) override { proxies[proxyId].filter = filter; };
+		int getUserId(int proxyId) const override { return proxies[proxyId].userId; };
+
+		/**
+		 * \brief Runs updatePairs, then copies out the full set of overlapping pairs
+		 *
+		 * \param pairs cleared, then filled with the user IDs of each overlapping pair
+		 */
+		void findPairs(std::vector<BroadphasePair>& pairs) override;
+
+		/**
+		 * \brief Re-sorts the endpoint arrays and works out which pairs started or stopped overlapping
+		 * since the last update. Results are available from getAddedPairs and getRemovedPairs
+		 */
+		void updatePairs();
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return pairs which started overlapping during the last update */
+		std::vector<BroadphasePair> const& getAddedPairs() const { return addedPairs; };
+
+		/**\return pairs which stopped overlapping, or lost a proxy, during the last update */
+		std::vector<BroadphasePair> const& getRemovedPairs() const { return removedPairs; };
+
+		/**\return number of pairs currently overlapping */
+		int getPairCount() const { return static_cast<int>(pairSet.size()); };
+
+	private:
+		/**
+		 * \struct Endpoint
+		 * \brief Lower or upper end of a proxy's box along one axis
+		 */
+		struct Endpoint
+		{
+			double value;	/* Coordinate along the axis */
+			int data;		/* Proxy ID shifted left by one, low bit set for upper ends */
+
+			int proxy() const { return data >> 1; };
+			bool isMax() const { return (data & 1) != 0; };
+
+			/**\return true if this endpoint sorts before another. Lower ends sort first on ties so touching boxes overlap */
+			bool sortsBefore(const Endpoint& other) const
+			{
+				return value < other.value || (value == other.value && !isMax() && other.isMax());
+			}
+		};
+
+		/**
+		 * \struct Proxy
+		 * \brief Tracked collider
+		 */
+		struct Proxy
+		{
+			AABB aabb;			/* Current bounding box */
+			int userId;			/* User ID, or next free proxy while on the free list */
+			int minIndex[2];	/* Index of the lower endpoint on each axis */
+			int maxIndex[2];	/* Index of the upper endpoint on each axis */
+			CollisionFilter filter;	/* Collision filter */
+			bool alive;			/* False while on the free list */
+			bool awake;			/* False while the collider is asleep */
+		};
+
+		static std::uint64_t pairKey(int a, int b)
+		{
+			if (a > b)
+				std::swap(a, b);
+			return (static_cast<std::uint64_t>(a) << 32) | static_cast<std::uint32_t>(b);
+		}
+
+		/**
+		 * \struct ChangedPair
+		 * \brief Pair added or removed since the last update
+		 */
+		struct ChangedPair
+		{
+			std::uint64_t key;			/* Key of the pair */
+			bool added;					/* Whether the pair was added rather than removed */
+			BroadphasePair userPair;	/* User IDs of the pair */
+		};
+
+		void sortAxis(int axis);
+		void setEndpointIndex(int axis, int index);
+		void addPair(int a, int b);
+		void removePair(int a, int b);
+		BroadphasePair toUserPair(std::uint64_t key) const;
+
+		std::vector<Endpoint> endpoints[2];						/* Sorted endpoints along x and y */
+		std::vector<Proxy> proxies;								/* Proxy pool, indexed by proxy ID */
+		int freeList = -1;										/* First free proxy */
+		std::vector<int> pendingFree;							/* Proxies destroyed since the last update, not yet reusable */
+		bool sorted = true;										/* False once an endpoint moved since the last update */
+		double maxWidth = 0.0;									/* At least the widest box along x, so queries know how far back to start */
+		std::unordered_set<std::uint64_t> pairSet;				/* Pairs currently overlapping */
+		std::vector<ChangedPair> changedPairs;					/* Every addition and removal since the last update, in no order */
+		std::vector<BroadphasePair> addedPairs;					/* Pairs added by the last update */
+		std::vector<BroadphasePair> removedPairs;				/* Pairs removed by the last update */
+	};
+}
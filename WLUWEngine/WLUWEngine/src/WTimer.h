@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 class WTimer
 {
@@ -22,8 +23,25 @@ public:
             (timer::now() - startTime).count();
     }
 
+    // Whole nanoseconds since the timer was started or reset. Integer, so summing laps never drifts
+    std::int64_t elapsedNanoseconds() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>
+            (timer::now() - startTime).count();
+    }
+
+    // Nanoseconds since the last lap, then restarts the timer from now
+    std::int64_t lap()
+    {
+        auto now = timer::now();
+        std::int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime).count();
+        startTime = now;
+        return nanoseconds;
+    }
+
 private:
-    typedef std::chrono::high_resolution_clock timer;
+    // Steady, so frame times never go negative when the wall clock is adjusted
+    typedef std::chrono::steady_clock timer;
     typedef std::chrono::duration<float, std::ratio<1> > second;
     std::chrono::time_point<timer> startTime;
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*****************************************************************//**
+ * \file   WWorkerPool.cpp
+ * \brief  Implementation of the worker pool
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#include "WWorkerPool.h"
+
+using namespace WLUW;
+
+WLUW::WWorkerPool::~WWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->wake.notify_all();
+    for (std::thread& worker : this->workers)
+        worker.join();
+}
+
+void WLUW::WWorkerPool::run(int threadCount, const std::function<void()>& job)
+{
+    int const helpers = threadCount - 1;
+    if (helpers <= 0)
+    {
+        job();
+        return;
+    }
+
+    while (this->workers.size() < helpers)
+        this->workers.emplace_back(&WWorkerPool::workerLoop, this);
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->job = &job;
+        this->generation++;
+        this->unclaimed = helpers;
+        this->running = helpers;
+    }
+
+    this->wake.notify_all();
+    job();
+
+    // The job lives on the caller's stack, so no worker may still be inside it once this returns
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->finished.wait(lock, [this]() { return this->running == 0; });
+    this->job = nullptr;
+}
+
+void WLUW::WWorkerPool::workerLoop()
+{
+    std::uint64_t lastGeneration = 0;
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (true)
+    {
+        // Workers beyond the number a job asked for keep sleeping through it
+        this->wake.wait(lock, [&]() { return this->stopping || (this->generation != lastGeneration && this->unclaimed > 0); });
+        if (this->stopping)
+            return;
+
+        lastGeneration = this->generation;
+        this->unclaimed--;
+        const std::function<void()>* current = this->job;
+
+        lock.unlock();
+        (*current)();
+        lock.lock();
+
+        if (--this->running == 0)
+            this->finished.notify_one();
+    }
+}
@@ -0,0 +1,79 @@
+/*****************************************************************//**
+ * \file   WWorkerPool.h
+ * \brief  Threads kept alive between jobs, so work can be spread across them without starting threads each time
+ *
+ * \author Bassil Virk
+ * \date   October 2026
+ *********************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WLUW
+{
+	/**
+	 * \class WWorkerPool WWorkerPool.h
+	 * \brief Runs one job on several threads at once and waits for all of them to finish. Workers are started
+	 * the first time they're needed and then sleep between jobs, so running a job every step costs a wake up
+	 * rather than a thread start. The calling thread always takes part in the job
+	 */
+	class WWorkerPool
+	{
+	public:
+		/////////////////////
+		//// Constructors
+		/////////////////////
+
+		/**
+		 * \brief Default constructor. Starts no threads
+		 */
+		WWorkerPool() {};
+
+		WWorkerPool(const WWorkerPool&) = delete;
+		WWorkerPool& operator=(const WWorkerPool&) = delete;
+
+		/**
+		 * \brief Destructor. Stops and joins every worker
+		 */
+		~WWorkerPool();
+
+		/////////////////////
+		//// Methods
+		/////////////////////
+
+		/**
+		 * \brief Run a job on the calling thread and threadCount - 1 workers, and return once every one has finished.
+		 * The job must share its work out itself, for example by taking items from an atomic counter
+		 *
+		 * \param threadCount number of threads to run the job on, counting the calling thread
+		 * \param job function each thread calls once
+		 */
+		void run(int threadCount, const std::function<void()>& job);
+
+		/////////////////////
+		//// Getters
+		/////////////////////
+
+		/**\return number of workers started so far, not counting the calling thread */
+		int getWorkerCount() const { return static_cast<int>(workers.size()); };
+
+	private:
+		void workerLoop();
+
+		std::vector<std::thread> workers;				/* Threads started so far */
+		std::mutex mutex;								/* Guards everything below */
+		std::condition_variable wake;					/* Signalled when a job is posted or the pool stops */
+		std::condition_variable finished;				/* Signalled when the last worker finishes a job */
+		const std::function<void()>* job = nullptr;		/* Job being run, null between jobs */
+		std::uint64_t generation = 0;					/* Bumped for every job, so a worker never runs one twice */
+		int unclaimed = 0;								/* Workers still to pick up the current job */
+		int running = 0;								/* Workers which haven't finished the current job */
+		bool stopping = false;							/* Set by the destructor to end the workers */
+	};
+}
@@ -1,13 +1,125 @@
 #include "WWorld.h"
+#include "CompoundShape.h"
+#include "ContactManifold.h"
+#include "GJK.h"
 #include "Shape.h"
+#include "TimeOfImpact.h"
 
+#include <cmath>
+#include <functional>
 #include <utility>
 #include <memory>
 
-using MTV = std::pair<WLUW::Vector2, double>;
+namespace
+{
+	constexpr int MAX_SWEEP_HITS = 3;		/* Surfaces a continuous collider may hit and slide along in one update */
+	constexpr double SWEEP_SKIN = 1e-6;		/* Motion into a surface too small to count as a hit, the gap sweeps leave before a surface */
+	constexpr int MIN_CONTACT_SLOTS = 64;	/* Smallest size of the contact table */
+
+	/**
+	 * \brief Helper function which finds the slot a contact key starts probing from in the contact table
+	 *
+	 * \param key key of the pair
+	 * \param mask table size minus one
+	 */
+	std::size_t hashContact(std::uint64_t key, std::size_t mask)
+	{
+		return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+	}
+
+	/**
+	 * \brief Helper function which finds the box covering a shape's whole path from one position to another
+	 *
+	 * \param bounds box of the shape at one end of the path
+	 * \param move movement from the other end of the path to this one
+	 */
+	WLUW::AABB sweptBounds(const WLUW::AABB& bounds, WLUW::Vector2 move)
+	{
+		return WLUW::AABB::combine(bounds, WLUW::AABB(bounds.min - move, bounds.max - move));
+	}
+
+	/**
+	 * \brief Helper function which checks if a shape overlaps a collider. Touching counts as overlapping
+	 */
+	bool overlaps(const WLUW::Shape& shape, const WLUW::WCollider& collider)
+	{
+		const WLUW::CompoundShape* compound = collider.getCompound();
+		if (compound == nullptr)
+			return WLUW::gjkDistance(shape, collider.getShape()).distance <= 0.0;
+
+		bool found = false;
+		compound->queryChildren(shape.getBoundingBox(), [&](int child) {
+			found = WLUW::gjkDistance(shape, compound->getChild(child)).distance <= 0.0;
+			return !found;
+		});
+		return found;
+	}
+
+	/**
+	 * \brief Helper function which checks if two colliders overlap. Touching counts as overlapping
+	 */
+	bool overlaps(const WLUW::WCollider& a, const WLUW::WCollider& b)
+	{
+		const WLUW::CompoundShape* compound = a.getCompound();
+		if (compound == nullptr)
+			return overlaps(a.getShape(), b);
+
+		bool found = false;
+		compound->queryChildren(b.getBoundingBox(), [&](int child) {
+			found = overlaps(compound->getChild(child), b);
+			return !found;
+		});
+		return found;
+	}
+
+	/**
+	 * \brief Helper function which builds the manifolds of a pair of colliders where at least one is a compound
+	 *
+	 * \param contacts cleared, then filled with a manifold per touching pair of children
+	 * \return number of touching pairs of children
+	 */
+	int computeChildManifolds(const WLUW::WCollider& a, const WLUW::WCollider& b, std::vector<WLUW::ChildContact>& contacts,
+		WLUW::CollisionScratch& scratch)
+	{
+		if (a.isCompound() && b.isCompound())
+			return WLUW::CompoundShape::computeManifolds(*a.getCompound(), *b.getCompound(), contacts, scratch);
+		if (a.isCompound())
+			return WLUW::CompoundShape::computeManifolds(*a.getCompound(), b.getShape(), contacts, scratch);
+		return WLUW::CompoundShape::computeManifolds(a.getShape(), *b.getCompound(), contacts, scratch);
+	}
+
+	/**
+	 * \brief Helper function which casts a shape against one other shape which stands still
+	 *
+	 * \param shape shape to cast, starting where it is now
+	 * \param end position the shape is cast to
+	 * \param other shape to cast against
+	 * \param hit set to the contact if the shape hits other
+	 * \return true if the shape hits other before reaching end
+	 */
+	bool castShapeAgainst(const WLUW::Shape& shape, WLUW::Vector2 end, const WLUW::Shape& other, WLUW::RayHit& hit)
+	{
+		WLUW::Vector2 const start = shape.getPosition();
+
+		WLUW::TOIResult toi = WLUW::timeOfImpact(shape, start, end, other, other.getPosition(), other.getPosition());
+		if (!toi.hit)
+			return false;
+
+		// The contact point is the point on the other shape closest to the cast shape where they touch
+		WLUW::Vector2 const stop = start + (end - start) * toi.time;
+		WLUW::GJKResult closest = WLUW::gjkDistance(other, shape, stop - start);
+
+		hit.point = closest.pointA;
+		hit.normal = -toi.normal;
+		hit.distance = (end - start).size() * toi.time;
+		return true;
+	}
+}
 
 void WLUW::WWorld::addWorldObject(std::unique_ptr<WObject> object)
 {
+	registerCollider(*object);
+	registerBody(*object);
 	worldObjects.push_back(std::move(object));
 }
 
@@ -18,6 +130,9 @@ std::unique_ptr<WLUW::WObject> WLUW::WWorld::removeWorldObject(int id)
 
 	if (foundObject != std::end(worldObjects))
 	{
+		unregisterBody(**foundObject);
+		unregisterCollider(id);
+
 		auto mover = std::make_move_iterator(foundObject);
 		std::unique_ptr<WObject> ret = *mover;
 		worldObjects.erase(mover.base());
@@ -28,14 +143,709 @@ std::unique_ptr<WLUW::WObject> WLUW::WWorld::removeWorldObject(int id)
 	return nullptr;
 }
 
-//void WLUW::WWorld::doCollisionDetection(double deltaTime)
-//{
-//	for (std::unique_ptr<WObject> &collider : worldObjects)
-//	{
-//		for (std::unique_ptr<WObject> &wobj : worldObjects)
-//		{
-//			MTV mtv = Shape::checkCollision(collider->getHitboxShape(), wobj->getHitboxShape());
-//			collider->setHitboxShape(collider->getHitboxShape().getPosition() + mtv.first * mtv.second);
-//		}
-//	}
-//}
+void WLUW::WWorld::setBroadphase(std::unique_ptr<WBroadphase> newBroadphase)
+{
+	broadphase = std::move(newBroadphase);
+	pairs.clear();
+
+	// Proxies belonged to the old broadphase, recreate them in the new one
+	for (ColliderEntry& entry : colliders)
+	{
+		WCollider* collider = entry.collider;
+		collider->setProxyId(broadphase->createProxy(collider->getBoundingBox(), entry.objectId));
+		broadphase->setProxyFilter(collider->getProxyId(), collider->getFilter());
+		entry.lastPosition = collider->getPosition();
+		entry.lastRotation = collider->getTransform().getRotation();
+		entry.proxyAwake = true;
+	}
+}
+
+void WLUW::WWorld::setCollisionFilter(int id, const CollisionFilter& filter)
+{
+	auto found = colliderIndices.find(id);
+	if (found == colliderIndices.end())
+		return;
+
+	WCollider* collider = colliders[found->second].collider;
+	collider->setFilter(filter);
+	broadphase->setProxyFilter(collider->getProxyId(), filter);
+}
+
+void WLUW::WWorld::doCollisionDetection()
+{
+	updateProxies();
+	broadphase->findPairs(pairs);
+
+	updateCount++;
+	solverContacts.clear();
+
+	// Narrowphase only runs on pairs the broadphase could not rule out
+	for (BroadphasePair& pair : pairs)
+	{
+		ColliderEntry& entryA = colliders[colliderIndices[pair.first]];
+		ColliderEntry& entryB = colliders[colliderIndices[pair.second]];
+		WCollider& a = *entryA.collider;
+		WCollider& b = *entryB.collider;
+
+		// Sensors only record the overlap. Sleeping pairs are carried over from last update afterwards
+		bool const aSensor = a.isSensor();
+		bool const bSensor = b.isSensor();
+		if (aSensor || bSensor)
+		{
+			if (aSensor != bSensor && (entryA.isAwake() || entryB.isAwake()) && overlaps(a, b))
+				sensorPairs.emplace_back(aSensor ? pair.first : pair.second, aSensor ? pair.second : pair.first);
+			continue;
+		}
+
+		// Nothing changed between two resting colliders, their contact is kept as it was
+		if (!entryA.isAwake() && !entryB.isAwake())
+			continue;
+
+		// Compounds get a manifold per touching pair of children, everything else a single one
+		bool const compound = a.isCompound() || b.isCompound();
+		ContactManifold manifold;
+		bool const touching = compound
+			? computeChildManifolds(a, b, childContacts, scratch) > 0
+			: computeManifold(a.getShape(), b.getShape(), manifold, scratch);
+		if (!touching)
+			continue;
+
+		// Something moving touched a sleeping body, it has to take part again
+		if (entryA.body != nullptr && !entryA.body->isAwake() && entryB.canWake())
+			entryA.body->setAwake(true);
+		if (entryB.body != nullptr && !entryB.body->isAwake() && entryA.canWake())
+			entryB.body->setAwake(true);
+
+		// Keep the manifolds for next update, carrying over the impulses of points which persisted
+		ContactEntry& contact = findOrAddContact(contactKey(pair.first, pair.second));
+		if (compound)
+			keepChildManifolds(contact);
+		else
+		{
+			manifold.warmStart(contact.manifold);
+			contact.manifold = manifold;
+		}
+		contact.lastUpdate = updateCount;
+
+		// Contacts involving a dynamic body are resolved by the solver
+		bool const aDynamic = entryA.body != nullptr && (entryA.body->getInverseMass() > 0.0 || entryA.body->getInverseInertia() > 0.0);
+		bool const bDynamic = entryB.body != nullptr && (entryB.body->getInverseMass() > 0.0 || entryB.body->getInverseInertia() > 0.0);
+
+		if (aDynamic || bDynamic)
+		{
+			int bodyA = entryA.body != nullptr ? entryA.body->getHandle() : -1;
+			int bodyB = entryB.body != nullptr ? entryB.body->getHandle() : -1;
+			double friction = std::sqrt(a.getFriction() * b.getFriction());
+
+			if (!compound)
+				solverContacts.push_back({ bodyA, bodyB, &contact.manifold, friction });
+			for (ChildContact& child : contact.children)
+				solverContacts.push_back({ bodyA, bodyB, &child.manifold, friction });
+			continue;
+		}
+
+		// Push a out of b
+		a.setPosition(a.getPosition() + contact.manifold.normal * contact.manifold.getMaxDepth());
+	}
+
+	// Forget pairs which stopped touching. Sleeping pairs weren't checked, keep them for when they wake
+	for (const ContactEntry& contact : contacts)
+	{
+		if (contact.key != NO_CONTACT && contact.lastUpdate != updateCount && !isContactAsleep(contact.key))
+			removeContact(findContact(contact.key));
+	}
+
+	updateSensorEvents();
+}
+
+void WLUW::WWorld::step(double deltaTime)
+{
+	bodies.savePreviousState(bodies.getAwakeCount());
+	bodies.integrateVelocities(deltaTime, gravity, bodies.getAwakeCount());
+
+	doCollisionDetection();
+
+	// Sweeps may have stopped shapes short, carry that back to the bodies before solving
+	syncBodyPositions();
+
+	solver.solve(bodies, solverContacts, deltaTime);
+
+	bodies.integratePositions(deltaTime, bodies.getAwakeCount());
+
+	// Move and turn the shapes to where their bodies ended up
+	for (int i = 0; i < bodies.getAwakeCount(); i++)
+	{
+		WCollider* collider = bodyColliders[bodies.getHandle(i)];
+		if (collider == nullptr)
+			continue;
+
+		collider->setPosition(Vector2(bodies.positionX[i], bodies.positionY[i]));
+		collider->setRotation(bodies.angle[i]);
+	}
+
+	// Sweep continuous colliders along the move they just made, rather than a step late, and stop their bodies with them
+	updateProxies();
+	syncBodyPositions();
+
+	solver.updateSleep(bodies, solverContacts, deltaTime);
+
+	if (sensorCallback)
+		sensorCallback(sensorEvents);
+}
+
+const WLUW::ContactManifold* WLUW::WWorld::getManifold(int idA, int idB) const
+{
+	int slot = findContact(contactKey(idA, idB));
+	return slot != -1 ? &contacts[contactSlots[slot]].manifold : nullptr;
+}
+
+bool WLUW::WWorld::raycast(const Ray& ray, RayHit& hit, const CollisionFilter& filter) const
+{
+	bool found = false;
+
+	// Clip the ray at each hit, so the broadphase only goes on to report colliders which could be nearer
+	broadphase->rayCast(ray, [&](int userId, double maxDistance) {
+		const WCollider* collider = findQueryCollider(userId, filter);
+		if (collider == nullptr)
+			return maxDistance;
+
+		Ray clipped = ray;
+		clipped.maxDistance = maxDistance;
+
+		RayHit candidate;
+		if (!collider->raycast(clipped, candidate))
+			return maxDistance;
+
+		candidate.id = userId;
+		hit = candidate;
+		found = true;
+		return candidate.distance;
+	});
+
+	return found;
+}
+
+int WLUW::WWorld::raycastAll(const Ray& ray, std::vector<RayHit>& hits, const CollisionFilter& filter) const
+{
+	hits.clear();
+
+	broadphase->rayCast(ray, [&](int userId, double maxDistance) {
+		const WCollider* collider = findQueryCollider(userId, filter);
+
+		RayHit candidate;
+		if (collider != nullptr && collider->raycast(ray, candidate))
+		{
+			candidate.id = userId;
+			hits.push_back(candidate);
+		}
+
+		return maxDistance;
+	});
+
+	std::sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) { return a.distance < b.distance; });
+	return static_cast<int>(hits.size());
+}
+
+bool WLUW::WWorld::segmentCast(Vector2 start, Vector2 end, RayHit& hit, const CollisionFilter& filter) const
+{
+	double const length = (end - start).size();
+	if (length == 0.0)
+		return false;
+
+	return raycast(Ray{ start, (end - start) / length, length }, hit, filter);
+}
+
+void WLUW::WWorld::raycastBatch(const std::vector<Ray>& rays, std::vector<RayHit>& hits, const CollisionFilter& filter) const
+{
+	hits.assign(rays.size(), RayHit());
+
+	broadphase->rayCastBatch(rays, [&](int rayIndex, int userId, double maxDistance) {
+		const WCollider* collider = findQueryCollider(userId, filter);
+		if (collider == nullptr)
+			return maxDistance;
+
+		Ray clipped = rays[rayIndex];
+		clipped.maxDistance = maxDistance;
+
+		RayHit candidate;
+		if (!collider->raycast(clipped, candidate))
+			return maxDistance;
+
+		candidate.id = userId;
+		hits[rayIndex] = candidate;
+		return candidate.distance;
+	});
+}
+
+bool WLUW::WWorld::shapeCast(const Shape& shape, Vector2 end, RayHit& hit, const CollisionFilter& filter) const
+{
+	// Box covering the whole path of the shape
+	AABB swept = sweptBounds(shape.getBoundingBox(), shape.getPosition() - end);
+
+	bool found = false;
+	broadphase->query(swept, [&](int userId) {
+		RayHit candidate;
+		if (findQueryCollider(userId, filter) != nullptr && castShapeAt(shape, end, userId, candidate)
+			&& (!found || candidate.distance < hit.distance))
+		{
+			hit = candidate;
+			found = true;
+		}
+		return true;
+	});
+
+	return found;
+}
+
+int WLUW::WWorld::shapeCastAll(const Shape& shape, Vector2 end, std::vector<RayHit>& hits, const CollisionFilter& filter) const
+{
+	hits.clear();
+	AABB swept = sweptBounds(shape.getBoundingBox(), shape.getPosition() - end);
+
+	broadphase->query(swept, [&](int userId) {
+		RayHit candidate;
+		if (findQueryCollider(userId, filter) != nullptr && castShapeAt(shape, end, userId, candidate))
+			hits.push_back(candidate);
+		return true;
+	});
+
+	std::sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) { return a.distance < b.distance; });
+	return static_cast<int>(hits.size());
+}
+
+int WLUW::WWorld::queryAABB(const AABB& aabb, std::vector<int>& ids, const CollisionFilter& filter) const
+{
+	ids.clear();
+
+	// Wrapped in std::ref so the std::function the broadphase takes doesn't allocate a copy of the captures
+	auto visit = [&](int userId) {
+		const WCollider* collider = findQueryCollider(userId, filter);
+		if (collider != nullptr && collider->getBoundingBox().overlaps(aabb))
+			ids.push_back(userId);
+		return true;
+	};
+	broadphase->query(aabb, std::ref(visit));
+
+	return static_cast<int>(ids.size());
+}
+
+int WLUW::WWorld::queryCircle(Vector2 centre, double radius, std::vector<int>& ids, const CollisionFilter& filter) const
+{
+	// Circles keep no points, so this doesn't allocate
+	return queryShape(Shape(radius, centre), ids, filter);
+}
+
+int WLUW::WWorld::queryShape(const Shape& shape, std::vector<int>& ids, const CollisionFilter& filter) const
+{
+	ids.clear();
+
+	auto visit = [&](int userId) {
+		const WCollider* collider = findQueryCollider(userId, filter);
+		if (collider != nullptr && overlaps(shape, *collider))
+			ids.push_back(userId);
+		return true;
+	};
+	broadphase->query(shape.getBoundingBox(), std::ref(visit));
+
+	return static_cast<int>(ids.size());
+}
+
+int WLUW::WWorld::queryPoint(Vector2 point, std::vector<int>& ids, const CollisionFilter& filter) const
+{
+	ids.clear();
+
+	auto visit = [&](int userId) {
+		const WCollider* collider = findQueryCollider(userId, filter);
+		if (collider != nullptr && collider->containsPoint(point))
+			ids.push_back(userId);
+		return true;
+	};
+	broadphase->query(AABB(point, point), std::ref(visit));
+
+	return static_cast<int>(ids.size());
+}
+
+const WLUW::WCollider* WLUW::WWorld::findQueryCollider(int userId, const CollisionFilter& filter) const
+{
+	const WCollider* collider = colliders[colliderIndices.at(userId)].collider;
+	return filter.collidesWith(collider->getFilter()) ? collider : nullptr;
+}
+
+bool WLUW::WWorld::castShapeAt(const Shape& shape, Vector2 end, int userId, RayHit& hit) const
+{
+	const WCollider& collider = *colliders[colliderIndices.at(userId)].collider;
+	hit.id = userId;
+
+	const CompoundShape* compound = collider.getCompound();
+	if (compound == nullptr)
+		return castShapeAgainst(shape, end, collider.getShape(), hit);
+
+	// Only children whose boxes lie along the path can be hit, the nearest of them is the hit
+	bool found = false;
+	compound->queryChildren(sweptBounds(shape.getBoundingBox(), shape.getPosition() - end), [&](int child) {
+		RayHit candidate;
+		if (castShapeAgainst(shape, end, compound->getChild(child), candidate) && (!found || candidate.distance < hit.distance))
+		{
+			hit.point = candidate.point;
+			hit.normal = candidate.normal;
+			hit.distance = candidate.distance;
+			found = true;
+		}
+		return true;
+	});
+
+	return found;
+}
+
+void WLUW::WWorld::updateProxies()
+{
+	// Bring the broadphase up to date with wherever the objects moved to
+	for (ColliderEntry& entry : colliders)
+	{
+		WCollider* collider = entry.collider;
+		Vector2 position = collider->getPosition();
+		Vector2 rotation = collider->getTransform().getRotation();
+		bool const translated = position != entry.lastPosition;
+		bool const moved = translated || rotation != entry.lastRotation;
+
+		// Moving a sleeping body's shape away from its body wakes it. Colliders without a body are only awake while they move
+		if (entry.body != nullptr && moved && !entry.body->isAwake() && entry.body->getPosition() != position)
+			entry.body->setAwake(true);
+
+		bool const awake = entry.body != nullptr ? entry.body->isAwake() : moved;
+		if (awake != entry.proxyAwake)
+		{
+			broadphase->setProxyAwake(entry.collider->getProxyId(), awake);
+			entry.proxyAwake = awake;
+		}
+
+		if (!moved)
+			continue;
+
+		// Sweeps only follow the translation, turning in place can't tunnel far. Compounds aren't swept
+		if (collider->isContinuous() && !collider->isCompound() && translated)
+			sweeps.push_back({ static_cast<int>(&entry - colliders.data()), entry.lastPosition });
+
+		broadphase->moveProxy(collider->getProxyId(), collider->getBoundingBox(), position - entry.lastPosition);
+		entry.lastPosition = position;
+		entry.lastRotation = rotation;
+	}
+
+	// Sweep once everything is in its final place, so the sweeps see where the other colliders ended up
+	for (const Sweep& sweep : sweeps)
+		sweepCollider(sweep);
+	sweeps.clear();
+}
+
+void WLUW::WWorld::sweepCollider(const Sweep& sweep)
+{
+	ColliderEntry& entry = colliders[sweep.index];
+	Shape& shape = entry.collider->getShape();
+	Vector2 const end = shape.getPosition();
+
+	Vector2 start = sweep.start;
+	Vector2 target = end;
+
+	// Each hit stops the shape at the surface and sends what is left of the move along it, which may run into
+	// something else. A few hits cover corners, anything still left after that is dropped rather than tunnelling
+	for (int hits = 0; hits < MAX_SWEEP_HITS; hits++)
+	{
+		// Box covering the whole path of the shape
+		shape.setPosition(target);
+		AABB swept = sweptBounds(shape.getBoundingBox(), target - start);
+
+		double firstHit = 1.0;
+		Vector2 normal;
+		broadphase->query(swept, [&](int userId) {
+			if (userId == entry.objectId)
+				return true;
+
+			const WCollider& otherCollider = *colliders[colliderIndices[userId]].collider;
+			if (otherCollider.isSensor() || !entry.collider->getFilter().collidesWith(otherCollider.getFilter()))
+				return true;
+
+			// Other colliders are treated as standing still where they ended up
+			auto sweepAgainst = [&](const Shape& other) {
+				// Sliding along a surface the shape already touches isn't a hit, only moving further into it than the gap is
+				TOIResult toi = timeOfImpact(shape, start, target, other, other.getPosition(), other.getPosition());
+				if (toi.hit && toi.time < firstHit && (target - start).dot(toi.normal) > SWEEP_SKIN)
+				{
+					firstHit = toi.time;
+					normal = toi.normal;
+				}
+				return true;
+			};
+
+			// Against a compound, only the children along the path
+			if (const CompoundShape* compound = otherCollider.getCompound())
+				compound->queryChildren(swept, [&](int child) { return sweepAgainst(compound->getChild(child)); });
+			else
+				sweepAgainst(otherCollider.getShape());
+			return true;
+		});
+
+		if (firstHit >= 1.0)
+			break;
+
+		// The normal points from the shape into what it hit. Only motion into the surface is removed, so the
+		// body keeps sliding along it and can come to rest against it
+		Vector2 const stop = start + (target - start) * firstHit;
+		Vector2 const left = (target - start) * (1.0 - firstHit);
+		start = stop;
+		target = stop + left - normal * std::max(left.dot(normal), 0.0);
+
+		if (entry.body != nullptr)
+		{
+			Vector2 const velocity = entry.body->getVelocity();
+			entry.body->setVelocity(velocity - normal * std::max(velocity.dot(normal), 0.0));
+		}
+
+		// Out of hits, stay at the last one
+		if (hits == MAX_SWEEP_HITS - 1)
+			target = stop;
+	}
+
+	shape.setPosition(target);
+	if (target == end)
+		return;
+
+	broadphase->moveProxy(entry.collider->getProxyId(), shape.getBoundingBox(), target - end);
+	entry.lastPosition = target;
+}
+
+void WLUW::WWorld::syncBodyPositions()
+{
+	// Contacts may have woken bodies up, so the awake count is read every time
+	for (int i = 0; i < bodies.getAwakeCount(); i++)
+	{
+		WCollider* collider = bodyColliders[bodies.getHandle(i)];
+		if (collider == nullptr)
+			continue;
+
+		Vector2 position = collider->getPosition();
+		bodies.positionX[i] = position.x;
+		bodies.positionY[i] = position.y;
+	}
+}
+
+int WLUW::WWorld::findContact(std::uint64_t key) const
+{
+	if (contactSlots.empty())
+		return -1;
+
+	std::size_t mask = contactSlots.size() - 1;
+	for (std::size_t slot = hashContact(key, mask);; slot = (slot + 1) & mask)
+	{
+		if (contactSlots[slot] == -1)
+			return -1;
+		if (contacts[contactSlots[slot]].key == key)
+			return static_cast<int>(slot);
+	}
+}
+
+WLUW::WWorld::ContactEntry& WLUW::WWorld::findOrAddContact(std::uint64_t key)
+{
+	int found = findContact(key);
+	if (found != -1)
+		return contacts[contactSlots[found]];
+
+	// Keep the table at most half full, so probes stay short. It only grows past the most pairs ever touching at once
+	if ((contactCount + 1) * 2 > contactSlots.size())
+	{
+		contactSlots.assign(std::max<std::size_t>(MIN_CONTACT_SLOTS, contactSlots.size() * 2), -1);
+		std::size_t mask = contactSlots.size() - 1;
+
+		for (int index = 0; index < contacts.size(); index++)
+		{
+			if (contacts[index].key == NO_CONTACT)
+				continue;
+
+			std::size_t slot = hashContact(contacts[index].key, mask);
+			while (contactSlots[slot] != -1)
+				slot = (slot + 1) & mask;
+			contactSlots[slot] = index;
+		}
+	}
+
+	// Reuse an entry of a pair which stopped touching, keeping its storage for children
+	int index;
+	if (!freeContacts.empty())
+	{
+		index = freeContacts.back();
+		freeContacts.pop_back();
+	}
+	else
+	{
+		index = static_cast<int>(contacts.size());
+		contacts.emplace_back();
+	}
+
+	std::size_t mask = contactSlots.size() - 1;
+	std::size_t slot = hashContact(key, mask);
+	while (contactSlots[slot] != -1)
+		slot = (slot + 1) & mask;
+	contactSlots[slot] = index;
+	contactCount++;
+
+	ContactEntry& contact = contacts[index];
+	contact.manifold = ContactManifold();
+	contact.children.clear();
+	contact.key = key;
+	return contact;
+}
+
+void WLUW::WWorld::removeContact(int slot)
+{
+	int index = contactSlots[slot];
+	contacts[index].key = NO_CONTACT;
+	freeContacts.push_back(index);
+	contactCount--;
+
+	// Shift later entries of the probe run back into the hole, unless that would put them before their home slot
+	std::size_t mask = contactSlots.size() - 1;
+	std::size_t hole = slot;
+	for (std::size_t next = (hole + 1) & mask; contactSlots[next] != -1; next = (next + 1) & mask)
+	{
+		std::size_t home = hashContact(contacts[contactSlots[next]].key, mask);
+		if (((next - home) & mask) >= ((next - hole) & mask))
+		{
+			contactSlots[hole] = contactSlots[next];
+			hole = next;
+		}
+	}
+	contactSlots[hole] = -1;
+}
+
+void WLUW::WWorld::keepChildManifolds(ContactEntry& contact)
+{
+	// Child pairs are matched to last update's by their indices, then by feature within each manifold
+	for (ChildContact& child : childContacts)
+	{
+		for (const ChildContact& previous : contact.children)
+		{
+			if (previous.childA == child.childA && previous.childB == child.childB)
+			{
+				child.manifold.warmStart(previous.manifold);
+				break;
+			}
+		}
+	}
+
+	// Swapped rather than copied, so both vectors keep their storage for the next update
+	std::swap(contact.children, childContacts);
+
+	// The deepest child pair stands in for the whole pair in getManifold
+	contact.manifold = std::max_element(contact.children.begin(), contact.children.end(), [](const ChildContact& lhs, const ChildContact& rhs) {
+		return lhs.manifold.getMaxDepth() < rhs.manifold.getMaxDepth();
+	})->manifold;
+}
+
+bool WLUW::WWorld::isContactAsleep(std::uint64_t key) const
+{
+	for (int id : { static_cast<int>(key >> 32), static_cast<int>(key & 0xFFFFFFFF) })
+	{
+		auto found = colliderIndices.find(id);
+		if (found == colliderIndices.end() || colliders[found->second].isAwake())
+			return false;
+	}
+
+	return true;
+}
+
+void WLUW::WWorld::updateSensorEvents()
+{
+	// Pairs where both sides sleep weren't tested, they overlap just as they did last update
+	for (const SensorPair& pair : previousSensorPairs)
+	{
+		if (isContactAsleep(contactKey(pair.first, pair.second)))
+			sensorPairs.push_back(pair);
+	}
+
+	std::sort(sensorPairs.begin(), sensorPairs.end());
+
+	sensorEvents.entered.clear();
+	sensorEvents.stayed.clear();
+	sensorEvents.exited.clear();
+
+	// Both lists are sorted, so a single merge splits them into pairs which entered, stayed and exited
+	auto current = sensorPairs.begin();
+	auto previous = previousSensorPairs.begin();
+	while (current != sensorPairs.end() || previous != previousSensorPairs.end())
+	{
+		if (previous == previousSensorPairs.end() || (current != sensorPairs.end() && *current < *previous))
+			sensorEvents.entered.push_back(*current++);
+		else if (current == sensorPairs.end() || *previous < *current)
+			sensorEvents.exited.push_back(*previous++);
+		else
+		{
+			sensorEvents.stayed.push_back(*current++);
+			previous++;
+		}
+	}
+
+	std::swap(sensorPairs, previousSensorPairs);
+	sensorPairs.clear();
+}
+
+void WLUW::WWorld::registerCollider(WObject& object)
+{
+	WCollider* collider = object.getComponent<WCollider>();
+	if (collider == nullptr)
+		return;
+
+	collider->setProxyId(broadphase->createProxy(collider->getBoundingBox(), object.getId()));
+	broadphase->setProxyFilter(collider->getProxyId(), collider->getFilter());
+
+	colliderIndices[object.getId()] = static_cast<int>(colliders.size());
+	colliders.push_back({ object.getId(), collider, collider->getPosition(), collider->getTransform().getRotation(), nullptr, true });
+}
+
+void WLUW::WWorld::unregisterCollider(int id)
+{
+	auto found = colliderIndices.find(id);
+	if (found == colliderIndices.end())
+		return;
+
+	int index = found->second;
+	broadphase->destroyProxy(colliders[index].collider->getProxyId());
+	colliders[index].collider->setProxyId(-1);
+	colliderIndices.erase(found);
+
+	// Swap the last collider into the hole
+	if (index != colliders.size() - 1)
+	{
+		colliders[index] = colliders.back();
+		colliderIndices[colliders[index].objectId] = index;
+	}
+	colliders.pop_back();
+}
+
+void WLUW::WWorld::registerBody(WObject& object)
+{
+	WRigidBody* body = object.getComponent<WRigidBody>();
+	if (body == nullptr)
+		return;
+
+	// The collider's shape decides where the body starts and how it is turned, if there is one
+	WCollider* collider = object.getComponent<WCollider>();
+	if (collider != nullptr)
+		body->setAngle(collider->getTransform().getAngle());
+	body->attach(bodies, collider != nullptr ? collider->getPosition() : body->getPosition());
+
+	if (body->getHandle() >= bodyColliders.size())
+		bodyColliders.resize(body->getHandle() + 1, nullptr);
+	bodyColliders[body->getHandle()] = collider;
+
+	if (collider != nullptr)
+		colliders[colliderIndices[object.getId()]].body = body;
+}
+
+void WLUW::WWorld::unregisterBody(WObject& object)
+{
+	WRigidBody* body = object.getComponent<WRigidBody>();
+	if (body == nullptr || !body->isAttached())
+		return;
+
+	bodyColliders[body->getHandle()] = nullptr;
+	body->detach();
+}
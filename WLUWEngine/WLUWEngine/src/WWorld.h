@@ -11,13 +11,41 @@
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <thread>
+#include <unordered_map>
 
+#include "CollisionScratch.h"
+#include "CompoundShape.h"
+#include "ContactManifold.h"
+#include "WBodyPool.h"
+#include "WBroadphase.h"
+#include "WCollider.h"
+#include "WContactSolver.h"
+#include "WDynamicTree.h"
 #include "WObject.h"
+#include "WRigidBody.h"
 
 namespace WLUW
 {
+	/* Object ID of a sensor, then of the object overlapping it */
+	using SensorPair = std::pair<int, int>;
+
+	/**
+	 * \struct SensorEvents
+	 * \brief Changes in what overlaps the sensors since the previous collision update. Each list is sorted
+	 */
+	struct SensorEvents
+	{
+		std::vector<SensorPair> entered;	/* Pairs which started overlapping */
+		std::vector<SensorPair> stayed;		/* Pairs which overlapped last update and still do */
+		std::vector<SensorPair> exited;		/* Pairs which stopped overlapping, or whose object was removed */
+	};
+
 	/**
 	 * \class WWorld WWorld.h
 	 * \brief Game world manager
@@ -32,8 +60,9 @@ namespace WLUW
 		/**
 		 * \brief Default constructor
 		 */
-		WWorld()
+		WWorld() : broadphase(std::make_unique<WDynamicTree>())
 		{
+			solver.setThreadCount(static_cast<int>(std::thread::hardware_concurrency()));
 		}
 
 		//////////////////////
@@ -41,7 +70,7 @@ namespace WLUW
 		//////////////////////
 		
 		/**
-		 * \brief Add dynamic (moveable) WObject to world
+		 * \brief Add dynamic (moveable) WObject to world. If the object has a WCollider attached, it is added to the broadphase
 		 * 
 		 * \param object WObject to add
 		 */
@@ -56,13 +85,304 @@ namespace WLUW
 		std::unique_ptr<WLUW::WObject> removeWorldObject(int id);
 
 		/**
-		 * \brief Rudimentary collision detection for all dynamic objects. Should be replaced by component system
-		 * \todo Replace with components system
+		 * \brief Replace the broadphase. Every collider in the world is moved into the new broadphase
+		 * 
+		 * \param newBroadphase broadphase to use
+		 */
+		void setBroadphase(std::unique_ptr<WBroadphase> newBroadphase);
+
+		/**
+		 * \brief Change the collision layers of an object's collider. Pairs the new filter rejects stop being
+		 * reported from the next update
+		 *
+		 * \param id ID of the object
+		 * \param filter layers the collider is on and collides with
 		 */
-		//void doCollisionDetection(double deltaTime);
+		void setCollisionFilter(int id, const CollisionFilter& filter);
+
+		/**
+		 * \brief Rudimentary collision detection for all objects with a WCollider. Updates the broadphase with
+		 * the current collider positions, then runs the narrowphase on each overlapping pair. Continuous colliders
+		 * are swept from their previous position first and stopped at the first shape in their way. Pairs where
+		 * neither object has a dynamic rigid body are pushed apart directly, the rest are left to the contact
+		 * solver in step. Sleeping bodies, and colliders without a body which didn't move, are skipped unless
+		 * something awake touches them, which wakes them up
+		 */
+		void doCollisionDetection();
+
+		/**
+		 * \brief Advance every rigid body by one time step. Forces and gravity are applied, contacts are resolved
+		 * with impulses, then the bodies are moved by their new velocities. Continuous colliders are swept along
+		 * that move and their bodies stopped at the first shape in the way. Islands of bodies which stayed still
+		 * for long enough are put to sleep and cost nothing until something wakes them. The state before the step
+		 * is kept for rendering between steps, see WRigidBody::getInterpolatedPosition
+		 *
+		 * \param deltaTime time step
+		 */
+		void step(double deltaTime);
+
+		/**
+		 * \brief Set the acceleration applied to every dynamic body
+		 *
+		 * \param newGravity gravity
+		 */
+		void setGravity(Vector2 newGravity) { gravity = newGravity; };
+
+		/**
+		 * \brief Set the maximum number of threads the contact solver spreads islands across. Results are the
+		 * same for any thread count
+		 *
+		 * \param count thread count, defaults to the number of hardware threads
+		 */
+		void setThreadCount(int count) { solver.setThreadCount(count); };
+
+		/**
+		 * \brief Set the function which receives the sensor events. It is called once at the end of each step
+		 * with every event of that step, never from inside the narrowphase
+		 *
+		 * \param callback receives the events, empty to stop receiving them
+		 */
+		void setSensorCallback(std::function<void(const SensorEvents&)> callback) { sensorCallback = std::move(callback); };
+
+		/////////////////////
+		//// Getter Methods
+		/////////////////////
+
+		/**\return broadphase used for collision detection */
+		WBroadphase& getBroadphase() { return *broadphase; };
+
+		/**\return gravity applied to dynamic bodies */
+		Vector2 getGravity() const { return gravity; };
+
+		/**\return state of every rigid body in the world */
+		WBodyPool& getBodies() { return bodies; };
+
+		/**\return contact solver used by step */
+		WContactSolver& getSolver() { return solver; };
+
+		/**\return overlapping pairs found by the last call to doCollisionDetection */
+		std::vector<BroadphasePair> const& getPairs() const { return pairs; };
+
+		/**
+		 * \brief Get the contacts between two objects from the last call to doCollisionDetection
+		 *
+		 * \param idA ID of one object
+		 * \param idB ID of the other object
+		 * \return contact manifold, with normal and features relative to the object with the lower ID, or nullptr if they aren't touching.
+		 * For a pair involving a compound, the manifold of its deepest touching pair of children
+		 */
+		const ContactManifold* getManifold(int idA, int idB) const;
+
+		/**\return sensor events found by the last call to doCollisionDetection */
+		const SensorEvents& getSensorEvents() const { return sensorEvents; };
+
+		/////////////////////
+		//// Query Methods
+		/////////////////////
+
+		/**
+		 * \brief Find the first collider a ray hits. Colliders the ray starts inside are ignored
+		 *
+		 * \param ray ray to cast, its direction must be unit length
+		 * \param hit set to the nearest hit, with the ID of the object hit
+		 * \param filter only colliders this filter collides with are tested
+		 * \return true if anything was hit
+		 */
+		bool raycast(const Ray& ray, RayHit& hit, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find every collider a ray hits
+		 *
+		 * \param ray ray to cast, its direction must be unit length
+		 * \param hits cleared, then filled with one hit per collider, nearest first
+		 * \param filter only colliders this filter collides with are tested
+		 * \return number of hits
+		 */
+		int raycastAll(const Ray& ray, std::vector<RayHit>& hits, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find the first collider a line segment hits
+		 *
+		 * \param start start of the segment
+		 * \param end end of the segment
+		 * \param hit set to the nearest hit. Its distance is measured from start
+		 * \param filter only colliders this filter collides with are tested
+		 * \return true if anything was hit
+		 */
+		bool segmentCast(Vector2 start, Vector2 end, RayHit& hit, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Cast many rays in a single walk of the broadphase, cheaper than casting them one at a time
+		 * when the rays are close together, like a fan of sight lines
+		 *
+		 * \param rays rays to cast, their directions must be unit length
+		 * \param hits resized to match rays and filled with the nearest hit of each. Rays which hit nothing get an ID of -1
+		 * \param filter only colliders this filter collides with are tested
+		 */
+		void raycastBatch(const std::vector<Ray>& rays, std::vector<RayHit>& hits, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find the first collider a shape hits when moved in a straight line from where it is. Colliders
+		 * the shape already overlaps are ignored, so an object's own shape can be cast
+		 *
+		 * \param shape shape to move
+		 * \param end position the shape is moved to
+		 * \param hit set to the nearest hit. The distance is how far the shape got before touching
+		 * \param filter only colliders this filter collides with are tested
+		 * \return true if anything was hit
+		 */
+		bool shapeCast(const Shape& shape, Vector2 end, RayHit& hit, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find every collider a shape hits when moved in a straight line from where it is
+		 *
+		 * \param shape shape to move
+		 * \param end position the shape is moved to
+		 * \param hits cleared, then filled with one hit per collider, nearest first
+		 * \param filter only colliders this filter collides with are tested
+		 * \return number of hits
+		 */
+		int shapeCastAll(const Shape& shape, Vector2 end, std::vector<RayHit>& hits, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find every object whose collider's bounding box overlaps a box. Like findPairs, the output is
+		 * cleared and refilled, and only allocates when it lacks the capacity for every object found. Reusing the
+		 * same vector every frame, or reserving it up front, keeps the queries from allocating
+		 *
+		 * \param aabb box to search
+		 * \param ids cleared, then filled with the IDs of the objects found. Only grows if it lacks the capacity
+		 * \param filter only colliders this filter collides with are reported
+		 * \return number of objects found
+		 */
+		int queryAABB(const AABB& aabb, std::vector<int>& ids, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find every object whose collider overlaps a circle
+		 *
+		 * \param centre centre of the circle
+		 * \param radius radius of the circle
+		 * \param ids cleared, then filled with the IDs of the objects found. Only grows if it lacks the capacity
+		 * \param filter only colliders this filter collides with are reported
+		 * \return number of objects found
+		 */
+		int queryCircle(Vector2 centre, double radius, std::vector<int>& ids, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find every object whose collider overlaps a shape. Touching counts as overlapping
+		 *
+		 * \param shape shape to search with, in world space
+		 * \param ids cleared, then filled with the IDs of the objects found. Only grows if it lacks the capacity
+		 * \param filter only colliders this filter collides with are reported
+		 * \return number of objects found
+		 */
+		int queryShape(const Shape& shape, std::vector<int>& ids, const CollisionFilter& filter = CollisionFilter()) const;
+
+		/**
+		 * \brief Find every object whose collider contains a point
+		 *
+		 * \param point world-space point
+		 * \param ids cleared, then filled with the IDs of the objects found. Only grows if it lacks the capacity
+		 * \param filter only colliders this filter collides with are reported
+		 * \return number of objects found
+		 */
+		int queryPoint(Vector2 point, std::vector<int>& ids, const CollisionFilter& filter = CollisionFilter()) const;
 
 	private:
+		/**
+		 * \struct ColliderEntry
+		 * \brief Collider registered in the broadphase
+		 */
+		struct ColliderEntry
+		{
+			int objectId;			/* ID of the owning object */
+			WCollider* collider;	/* Collider component of the object */
+			Vector2 lastPosition;	/* Shape position at the last broadphase update */
+			Vector2 lastRotation;	/* Cosine and sine of the shape rotation at the last broadphase update */
+			WRigidBody* body;		/* Rigid body of the object, nullptr if it has none */
+			bool proxyAwake;		/* Whether the broadphase proxy is marked awake */
+
+			/**\return true if the collider's body is awake, or for colliders without a body, if it moved this update */
+			bool isAwake() const { return body != nullptr ? body->isAwake() : proxyAwake; };
+
+			/**\return true if touching the collider should wake a sleeping body. Static bodies only do while they move */
+			bool canWake() const
+			{
+				if (body == nullptr || !body->isAwake())
+					return isAwake();
+				return body->getInverseMass() > 0.0 || body->getInverseInertia() > 0.0
+					|| body->getVelocity() != Vector2(0, 0) || body->getAngularVelocity() != 0.0;
+			}
+		};
+
+		/**
+		 * \struct Sweep
+		 * \brief Continuous collider which moved during this update
+		 */
+		struct Sweep
+		{
+			int index;		/* Index in colliders */
+			Vector2 start;	/* Position before the move */
+		};
+
+		static constexpr std::uint64_t NO_CONTACT = ~std::uint64_t(0);	/* Key of unused contact entries */
+
+		/**
+		 * \struct ContactEntry
+		 * \brief Manifold of a touching pair, kept between updates for warm starting
+		 */
+		struct ContactEntry
+		{
+			ContactManifold manifold;			/* Contacts from the last update the pair touched. For compounds, of the deepest child pair */
+			std::vector<ChildContact> children;	/* Contacts of each touching pair of children, empty unless a compound is involved */
+			std::uint64_t key = NO_CONTACT;		/* Key of the pair, NO_CONTACT while the entry is unused */
+			int lastUpdate = 0;					/* Update the manifold was last refreshed in */
+		};
+
+		static std::uint64_t contactKey(int idA, int idB)
+		{
+			if (idA > idB)
+				std::swap(idA, idB);
+			return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(idA)) << 32) | static_cast<std::uint32_t>(idB);
+		}
+
+		void registerCollider(WObject& object);
+		void unregisterCollider(int id);
+		void registerBody(WObject& object);
+		void unregisterBody(WObject& object);
+		void updateProxies();
+		void sweepCollider(const Sweep& sweep);
+		void syncBodyPositions();
+		const WCollider* findQueryCollider(int userId, const CollisionFilter& filter) const;
+		bool castShapeAt(const Shape& shape, Vector2 end, int userId, RayHit& hit) const;
+		int findContact(std::uint64_t key) const;
+		ContactEntry& findOrAddContact(std::uint64_t key);
+		void removeContact(int slot);
+		void keepChildManifolds(ContactEntry& contact);
+		bool isContactAsleep(std::uint64_t key) const;
+		void updateSensorEvents();
+
 		std::vector<std::unique_ptr<WLUW::WObject>> worldObjects;
+		std::unique_ptr<WBroadphase> broadphase;		/* Broadphase tracking every collider */
+		std::vector<ColliderEntry> colliders;			/* Registered colliders */
+		std::unordered_map<int, int> colliderIndices;	/* Object ID to index in colliders */
+		std::vector<BroadphasePair> pairs;				/* Pairs found by the last broadphase update */
+		CollisionScratch scratch;						/* Narrowphase working memory, reused every update */
+		std::vector<ChildContact> childContacts;		/* Manifolds of the compound pair being tested */
+		std::vector<Sweep> sweeps;						/* Continuous colliders to sweep this update */
+		std::deque<ContactEntry> contacts;				/* Manifolds of touching pairs. Entries never move, and are reused once their pair stops touching */
+		std::vector<int> freeContacts;					/* Unused entries of contacts */
+		std::vector<int> contactSlots;					/* Open-addressed table of indices in contacts, keyed by object IDs. -1 if empty */
+		int contactCount = 0;							/* Entries of contacts in use */
+		int updateCount = 0;							/* Number of collision updates run so far */
+		WBodyPool bodies;								/* Rigid body state */
+		std::vector<WCollider*> bodyColliders;			/* Collider of each body, indexed by body handle. nullptr if it has none */
+		Vector2 gravity;								/* Acceleration applied to dynamic bodies */
+		WContactSolver solver;							/* Resolves contacts between bodies */
+		std::vector<SolverContact> solverContacts;		/* Contacts found by the last collision update which involve a dynamic body */
+		std::vector<SensorPair> sensorPairs;			/* Sensor overlaps found this update */
+		std::vector<SensorPair> previousSensorPairs;	/* Sensor overlaps of the last update, sorted */
+		SensorEvents sensorEvents;						/* Events of the last update */
+		std::function<void(const SensorEvents&)> sensorCallback;	/* Receives the events after each step */
 	};
 }
 
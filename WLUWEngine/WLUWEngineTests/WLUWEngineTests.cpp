@@ -1,12 +1,41 @@
 #include "pch.h"
 #include "CppUnitTest.h"
+#include "CollisionKernels.h"
+#include "CompoundShape.h"
+#include "ContactManifold.h"
+#include "ConvexDecomposition.h"
+#include "Fixed.h"
+#include "GJK.h"
+#include "Shape.h"
+#include "ShapeBatch.h"
+#include "TimeOfImpact.h"
+#include "Transform2D.h"
 #include "Vector2.h"
+#include "Vector2Array.h"
+#include "WCollider.h"
 #include "WComponentBase.h"
 #include "WObject.h"
 #include "TypeIdManager.h"
+#include "WBodyPool.h"
+#include "WContactSolver.h"
+#include "WDynamicTree.h"
+#include "WGameLoop.h"
+#include "WLayeredBroadphase.h"
+#include "WRigidBody.h"
+#include "WSpatialHashGrid.h"
+#include "WSweepAndPrune.h"
+#include "WWorld.h"
 #include "specializations.h"
 
 #include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <limits>
+#include <string>
+#include <random>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -134,6 +163,964 @@ namespace WLUWEngineTests
 			Assert::AreEqual(v.x, v[0]);
 			Assert::AreEqual(v.y, v[1]);
 		}
+
+		TEST_METHOD(Constexpr_T)
+		{
+			constexpr WLUW::Vector2f v = WLUW::Vector2f(3.0f, 4.0f) * 2.0f - WLUW::Vector2f(1.0f, 1.0f);
+			static_assert(v.lengthSquared() == 74.0f);
+			static_assert(noexcept(v + v) && noexcept(v.dot(v)) && noexcept(v / 2.0f));
+			static_assert(!noexcept(WLUW::Vector2Fixed() / WLUW::Fixed(2)));
+			static_assert(sizeof(WLUW::Vector2f) == 2 * sizeof(float));
+
+			Assert::AreEqual(74.0f, v.lengthSquared());
+		}
+
+		TEST_METHOD(FastNormalize_T)
+		{
+			WLUW::Vector2f f = WLUW::Vector2f(-0.73f, 9.383f).fastNormalize();
+			Assert::AreEqual(1.0f, f.size(), 1e-5f);
+			Assert::AreEqual(-0.73f / WLUW::Vector2f(-0.73f, 9.383f).size(), f.x, 1e-5f);
+
+			WLUW::Vector2 d = WLUW::Vector2(-0.73, 9.383).fastNormalize();
+			Assert::AreEqual(1.0, d.size(), 1e-12);
+
+			WLUW::Vector2Fixed q = WLUW::Vector2Fixed(3, 4).fastNormalize();
+			Assert::AreEqual(0.6, q.x.toDouble(), 1e-4);
+			Assert::AreEqual(0.8, q.y.toDouble(), 1e-4);
+
+			// Zero has no direction
+			Assert::AreEqual(0.0f, WLUW::Vector2f().fastNormalize().x);
+			Assert::AreEqual(0.0f, WLUW::Vector2f().fastNormalize().y);
+		}
+	};
+
+	TEST_CLASS(Vector2Array_Tests)
+	{
+	public:
+		TEST_METHOD(KernelsMatchVector2_T)
+		{
+			std::mt19937 rng(5);
+			std::uniform_real_distribution<double> coord(-10.0, 10.0);
+			WLUW::Vector2 axis = WLUW::Vector2(0.6, -0.8);
+			WLUW::Vector2 xAxis(std::cos(0.3), std::sin(0.3));
+			WLUW::Vector2 yAxis = xAxis.normal();
+			WLUW::Vector2 offset(1.5, -2.25);
+
+			// Odd sizes leave remainders after the SIMD lanes
+			for (int count = 1; count <= 11; count++)
+			{
+				std::vector<WLUW::Vector2> points(count), velocities(count);
+				for (int i = 0; i < count; i++)
+				{
+					points[i] = WLUW::Vector2(coord(rng), coord(rng));
+					velocities[i] = WLUW::Vector2(coord(rng), coord(rng));
+				}
+				points[count / 2] = WLUW::Vector2();
+
+				for (int level = 0; level <= static_cast<int>(WLUW::getSimdLevel()); level++)
+				{
+					WLUW::SimdLevel simd = static_cast<WLUW::SimdLevel>(level);
+					WLUW::Vector2Array a, v, rotated, unit;
+					a.assign(points.data(), count);
+					v.assign(velocities.data(), count);
+
+					rotated.transform(a, xAxis, yAxis, offset, simd);
+					unit = a;
+					unit.normalize(simd);
+					std::vector<double> dots(count);
+					a.dot(axis, dots.data(), simd);
+					std::pair<double, double> projection = a.projectOntoAxis(axis, simd);
+					WLUW::AABB bounds = a.getBounds(simd);
+					a.add(v, 0.5, simd);
+					a.scale(2.0, simd);
+					a.add(offset, simd);
+
+					double min = std::numeric_limits<double>::max(), max = -min;
+					WLUW::AABB box(points[0], points[0]);
+					for (int i = 0; i < count; i++)
+					{
+						WLUW::Vector2 p = points[i];
+						box = WLUW::AABB::combine(box, WLUW::AABB(p, p));
+						Assert::AreEqual(((p + velocities[i] * 0.5) * 2.0) + offset, a.get(i));
+						Assert::AreEqual(xAxis * p.x + yAxis * p.y + offset, rotated.get(i));
+						Assert::AreEqual(p == WLUW::Vector2() ? p : p.normalized(), unit.get(i));
+						Assert::AreEqual(axis.dot(p), dots[i]);
+						min = std::min(min, axis.dot(p));
+						max = std::max(max, axis.dot(p));
+					}
+
+					Assert::AreEqual(min, projection.first);
+					Assert::AreEqual(max, projection.second);
+					Assert::AreEqual(box.min, bounds.min);
+					Assert::AreEqual(box.max, bounds.max);
+				}
+			}
+		}
+	};
+
+	TEST_CLASS(Shape_Tests)
+	{
+	public:
+		static WLUW::Shape makeBox(WLUW::Vector2 pos, double halfSize)
+		{
+			std::vector<WLUW::Vector2> points = {
+				WLUW::Vector2(-halfSize, -halfSize),
+				WLUW::Vector2(halfSize, -halfSize),
+				WLUW::Vector2(halfSize, halfSize),
+				WLUW::Vector2(-halfSize, halfSize)
+			};
+			return WLUW::Shape(points, pos);
+		}
+
+		TEST_METHOD(CircleCircleCollision_T)
+		{
+			WLUW::Shape a(1.0, WLUW::Vector2(1.5, 0));
+			WLUW::Shape b(1.0, WLUW::Vector2(0, 0));
+			auto mtv = WLUW::Shape::checkCollision(a, b);
+
+			Assert::AreEqual(0.5, mtv.second, 1e-12);
+			Assert::AreEqual(WLUW::Vector2(1, 0), mtv.first);
+		}
+
+		TEST_METHOD(CircleCircleSeparated_T)
+		{
+			WLUW::Shape a(1.0, WLUW::Vector2(3, 0));
+			WLUW::Shape b(1.0, WLUW::Vector2(0, 0));
+
+			Assert::IsTrue(isnan(WLUW::Shape::checkCollision(a, b).second));
+		}
+
+		TEST_METHOD(PolygonPolygonCollision_T)
+		{
+			WLUW::Shape a = makeBox(WLUW::Vector2(0, 1.5), 1.0);
+			WLUW::Shape b = makeBox(WLUW::Vector2(0.2, 0), 1.0);
+			auto mtv = WLUW::Shape::checkCollision(a, b);
+
+			// Shallowest push is straight up, out of b
+			Assert::AreEqual(0.5, mtv.second, 1e-12);
+			Assert::AreEqual(0.0, mtv.first.x, 1e-12);
+			Assert::AreEqual(1.0, mtv.first.y, 1e-12);
+		}
+
+		TEST_METHOD(PolygonPolygonSeparated_T)
+		{
+			WLUW::Shape a = makeBox(WLUW::Vector2(3, 0), 1.0);
+			WLUW::Shape b = makeBox(WLUW::Vector2(0, 0), 1.0);
+
+			Assert::IsTrue(isnan(WLUW::Shape::checkCollision(a, b).second));
+		}
+
+		TEST_METHOD(CirclePolygonVertexRegion_T)
+		{
+			// Circle sits diagonally off the top right corner of the box
+			WLUW::Shape circle(1.0, WLUW::Vector2(1.5, 1.5));
+			WLUW::Shape box = makeBox(WLUW::Vector2(0, 0), 1.0);
+			auto mtv = WLUW::Shape::checkCollision(circle, box);
+
+			Assert::AreEqual(1.0 - sqrt(0.5), mtv.second, 1e-12);
+			Assert::AreEqual(sqrt(0.5), mtv.first.x, 1e-12);
+			Assert::AreEqual(sqrt(0.5), mtv.first.y, 1e-12);
+
+			// Swapping the order flips the axis
+			auto flipped = WLUW::Shape::checkCollision(box, circle);
+			Assert::AreEqual(mtv.second, flipped.second, 1e-12);
+			Assert::AreEqual(-mtv.first.x, flipped.first.x, 1e-12);
+		}
+
+		TEST_METHOD(CirclePolygonCornerMiss_T)
+		{
+			// Inside the reach of both edge normals, but too far from the corner
+			WLUW::Shape circle(1.0, WLUW::Vector2(1.8, 1.8));
+			WLUW::Shape box = makeBox(WLUW::Vector2(0, 0), 1.0);
+
+			Assert::IsTrue(isnan(WLUW::Shape::checkCollision(circle, box).second));
+		}
+
+		TEST_METHOD(GJKMatchesSAT_T)
+		{
+			std::mt19937 rng(3);
+			std::uniform_real_distribution<double> coord(0.0, 4.0);
+			std::uniform_real_distribution<double> angle(0.0, 6.283185307179586);
+
+			// Two 64-gons, past the threshold where AUTO switches to GJK
+			auto makeRound = [](WLUW::Vector2 pos, double rotation) {
+				std::vector<WLUW::Vector2> points;
+				for (int j = 0; j < 64; j++)
+					points.emplace_back(2.0 * cos(rotation + 6.283185307179586 * j / 64), sin(rotation + 6.283185307179586 * j / 64));
+				return WLUW::Shape(points, pos);
+			};
+
+			WLUW::CollisionScratch scratch;
+			for (int i = 0; i < 200; i++)
+			{
+				WLUW::Shape a = makeRound(WLUW::Vector2(coord(rng), coord(rng)), angle(rng));
+				WLUW::Shape b = i % 4 == 0 ? WLUW::Shape(1.0, WLUW::Vector2(coord(rng), coord(rng))) : makeRound(WLUW::Vector2(coord(rng), coord(rng)), angle(rng));
+
+				auto sat = WLUW::Shape::checkCollision(a, b, scratch, WLUW::CollisionAlgorithm::SAT);
+				auto gjk = WLUW::Shape::checkCollision(a, b, scratch, WLUW::CollisionAlgorithm::GJK);
+
+				Assert::AreEqual(isnan(sat.second), isnan(gjk.second));
+				if (isnan(sat.second))
+					continue;
+
+				Assert::AreEqual(sat.second, gjk.second, 1e-9);
+				Assert::IsTrue(sat.first.dot(gjk.first) > 1.0 - 1e-6);
+			}
+		}
+
+		TEST_METHOD(SupportCollinear_T)
+		{
+			// Square with a vertex halfway along each edge, so every axis-aligned direction meets a level stretch
+			std::vector<WLUW::Vector2> points = {
+				WLUW::Vector2(-1, -1), WLUW::Vector2(0, -1), WLUW::Vector2(1, -1), WLUW::Vector2(1, 0),
+				WLUW::Vector2(1, 1), WLUW::Vector2(0, 1), WLUW::Vector2(-1, 1), WLUW::Vector2(-1, 0)
+			};
+			WLUW::Shape shape(points);
+
+			// Starting in the middle of the opposite edge, both neighbours tie
+			Assert::AreEqual(1.0, shape.getWorldPoints()[shape.supportIndex(WLUW::Vector2(1, 0), 7)].x);
+			Assert::AreEqual(1.0, shape.getWorldPoints()[shape.supportIndex(WLUW::Vector2(0, 1), 1)].y);
+
+			// Every start and direction reaches the peak
+			for (int start = 0; start < 8; start++)
+			{
+				for (int i = 0; i < 16; i++)
+				{
+					WLUW::Vector2 direction(cos(6.283185307179586 * i / 16), sin(6.283185307179586 * i / 16));
+
+					double peak = -std::numeric_limits<double>::max();
+					for (int j = 0; j < 8; j++)
+						peak = std::max(peak, direction.dot(shape.getWorldPoints()[j]));
+
+					Assert::AreEqual(peak, direction.dot(shape.getWorldPoints()[shape.supportIndex(direction, start)]));
+				}
+			}
+
+			// GJK and SAT agree on depth and axis
+			WLUW::CollisionScratch scratch;
+			WLUW::Shape box = makeBox(WLUW::Vector2(1.5, 0.25), 1.0);
+			auto sat = WLUW::Shape::checkCollision(box, shape, scratch, WLUW::CollisionAlgorithm::SAT);
+			auto gjk = WLUW::Shape::checkCollision(box, shape, scratch, WLUW::CollisionAlgorithm::GJK);
+
+			Assert::AreEqual(0.5, sat.second, 1e-12);
+			Assert::AreEqual(sat.second, gjk.second, 1e-9);
+			Assert::AreEqual(1.0, gjk.first.x, 1e-9);
+			Assert::AreEqual(0.0, gjk.first.y, 1e-9);
+		}
+
+		TEST_METHOD(GJKDistance_T)
+		{
+			WLUW::Shape a = makeBox(WLUW::Vector2(0, 0), 1.0);
+			WLUW::Shape b = makeBox(WLUW::Vector2(3, 0.5), 1.0);
+			WLUW::Shape circle(1.0, WLUW::Vector2(0, 4));
+
+			Assert::AreEqual(1.0, WLUW::gjkDistance(a, b).distance, 1e-12);
+			Assert::AreEqual(2.0, WLUW::gjkDistance(a, circle).distance, 1e-12);
+			Assert::AreEqual(0.0, WLUW::gjkDistance(a, makeBox(WLUW::Vector2(1, 1), 1.0)).distance);
+		}
+
+		TEST_METHOD(TimeOfImpact_T)
+		{
+			// Thin wall, and a bullet which would jump clean over it in one step
+			std::vector<WLUW::Vector2> wallPoints = {
+				WLUW::Vector2(-0.01, -5), WLUW::Vector2(0.01, -5), WLUW::Vector2(0.01, 5), WLUW::Vector2(-0.01, 5)
+			};
+			WLUW::Shape wall(wallPoints);
+			WLUW::Shape bullet = makeBox(WLUW::Vector2(10, 0), 0.05);
+
+			Assert::IsTrue(isnan(WLUW::Shape::checkCollision(bullet, wall).second));
+
+			auto toi = WLUW::timeOfImpact(bullet, WLUW::Vector2(-10, 0), WLUW::Vector2(10, 0), wall, wall.getPosition(), wall.getPosition());
+			Assert::IsTrue(toi.hit);
+			Assert::AreEqual((10.0 - 0.06) / 20.0, toi.time, 1e-6);
+			Assert::AreEqual(1.0, toi.normal.x, 1e-9);
+
+			// Passing above the wall misses
+			auto miss = WLUW::timeOfImpact(bullet, WLUW::Vector2(-10, 6), WLUW::Vector2(10, 6), wall, wall.getPosition(), wall.getPosition());
+			Assert::IsFalse(miss.hit);
+		}
+
+		TEST_METHOD(Raycast_T)
+		{
+			WLUW::Shape box = makeBox(WLUW::Vector2(5, 0), 1.0);
+			WLUW::Shape circle(1.0, WLUW::Vector2(0, 5));
+			WLUW::RayHit hit;
+
+			Assert::IsTrue(box.raycast({ WLUW::Vector2(0, 0.5), WLUW::Vector2(1, 0), 10.0 }, hit));
+			Assert::AreEqual(4.0, hit.distance, 1e-12);
+			Assert::IsTrue(hit.normal == WLUW::Vector2(-1, 0));
+
+			Assert::IsTrue(circle.raycast({ WLUW::Vector2(0, 0), WLUW::Vector2(0, 1), 10.0 }, hit));
+			Assert::AreEqual(4.0, hit.distance, 1e-12);
+			Assert::AreEqual(-1.0, hit.normal.y, 1e-12);
+
+			// Too short, pointing away, passing by, and starting inside all miss
+			Assert::IsFalse(box.raycast({ WLUW::Vector2(0, 0.5), WLUW::Vector2(1, 0), 3.0 }, hit));
+			Assert::IsFalse(box.raycast({ WLUW::Vector2(0, 0.5), WLUW::Vector2(-1, 0), 10.0 }, hit));
+			Assert::IsFalse(circle.raycast({ WLUW::Vector2(1.5, 0), WLUW::Vector2(0, 1), 10.0 }, hit));
+			Assert::IsFalse(box.raycast({ WLUW::Vector2(5, 0), WLUW::Vector2(1, 0), 10.0 }, hit));
+		}
+
+		TEST_METHOD(ContainsPoint_T)
+		{
+			WLUW::Shape box = makeBox(WLUW::Vector2(5, 0), 1.0);
+			WLUW::Shape circle(1.0, WLUW::Vector2(0, 5));
+
+			Assert::IsTrue(box.containsPoint(WLUW::Vector2(5.5, -0.5)));
+			Assert::IsTrue(box.containsPoint(WLUW::Vector2(6, 1)));
+			Assert::IsFalse(box.containsPoint(WLUW::Vector2(6.1, 0)));
+			Assert::IsTrue(circle.containsPoint(WLUW::Vector2(0.6, 5.6)));
+			Assert::IsFalse(circle.containsPoint(WLUW::Vector2(0.8, 5.8)));
+		}
+
+		TEST_METHOD(Transform_T)
+		{
+			// A unit box turned 45 degrees and doubled becomes a diamond reaching sqrt(8) from its centre
+			WLUW::Transform2D transform(WLUW::Vector2(10, 0), std::atan(1.0), 2.0);
+			WLUW::Shape box = makeBox(WLUW::Vector2(), 1.0);
+			box.followTransform(&transform);
+
+			double const reach = std::sqrt(8.0);
+			Assert::AreEqual(10.0 - reach, box.getBoundingBox().min.x, 1e-12);
+			Assert::AreEqual(reach, box.getBoundingBox().max.y, 1e-12);
+			Assert::AreEqual(1.0, box.getWorldNormals()[0].size(), 1e-12);
+			Assert::AreEqual(std::sqrt(0.5), std::abs(box.getWorldNormals()[0].x), 1e-12);
+			for (int i = 0; i < 4; i++)
+				Assert::AreEqual(transform.apply(box.getPoints()[i]), box.getWorldPoints()[i]);
+
+			// Only the tip of the diamond reaches a box sitting just beyond the unrotated corner
+			WLUW::Shape other = makeBox(WLUW::Vector2(10, 3.5), 1.0);
+			auto mtv = WLUW::Shape::checkCollision(box, other);
+			Assert::AreEqual(reach - 2.5, mtv.second, 1e-9);
+			Assert::AreEqual(WLUW::Vector2(0, -1), mtv.first);
+
+			// Changing the followed transform is picked up on the next read
+			transform.setTranslation(WLUW::Vector2(20, 0));
+			Assert::AreEqual(20.0 - reach, box.getBoundingBox().min.x, 1e-12);
+			Assert::IsTrue(std::isnan(WLUW::Shape::checkCollision(box, other).second));
+
+			// Circles scale their radius
+			WLUW::Shape circle(1.0);
+			circle.setScale(3.0);
+			Assert::IsTrue(circle.containsPoint(WLUW::Vector2(0, 2.9)));
+			Assert::AreEqual(-3.0, circle.getBoundingBox().min.x);
+			Assert::ExpectException<const char*>([&]() { box.setPosition(WLUW::Vector2()); });
+		}
+
+		TEST_METHOD(CacheInvalidation_T)
+		{
+			// World-space caches must always match what the current points and transform give
+			auto matchesWorld = [](const WLUW::Shape& shape) {
+				const WLUW::Transform2D& transform = shape.getTransform();
+				WLUW::AABB box(transform.apply(shape.getPoints()[0]), transform.apply(shape.getPoints()[0]));
+				for (int i = 0; i < shape.getPoints().size(); i++)
+				{
+					WLUW::Vector2 world = transform.apply(shape.getPoints()[i]);
+					box = WLUW::AABB::combine(box, WLUW::AABB(world, world));
+					Assert::AreEqual(world, shape.getWorldPoints()[i]);
+					Assert::AreEqual(transform.rotate(shape.getNormals()[i]), shape.getWorldNormals()[i]);
+				}
+				Assert::AreEqual(box.min, shape.getBoundingBox().min);
+				Assert::AreEqual(box.max, shape.getBoundingBox().max);
+			};
+
+			WLUW::Shape box = makeBox(WLUW::Vector2(), 1.0);
+			matchesWorld(box);
+			Assert::AreEqual(size_t(2), box.getWorldAxes().size());
+
+			box.setPosition(WLUW::Vector2(3, 0));
+			matchesWorld(box);
+			Assert::AreEqual(WLUW::Vector2(2, -1), box.getBoundingBox().min);
+
+			// Pulling a corner out makes the two slanted edges distinct axes
+			box.swapPoint(2, WLUW::Vector2(2, 2));
+			matchesWorld(box);
+			Assert::AreEqual(WLUW::Vector2(5, 2), box.getBoundingBox().max);
+			Assert::AreEqual(size_t(4), box.getWorldAxes().size());
+
+			box.setRotation(std::atan(1.0) * 2.0);
+			matchesWorld(box);
+			Assert::AreEqual(1.0, box.getWorldNormals()[0].x, 1e-12);
+			Assert::AreEqual(size_t(4), box.getWorldAxes().size());
+
+			// Dropping the corner leaves a triangle, whose axes are all different
+			box.removePoint(2);
+			matchesWorld(box);
+			Assert::AreEqual(size_t(3), box.getWorldAxes().size());
+
+			box.setScale(2.0);
+			matchesWorld(box);
+
+			// Edits inside a batch show up once it ends
+			box.beginEdit();
+			box.addPoint(WLUW::Vector2(-2, 0));
+			box.endEdit();
+			matchesWorld(box);
+			Assert::AreEqual(size_t(4), box.getWorldNormals().size());
+
+			// Switching between the own transform and a followed one
+			WLUW::Transform2D body(WLUW::Vector2(-5, 5));
+			box.followTransform(&body);
+			matchesWorld(box);
+			body.setRotation(1.0);
+			matchesWorld(box);
+			box.followTransform(nullptr);
+			matchesWorld(box);
+
+			// Assigning a whole new transform counts as a change, even from one whose version matches the cache's
+			WLUW::Transform2D moved;
+			box.followTransform(&moved);
+			matchesWorld(box);
+			moved = WLUW::Transform2D(WLUW::Vector2(10, 0));
+			Assert::AreEqual(10.0, box.getPosition().x);
+			matchesWorld(box);
+			Assert::IsTrue(box.getBoundingBox().min.x > 5.0);
+
+			box.followTransform(nullptr);
+			matchesWorld(box);
+			box.setTransform(WLUW::Transform2D(WLUW::Vector2(3, 0)));
+			matchesWorld(box);
+		}
+
+		TEST_METHOD(IncrementalNormals_T)
+		{
+			// Edited shapes must match one built from scratch with the same points
+			auto matchesFresh = [](const WLUW::Shape& shape) {
+				std::vector<WLUW::Vector2> points = shape.getPoints();
+				WLUW::Shape fresh(points);
+				Assert::IsTrue(fresh.getNormals() == shape.getNormals());
+				Assert::IsTrue(fresh.getWorldAxes() == shape.getWorldAxes());
+			};
+
+			// Build an octagon one point at a time, starting from a single point
+			WLUW::Shape shape;
+			for (int i = 0; i < 8; i++)
+			{
+				double angle = i * std::atan(1.0);
+				shape.addPoint(WLUW::Vector2(std::cos(angle), std::sin(angle)) * 2.0);
+			}
+			matchesFresh(shape);
+
+			shape.insertPoint(WLUW::Vector2(2.5, 0.5), 1);
+			matchesFresh(shape);
+			shape.removePoint(0);
+			matchesFresh(shape);
+			shape.swapPoint(3, WLUW::Vector2(-1.0, 1.5));
+			matchesFresh(shape);
+
+			// Moving one corner of a triangle across the opposite edge turns it inside out
+			std::vector<WLUW::Vector2> points = { WLUW::Vector2(0, 0), WLUW::Vector2(1, 0), WLUW::Vector2(0, 1) };
+			WLUW::Shape triangle(points);
+			triangle.addPoint(WLUW::Vector2(-0.5, 0.5));
+			triangle.swapPoint(2, WLUW::Vector2(0, -1));
+			matchesFresh(triangle);
+
+			// Batches leave the normals alone until the outermost endEdit
+			std::vector<WLUW::Vector2> before = shape.getNormals();
+			shape.beginEdit();
+			shape.beginEdit();
+			shape.removePoint(2);
+			shape.addPoint(WLUW::Vector2(0, -3));
+			shape.endEdit();
+			Assert::IsTrue(before == shape.getNormals());
+			shape.endEdit();
+			Assert::IsFalse(shape.isEditing());
+			matchesFresh(shape);
+			Assert::ExpectException<const char*>([&]() { shape.endEdit(); });
+		}
+
+		TEST_METHOD(ContactManifold_T)
+		{
+			// Box resting on another, offset so one corner of each is inside the overlap
+			WLUW::Shape a = makeBox(WLUW::Vector2(0.5, 1.9), 1.0);
+			WLUW::Shape b = makeBox(WLUW::Vector2(0, 0), 1.0);
+			WLUW::CollisionScratch scratch;
+
+			WLUW::ContactManifold manifold;
+			Assert::IsTrue(WLUW::computeManifold(a, b, manifold, scratch));
+			Assert::AreEqual(2, manifold.pointCount);
+			Assert::AreEqual(0.0, manifold.normal.x, 1e-12);
+			Assert::AreEqual(1.0, manifold.normal.y, 1e-12);
+
+			double xs[2] = { manifold.points[0].position.x, manifold.points[1].position.x };
+			Assert::AreEqual(-0.5, std::min(xs[0], xs[1]), 1e-12);
+			Assert::AreEqual(1.0, std::max(xs[0], xs[1]), 1e-12);
+			Assert::AreEqual(0.1, manifold.points[0].depth, 1e-12);
+			Assert::AreEqual(0.95, manifold.points[0].position.y, 1e-12);
+
+			// Nudging the box keeps the same features, so the impulses carry over
+			manifold.points[0].normalImpulse = 3.0;
+			manifold.points[1].normalImpulse = 5.0;
+			a.setPosition(WLUW::Vector2(0.52, 1.91));
+
+			WLUW::ContactManifold next;
+			Assert::IsTrue(WLUW::computeManifold(a, b, next, scratch));
+			next.warmStart(manifold);
+			Assert::AreEqual(8.0, next.points[0].normalImpulse + next.points[1].normalImpulse);
+			Assert::AreEqual(manifold.points[0].featureId, next.points[0].featureId);
+
+			// Apart, no contacts
+			a.setPosition(WLUW::Vector2(0, 2.5));
+			Assert::IsFalse(WLUW::computeManifold(a, b, next, scratch));
+		}
+
+		TEST_METHOD(BatchMatchesScalar_T)
+		{
+			std::mt19937 rng(7);
+			std::uniform_real_distribution<double> coord(0.0, 20.0);
+			std::uniform_real_distribution<double> size(0.5, 3.0);
+			std::uniform_int_distribution<int> sides(3, 24);
+
+			// Mix of polygons with odd and even vertex counts, some past the inline axis limit, plus a few circles
+			std::vector<WLUW::Shape> shapes;
+			shapes.reserve(60);
+			for (int i = 0; i < 60; i++)
+			{
+				WLUW::Vector2 pos(coord(rng), coord(rng));
+				if (i % 10 == 0)
+				{
+					shapes.emplace_back(size(rng), pos);
+					continue;
+				}
+
+				int n = sides(rng);
+				double radius = size(rng);
+				std::vector<WLUW::Vector2> points;
+				for (int j = 0; j < n; j++)
+					points.emplace_back(radius * cos(6.283185307179586 * j / n), radius * sin(6.283185307179586 * j / n));
+				shapes.emplace_back(points, pos);
+			}
+
+			WLUW::ShapeBatch batch;
+			for (auto& shape : shapes)
+				batch.addShape(shape);
+
+			std::vector<std::pair<int, int>> pairs;
+			for (int i = 0; i < shapes.size(); i++)
+				for (int j = i + 1; j < shapes.size(); j++)
+					pairs.emplace_back(i, j);
+
+			// Every instruction set the CPU has must give bit-identical results to the scalar routine
+			WLUW::CollisionScratch scratch;
+			std::vector<std::pair<WLUW::Vector2, double>> results;
+			for (int level = 0; level <= static_cast<int>(WLUW::getSimdLevel()); level++)
+			{
+				batch.checkCollisions(pairs, results, scratch, static_cast<WLUW::SimdLevel>(level));
+				Assert::IsTrue(results.size() == pairs.size());
+
+				for (int i = 0; i < pairs.size(); i++)
+				{
+					auto expected = WLUW::Shape::checkCollision(shapes[pairs[i].first], shapes[pairs[i].second], scratch, WLUW::CollisionAlgorithm::SAT);
+					if (isnan(expected.second))
+					{
+						Assert::IsTrue(isnan(results[i].second));
+						continue;
+					}
+
+					Assert::AreEqual(expected.second, results[i].second);
+					Assert::AreEqual(expected.first, results[i].first);
+				}
+			}
+		}
+
+		TEST_METHOD(ScratchReuse_T)
+		{
+			// Boxes, rotated 20-gons whose merged axes spill past the inline buffer, 40-gons which go through GJK, and circles
+			auto makeRound = [](int sides, WLUW::Vector2 pos, double rotation) {
+				std::vector<WLUW::Vector2> points;
+				for (int j = 0; j < sides; j++)
+					points.emplace_back(cos(rotation + 6.283185307179586 * j / sides), sin(rotation + 6.283185307179586 * j / sides));
+				return WLUW::Shape(points, pos);
+			};
+
+			std::vector<WLUW::Shape> shapes;
+			for (int i = 0; i < 12; i++)
+			{
+				WLUW::Vector2 pos(0.4 * i, 0.3 * (i % 3));
+				if (i % 4 == 0)
+					shapes.push_back(makeBox(pos, 1.0));
+				else if (i % 4 == 1)
+					shapes.push_back(makeRound(20, pos, 0.05 * i));
+				else if (i % 4 == 2)
+					shapes.push_back(makeRound(40, pos, 0.05 * i));
+				else
+					shapes.emplace_back(1.0, pos);
+			}
+
+			WLUW::CollisionScratch scratch;
+			auto checkAll = [&]() {
+				int hits = 0;
+				for (int i = 0; i < shapes.size(); i++)
+					for (int j = 0; j < shapes.size(); j++)
+						hits += i != j && !isnan(WLUW::Shape::checkCollision(shapes[i], shapes[j], scratch).second);
+				return hits;
+			};
+
+			// Once warmed up, the same queries run again without the scratch growing or moving
+			int const hits = checkAll();
+			Assert::IsTrue(scratch.axes.capacity() > 0);
+			Assert::IsTrue(scratch.polytope.capacity() > 0);
+
+			auto const axesData = scratch.axes.data();
+			auto const axesCapacity = scratch.axes.capacity();
+			auto const polytopeData = scratch.polytope.data();
+			auto const polytopeCapacity = scratch.polytope.capacity();
+
+			Assert::AreEqual(hits, checkAll());
+			Assert::IsTrue(axesData == scratch.axes.data());
+			Assert::IsTrue(axesCapacity == scratch.axes.capacity());
+			Assert::IsTrue(polytopeData == scratch.polytope.data());
+			Assert::IsTrue(polytopeCapacity == scratch.polytope.capacity());
+		}
+	};
+
+	TEST_CLASS(CompoundShape_Tests)
+	{
+	public:
+		// Grid of boxes, each placed by its offset
+		static WLUW::CompoundShape makeGrid(int size, WLUW::Vector2 pos)
+		{
+			WLUW::CompoundShape compound(pos);
+			for (int x = 0; x < size; x++)
+				for (int y = 0; y < size; y++)
+					compound.addChild(Shape_Tests::makeBox(WLUW::Vector2(), 0.4), WLUW::Transform2D(WLUW::Vector2(x, y)));
+			return compound;
+		}
+
+		TEST_METHOD(ChildPairs_T)
+		{
+			WLUW::CompoundShape a = makeGrid(6, WLUW::Vector2(0, 0));
+			WLUW::CompoundShape b = makeGrid(6, WLUW::Vector2(3.5, 2.2));
+			b.setRotation(0.3);
+			Assert::IsTrue(a.getTreeHeight() <= 7);
+
+			WLUW::CollisionScratch scratch;
+			std::vector<std::pair<int, int>> pairs;
+			std::vector<WLUW::ChildContact> contacts;
+
+			// Twice, so the second pass reads boxes refitted after a move rather than freshly built
+			for (int pass = 0; pass < 2; pass++)
+			{
+				std::vector<std::pair<int, int>> expected;
+				std::pair<WLUW::Vector2, double> deepest(WLUW::Vector2(), std::nan(""));
+				int touching = 0;
+				for (int i = 0; i < a.getChildCount(); i++)
+				{
+					for (int j = 0; j < b.getChildCount(); j++)
+					{
+						if (!a.getChild(i).getBoundingBox().overlaps(b.getChild(j).getBoundingBox()))
+							continue;
+
+						expected.emplace_back(i, j);
+						std::pair<WLUW::Vector2, double> mtv = WLUW::Shape::checkCollision(a.getChild(i), b.getChild(j));
+						if (!std::isnan(mtv.second))
+						{
+							touching++;
+							if (std::isnan(deepest.second) || mtv.second > deepest.second)
+								deepest = mtv;
+						}
+					}
+				}
+
+				WLUW::CompoundShape::findChildPairs(a, b, pairs, scratch);
+				std::sort(pairs.begin(), pairs.end());
+				Assert::IsTrue(expected == pairs);
+				Assert::IsTrue(expected.size() < a.getChildCount() * b.getChildCount() / 4);
+
+				std::pair<WLUW::Vector2, double> mtv = WLUW::CompoundShape::checkCollision(a, b, scratch);
+				Assert::AreEqual(deepest.second, mtv.second);
+				Assert::AreEqual(touching, WLUW::CompoundShape::computeManifolds(a, b, contacts, scratch));
+
+				a.setPosition(WLUW::Vector2(0.3, -0.4));
+			}
+
+			// Against a lone shape, only children under it are tested
+			WLUW::Shape box = Shape_Tests::makeBox(WLUW::Vector2(2.8, 2.1), 0.5);
+			Assert::AreEqual(4, WLUW::CompoundShape::computeManifolds(a, box, contacts, scratch));
+			std::pair<WLUW::Vector2, double> compoundFirst = WLUW::CompoundShape::checkCollision(a, box, scratch);
+			Assert::IsFalse(std::isnan(compoundFirst.second));
+
+			// With the shape first, the same depth along the opposite axis, and the same touching children with normals towards the shape
+			std::pair<WLUW::Vector2, double> shapeFirst = WLUW::CompoundShape::checkCollision(box, a, scratch);
+			Assert::AreEqual(compoundFirst.second, shapeFirst.second);
+			Assert::IsTrue(shapeFirst.first == -compoundFirst.first);
+			Assert::AreEqual(4, WLUW::CompoundShape::computeManifolds(box, a, contacts, scratch));
+			for (const WLUW::ChildContact& contact : contacts)
+			{
+				Assert::AreEqual(0, contact.childA);
+				Assert::IsTrue(contact.manifold.normal.dot(box.getPosition() - a.getChild(contact.childB).getPosition()) > 0.0);
+			}
+			Assert::IsTrue(std::isnan(WLUW::CompoundShape::checkCollision(Shape_Tests::makeBox(WLUW::Vector2(20, 20), 0.5), a, scratch).second));
+
+			// Dropping the first column rebuilds the tree without it
+			for (int i = 0; i < 6; i++)
+				a.removeChild(0);
+			Assert::AreEqual(30, a.getChildCount());
+			Assert::AreEqual(1.3 - 0.4, a.getBoundingBox().min.x, 1e-12);
+		}
+
+		TEST_METHOD(Queries_T)
+		{
+			// L outline split into pieces, then turned a quarter and moved
+			std::vector<WLUW::Vector2> l = { WLUW::Vector2(0, 0), WLUW::Vector2(2, 0), WLUW::Vector2(2, 1),
+				WLUW::Vector2(1, 1), WLUW::Vector2(1, 2), WLUW::Vector2(0, 2) };
+			WLUW::CompoundShape compound(WLUW::convexDecomposition(l));
+			compound.setTransform(WLUW::Transform2D(WLUW::Vector2(10, 0), 3.14159265358979 / 2));
+
+			Assert::IsTrue(compound.containsPoint(WLUW::Vector2(9.5, 1.5)));
+			Assert::IsFalse(compound.containsPoint(WLUW::Vector2(8.5, 1.5)));
+			Assert::AreEqual(8.0, compound.getBoundingBox().min.x, 1e-12);
+
+			// Ray down the notch of the L hits the inner corner
+			WLUW::Ray ray{ WLUW::Vector2(8.5, 5), WLUW::Vector2(0, -1), 10.0 };
+			WLUW::RayHit hit;
+			Assert::IsTrue(compound.raycast(ray, hit) >= 0);
+			Assert::AreEqual(4.0, hit.distance, 1e-12);
+			Assert::AreEqual(1.0, hit.normal.y, 1e-12);
+		}
+	};
+
+	TEST_CLASS(ConvexDecomposition_Tests)
+	{
+	public:
+		static double area(const std::vector<WLUW::Vector2>& points)
+		{
+			double total = 0.0;
+			for (int i = 0; i < points.size(); i++)
+			{
+				WLUW::Vector2 p1 = points[i];
+				WLUW::Vector2 p2 = points[(i + 1) % points.size()];
+				total += p1.x * p2.y - p2.x * p1.y;
+			}
+			return total * 0.5;
+		}
+
+		// Every piece must turn left at every corner and the pieces must cover the outline exactly
+		static void checkPieces(const WLUW::ConvexPieces& pieces, double outlineArea)
+		{
+			double total = 0.0;
+			for (const std::vector<WLUW::Vector2>& piece : pieces)
+			{
+				int n = static_cast<int>(piece.size());
+				for (int i = 0; i < n; i++)
+				{
+					WLUW::Vector2 a = piece[(i + n - 1) % n], b = piece[i], c = piece[(i + 1) % n];
+					Assert::IsTrue((b - a).x * (c - a).y - (b - a).y * (c - a).x > 0.0);
+				}
+				total += area(piece);
+			}
+			Assert::AreEqual(outlineArea, total, 1e-9);
+		}
+
+		TEST_METHOD(ConvexHull_T)
+		{
+			// Grid of points, the middle of each side is collinear and the centre is inside
+			std::vector<WLUW::Vector2> points;
+			for (int x = 2; x >= 0; x--)
+				for (int y = 0; y <= 2; y++)
+					points.push_back(WLUW::Vector2(x, y));
+			points.push_back(WLUW::Vector2(2, 2));
+
+			std::vector<WLUW::Vector2> hull = WLUW::convexHull(points);
+			std::vector<WLUW::Vector2> expected = { WLUW::Vector2(0, 0), WLUW::Vector2(2, 0), WLUW::Vector2(2, 2), WLUW::Vector2(0, 2) };
+			Assert::IsTrue(expected == hull);
+		}
+
+		TEST_METHOD(Decomposition_T)
+		{
+			// An L splits in two
+			std::vector<WLUW::Vector2> l = { WLUW::Vector2(0, 0), WLUW::Vector2(2, 0), WLUW::Vector2(2, 1),
+				WLUW::Vector2(1, 1), WLUW::Vector2(1, 2), WLUW::Vector2(0, 2) };
+			WLUW::ConvexPieces pieces = WLUW::convexDecomposition(l);
+			Assert::AreEqual(size_t(2), pieces.size());
+			checkPieces(pieces, 3.0);
+
+			// Convex outlines come back whole, whichever way they wind
+			std::vector<WLUW::Vector2> square = { WLUW::Vector2(0, 0), WLUW::Vector2(0, 1), WLUW::Vector2(1, 1), WLUW::Vector2(1, 0) };
+			Assert::AreEqual(size_t(1), WLUW::convexDecomposition(square).size());
+
+			// Star shaped outlines with many reflex corners
+			std::mt19937 rng(11);
+			std::uniform_real_distribution<double> radius(1.0, 4.0);
+			std::vector<WLUW::Vector2> star;
+			for (int i = 0; i < 40; i++)
+			{
+				double angle = i * 2.0 * 3.14159265358979 / 40;
+				star.push_back(WLUW::Vector2(std::cos(angle), std::sin(angle)) * radius(rng));
+			}
+			pieces = WLUW::convexDecomposition(star);
+			checkPieces(pieces, area(star));
+			Assert::IsTrue(pieces.size() < 38);
+
+			std::vector<WLUW::Shape> shapes = WLUW::makeConvexShapes(pieces, WLUW::Vector2(5, 0));
+			Assert::AreEqual(pieces.size(), shapes.size());
+			Assert::AreEqual(pieces[0].size(), shapes[0].getNormals().size());
+		}
+
+		TEST_METHOD(DecompositionCache_T)
+		{
+			std::filesystem::path directory = std::filesystem::temp_directory_path() / "wluw_decomposition_test";
+			std::filesystem::remove_all(directory);
+
+			std::vector<WLUW::Vector2> l = { WLUW::Vector2(0, 0), WLUW::Vector2(2, 0), WLUW::Vector2(2, 1),
+				WLUW::Vector2(1, 1), WLUW::Vector2(1, 2), WLUW::Vector2(0, 2) };
+			WLUW::ConvexPieces expected = WLUW::convexDecomposition(l);
+
+			// The second cache reads what the first wrote
+			WLUW::DecompositionCache first(directory.string());
+			Assert::IsTrue(expected == first.decompose(l));
+			WLUW::DecompositionCache second(directory.string());
+			Assert::IsTrue(expected == second.decompose(l));
+			Assert::AreEqual(1, first.getMisses());
+			Assert::AreEqual(1, second.getHits());
+
+			// A damaged file is decomposed again and replaced
+			std::filesystem::resize_file(second.getPath(l), 20);
+			Assert::IsTrue(expected == second.decompose(l));
+			Assert::AreEqual(1, second.getMisses());
+			Assert::IsTrue(expected == second.decompose(l));
+			Assert::AreEqual(2, second.getHits());
+
+			// Any change to the outline changes the hash
+			std::vector<WLUW::Vector2> moved = l;
+			moved[3].x = std::nextafter(1.0, 2.0);
+			Assert::IsTrue(WLUW::DecompositionCache::hashOutline(l) != WLUW::DecompositionCache::hashOutline(moved));
+
+			std::filesystem::remove_all(directory);
+		}
+	};
+
+	TEST_CLASS(Fixed_Tests)
+	{
+	public:
+		template<class Scalar>
+		static std::vector<WLUW::Vector2T<Scalar>> makeBox(WLUW::Vector2T<Scalar> pos, Scalar halfSize)
+		{
+			return {
+				pos + WLUW::Vector2T<Scalar>(-halfSize, -halfSize),
+				pos + WLUW::Vector2T<Scalar>(halfSize, -halfSize),
+				pos + WLUW::Vector2T<Scalar>(halfSize, halfSize),
+				pos + WLUW::Vector2T<Scalar>(-halfSize, halfSize)
+			};
+		}
+
+		// Collides many pairs of boxes, returns the summed depths so the work can't be optimised away
+		template<class Scalar>
+		static Scalar collideBoxes(int count)
+		{
+			std::vector<WLUW::Vector2T<Scalar>> a = makeBox(WLUW::Vector2T<Scalar>(0, 0), Scalar(1));
+			std::vector<WLUW::Vector2T<Scalar>> normals(4);
+			WLUW::computeNormals(a.data(), 4, normals.data());
+
+			// Slide b along a, built in place so the loop times the collision and not the allocator
+			std::vector<WLUW::Vector2T<Scalar>> b = a;
+			Scalar total = Scalar(0);
+			for (int i = 0; i < count; i++)
+			{
+				WLUW::Vector2T<Scalar> offset(Scalar(i % 7) / Scalar(4), Scalar(1));
+				for (int j = 0; j < 4; j++)
+					b[j] = a[j] + offset;
+
+				WLUW::Vector2T<Scalar> axis;
+				Scalar depth;
+				if (WLUW::polygonPolygonOverlap(a.data(), 4, b.data(), 4, normals, 2, a[0], b[0], axis, depth))
+					total += depth;
+			}
+			return total;
+		}
+
+		TEST_METHOD(Arithmetic_T)
+		{
+			WLUW::Fixed two(2);
+			Assert::IsTrue(WLUW::Fixed(1.5) * two == WLUW::Fixed(3));
+			Assert::IsTrue(WLUW::Fixed(3) / two == WLUW::Fixed(1.5));
+
+			// Quotients round down, negative ones included
+			Assert::IsTrue(WLUW::Fixed(-1) / WLUW::Fixed(3) == WLUW::Fixed::fromRaw(-21846));
+
+			// sqrt(2) * 2^16 = 92681.9, the root is the largest value whose square fits
+			Assert::IsTrue(sqrt(two) == WLUW::Fixed::fromRaw(92681));
+			Assert::IsTrue(sqrt(WLUW::Fixed(9)) == WLUW::Fixed(3));
+
+			WLUW::Vector2T<WLUW::Fixed> v(3, 4);
+			Assert::IsTrue(v.size() == WLUW::Fixed(5));
+			Assert::IsTrue(v.normalized() == WLUW::Vector2T<WLUW::Fixed>(WLUW::Fixed::fromRaw(39321), WLUW::Fixed::fromRaw(52428)));
+		}
+
+		TEST_METHOD(LargeArithmetic_T)
+		{
+			// Raw products past 2^63 are worked out across two words, rounding down as small ones do
+			Assert::IsTrue(WLUW::Fixed(100000) * WLUW::Fixed(100000) == WLUW::Fixed(1e10));
+			Assert::IsTrue(WLUW::Fixed(-100000) * WLUW::Fixed(100000) == WLUW::Fixed(-1e10));
+			Assert::IsTrue(WLUW::Fixed::fromRaw((std::int64_t(1) << 40) + 3) * WLUW::Fixed::fromRaw(-(std::int64_t(5) << 30) - 1)
+				== WLUW::Fixed::fromRaw(-90071992564432897));
+
+			// Products beyond the range saturate rather than wrap
+			Assert::IsTrue(WLUW::Fixed(1e9) * WLUW::Fixed(1e9) == std::numeric_limits<WLUW::Fixed>::max());
+			Assert::IsTrue(WLUW::Fixed(-1e9) * WLUW::Fixed(1e9) == std::numeric_limits<WLUW::Fixed>::lowest());
+
+			// Numerators too large to scale up before dividing
+			Assert::IsTrue(WLUW::Fixed(1e10) / WLUW::Fixed(0.5) == WLUW::Fixed(2e10));
+			Assert::IsTrue(WLUW::Fixed(-1e10) / WLUW::Fixed(7) == WLUW::Fixed::fromRaw(-93622857142858));
+			Assert::IsTrue(WLUW::Fixed(1e12) / WLUW::Fixed::fromRaw(1) == std::numeric_limits<WLUW::Fixed>::max());
+			Assert::IsTrue(WLUW::Fixed(-1e12) / WLUW::Fixed::fromRaw(1) == std::numeric_limits<WLUW::Fixed>::lowest());
+
+			// Roots of values whose raw form times 2^16 needs two words
+			Assert::IsTrue(sqrt(WLUW::Fixed(1e12)) == WLUW::Fixed(1e6));
+			Assert::IsTrue(sqrt(WLUW::Fixed::fromRaw((std::int64_t(3) << 50) + 777777)) == WLUW::Fixed::fromRaw(14878203148));
+			Assert::IsTrue(sqrt(std::numeric_limits<WLUW::Fixed>::max()) == WLUW::Fixed::fromRaw(777472127993));
+		}
+
+		TEST_METHOD(FixedMatchesDouble_T)
+		{
+			std::vector<WLUW::Vector2> a = makeBox(WLUW::Vector2(0, 0), 1.0);
+			std::vector<WLUW::Vector2> b = makeBox(WLUW::Vector2(1.5, 0.25), 1.0);
+			std::vector<WLUW::Vector2T<WLUW::Fixed>> fixedA = makeBox(WLUW::Vector2T<WLUW::Fixed>(0, 0), WLUW::Fixed(1));
+			std::vector<WLUW::Vector2T<WLUW::Fixed>> fixedB = makeBox(WLUW::Vector2T<WLUW::Fixed>(WLUW::Fixed(1.5), WLUW::Fixed(0.25)), WLUW::Fixed(1));
+
+			std::vector<WLUW::Vector2> normals(4);
+			std::vector<WLUW::Vector2T<WLUW::Fixed>> fixedNormals(4);
+			WLUW::computeNormals(a.data(), 4, normals.data());
+			WLUW::computeNormals(fixedA.data(), 4, fixedNormals.data());
+
+			WLUW::Vector2 axis;
+			double depth;
+			WLUW::Vector2T<WLUW::Fixed> fixedAxis;
+			WLUW::Fixed fixedDepth;
+			Assert::IsTrue(WLUW::polygonPolygonOverlap(a.data(), 4, b.data(), 4, normals, 4, a[0], b[0], axis, depth));
+			Assert::IsTrue(WLUW::polygonPolygonOverlap(fixedA.data(), 4, fixedB.data(), 4, fixedNormals, 4, fixedA[0], fixedB[0], fixedAxis, fixedDepth));
+
+			Assert::AreEqual(depth, fixedDepth.toDouble(), 1e-4);
+			Assert::AreEqual(axis.x, fixedAxis.x.toDouble(), 1e-4);
+			Assert::AreEqual(axis.y, fixedAxis.y.toDouble(), 1e-4);
+
+			// Circles go through the integer square root
+			WLUW::Fixed circleDepth;
+			Assert::IsTrue(WLUW::circleCircleOverlap(WLUW::Vector2T<WLUW::Fixed>(0, 0), WLUW::Fixed(1),
+				WLUW::Vector2T<WLUW::Fixed>(1, 1), WLUW::Fixed(1), fixedAxis, circleDepth));
+			Assert::AreEqual(2.0 - std::sqrt(2.0), circleDepth.toDouble(), 1e-4);
+		}
+
+		TEST_METHOD(Benchmark_T)
+		{
+			int const count = 100000;
+			auto time = [](auto&& work) {
+				auto start = std::chrono::steady_clock::now();
+				work();
+				return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			};
+
+			double doubleTotal = 0.0;
+			WLUW::Fixed fixedTotal;
+			double doubleSeconds = time([&]() { doubleTotal = collideBoxes<double>(count); });
+			double fixedSeconds = time([&]() { fixedTotal = collideBoxes<WLUW::Fixed>(count); });
+
+			Assert::AreEqual(doubleTotal, fixedTotal.toDouble(), count * 1e-4);
+
+			std::string message = "Box pairs per second, double: " + std::to_string(count / doubleSeconds)
+				+ ", fixed: " + std::to_string(count / fixedSeconds) + "\n";
+			Logger::WriteMessage(message.c_str());
+		}
 	};
 
 	TEST_CLASS(WComponents_Tests)
@@ -156,4 +1143,931 @@ namespace WLUWEngineTests
 			Assert::AreEqual(WLUW::TypeIdManager<WLUW::WComponentBase>::getNewID(), 4);*/
 		}
 	};
+
+	TEST_CLASS(Broadphase_Tests)
+	{
+	public:
+		// Moves random boxes around and checks the broadphase reports exactly the overlapping pairs
+		static void checkAgainstBruteForce(WLUW::WBroadphase& broadphase)
+		{
+			std::mt19937 rng(7);
+			std::uniform_real_distribution<double> position(0.0, 50.0);
+			std::uniform_real_distribution<double> step(-1.0, 1.0);
+
+			// One box is much wider than the rest, and reaches across queries from far before them
+			std::vector<WLUW::AABB> boxes;
+			std::vector<int> proxies;
+			for (int i = 0; i < 300; i++)
+			{
+				WLUW::Vector2 min(position(rng), position(rng));
+				boxes.emplace_back(min, min + WLUW::Vector2(i == 0 ? 40.0 : 1.5, 1.5));
+				proxies.push_back(broadphase.createProxy(boxes.back(), i));
+			}
+
+			for (int frame = 0; frame < 5; frame++)
+			{
+				for (int i = 0; i < boxes.size(); i++)
+				{
+					WLUW::Vector2 d(step(rng), step(rng));
+					boxes[i] = WLUW::AABB(boxes[i].min + d, boxes[i].max + d);
+					broadphase.moveProxy(proxies[i], boxes[i], d);
+				}
+
+				std::vector<WLUW::BroadphasePair> pairs;
+				broadphase.findPairs(pairs);
+				std::sort(pairs.begin(), pairs.end());
+
+				// Fat boxes may report extra pairs, but never miss or duplicate one
+				Assert::IsTrue(std::adjacent_find(pairs.begin(), pairs.end()) == pairs.end());
+				for (int i = 0; i < boxes.size(); i++)
+				{
+					for (int j = i + 1; j < boxes.size(); j++)
+					{
+						if (boxes[i].overlaps(boxes[j]))
+							Assert::IsTrue(std::binary_search(pairs.begin(), pairs.end(), WLUW::BroadphasePair(i, j)));
+					}
+				}
+
+				// Queries find every box they overlap, once each
+				WLUW::AABB region(boxes[0].max - WLUW::Vector2(8, 6), boxes[0].max - WLUW::Vector2(2, 0));
+				std::vector<int> found;
+				broadphase.query(region, [&](int userId) { found.push_back(userId); return true; });
+				std::sort(found.begin(), found.end());
+
+				Assert::IsTrue(std::adjacent_find(found.begin(), found.end()) == found.end());
+				Assert::IsTrue(std::binary_search(found.begin(), found.end(), 0));
+				for (int i = 0; i < boxes.size(); i++)
+				{
+					if (boxes[i].overlaps(region))
+						Assert::IsTrue(std::binary_search(found.begin(), found.end(), i));
+				}
+			}
+		}
+
+		// Puts boxes on two layers, where the second layer ignores itself, and checks no rejected pair is reported
+		static void checkFiltered(WLUW::WBroadphase& broadphase)
+		{
+			std::mt19937 rng(3);
+			std::uniform_real_distribution<double> position(0.0, 30.0);
+
+			WLUW::CollisionFilter solid{ 1, 0xFFFFFFFF };
+			WLUW::CollisionFilter debris{ 2, 1 };
+
+			std::vector<WLUW::AABB> boxes;
+			for (int i = 0; i < 200; i++)
+			{
+				WLUW::Vector2 min(position(rng), position(rng));
+				boxes.emplace_back(min, min + WLUW::Vector2(2, 2));
+				int proxy = broadphase.createProxy(boxes.back(), i);
+				broadphase.setProxyFilter(proxy, i % 2 == 0 ? solid : debris);
+			}
+
+			std::vector<WLUW::BroadphasePair> pairs;
+			broadphase.findPairs(pairs);
+			std::sort(pairs.begin(), pairs.end());
+
+			Assert::IsTrue(std::adjacent_find(pairs.begin(), pairs.end()) == pairs.end());
+			for (const WLUW::BroadphasePair& pair : pairs)
+				Assert::IsTrue(pair.first % 2 == 0 || pair.second % 2 == 0);
+
+			for (int i = 0; i < boxes.size(); i++)
+			{
+				for (int j = i + 1; j < boxes.size(); j++)
+				{
+					if ((i % 2 == 0 || j % 2 == 0) && boxes[i].overlaps(boxes[j]))
+						Assert::IsTrue(std::binary_search(pairs.begin(), pairs.end(), WLUW::BroadphasePair(i, j)));
+				}
+			}
+		}
+
+		TEST_METHOD(SpatialHashGridPairs_T)
+		{
+			WLUW::WSpatialHashGrid grid(2.0);
+			checkAgainstBruteForce(grid);
+		}
+
+		TEST_METHOD(SpatialHashGridCells_T)
+		{
+			WLUW::WSpatialHashGrid grid(1.0);
+			int a = grid.createProxy(WLUW::AABB(WLUW::Vector2(0.1, 0.1), WLUW::Vector2(1.5, 0.5)), 1);
+			int b = grid.createProxy(WLUW::AABB(WLUW::Vector2(1.2, 0.2), WLUW::Vector2(1.8, 0.8)), 2);
+			Assert::AreEqual(2, grid.getCellCount());
+
+			// Moving within the same cells keeps the layout, crossing into new ones moves only that proxy's entries
+			grid.moveProxy(b, WLUW::AABB(WLUW::Vector2(1.1, 0.1), WLUW::Vector2(1.9, 0.9)), WLUW::Vector2());
+			Assert::AreEqual(2, grid.getCellCount());
+			grid.moveProxy(b, WLUW::AABB(WLUW::Vector2(1.1, 1.1), WLUW::Vector2(1.9, 1.9)), WLUW::Vector2());
+			Assert::AreEqual(3, grid.getCellCount());
+
+			std::vector<WLUW::BroadphasePair> pairs;
+			grid.findPairs(pairs);
+			Assert::IsTrue(pairs.empty());
+
+			// Removed proxies leave no empty cells behind
+			grid.destroyProxy(a);
+			Assert::AreEqual(1, grid.getCellCount());
+			grid.setCellSize(4.0);
+			Assert::AreEqual(1, grid.getCellCount());
+
+			// Crowding one cell overflows its run, which must keep every proxy it held
+			std::vector<int> crowd;
+			for (int i = 0; i < 10; i++)
+				crowd.push_back(grid.createProxy(WLUW::AABB(WLUW::Vector2(10.0 + i * 4.0, 10.0), WLUW::Vector2(11.0 + i * 4.0, 11.0)), 10 + i));
+			for (int i = 0; i < 10; i++)
+				grid.moveProxy(crowd[i], WLUW::AABB(WLUW::Vector2(41.0, 41.0), WLUW::Vector2(42.0, 42.0)), WLUW::Vector2());
+			Assert::AreEqual(2, grid.getCellCount());
+			grid.findPairs(pairs);
+			Assert::AreEqual(static_cast<size_t>(45), pairs.size());
+		}
+
+		TEST_METHOD(SweepAndPrunePairs_T)
+		{
+			WLUW::WSweepAndPrune sweepAndPrune;
+			checkAgainstBruteForce(sweepAndPrune);
+		}
+
+		TEST_METHOD(LayeredPairs_T)
+		{
+			WLUW::WLayeredBroadphase layered({ 1 });
+			checkAgainstBruteForce(layered);
+		}
+
+		TEST_METHOD(FilteredPairs_T)
+		{
+			WLUW::WDynamicTree tree;
+			checkFiltered(tree);
+
+			WLUW::WSpatialHashGrid grid(2.0);
+			checkFiltered(grid);
+
+			WLUW::WSweepAndPrune sweepAndPrune;
+			checkFiltered(sweepAndPrune);
+
+			// Debris gets its own tree which is never searched against itself
+			WLUW::WLayeredBroadphase layered({ 1, 2 });
+			layered.setLayersCollide(1, 1, false);
+			checkFiltered(layered);
+			Assert::AreEqual(1, layered.getLayer(1));
+
+			// The default mask covers every layer, up to the highest bit however wide the layers are
+			WLUW::CollisionFilter top{ WLUW::CollisionBits(1) << (sizeof(WLUW::CollisionBits) * 8 - 1) };
+			Assert::IsTrue(top.collidesWith(WLUW::CollisionFilter()));
+			Assert::IsFalse(top.collidesWith(WLUW::CollisionFilter{ 1, 1 }));
+		}
+
+		TEST_METHOD(SweepAndPruneDeltas_T)
+		{
+			WLUW::WSweepAndPrune sweepAndPrune;
+			int a = sweepAndPrune.createProxy(WLUW::AABB(WLUW::Vector2(0, 0), WLUW::Vector2(1, 1)), 10);
+			sweepAndPrune.createProxy(WLUW::AABB(WLUW::Vector2(3, 0), WLUW::Vector2(4, 1)), 20);
+
+			sweepAndPrune.updatePairs();
+			Assert::IsTrue(sweepAndPrune.getAddedPairs().empty());
+
+			// Move into the other box
+			sweepAndPrune.moveProxy(a, WLUW::AABB(WLUW::Vector2(2.5, 0), WLUW::Vector2(3.5, 1)), WLUW::Vector2(2.5, 0));
+			sweepAndPrune.updatePairs();
+			Assert::IsTrue(sweepAndPrune.getAddedPairs().size() == 1);
+			Assert::IsTrue(sweepAndPrune.getAddedPairs()[0] == WLUW::BroadphasePair(10, 20));
+
+			// Staying put reports nothing
+			sweepAndPrune.updatePairs();
+			Assert::IsTrue(sweepAndPrune.getAddedPairs().empty());
+			Assert::IsTrue(sweepAndPrune.getRemovedPairs().empty());
+
+			// Move back out
+			sweepAndPrune.moveProxy(a, WLUW::AABB(WLUW::Vector2(0, 0), WLUW::Vector2(1, 1)), WLUW::Vector2(-2.5, 0));
+			sweepAndPrune.updatePairs();
+			Assert::IsTrue(sweepAndPrune.getRemovedPairs().size() == 1);
+			Assert::AreEqual(sweepAndPrune.getPairCount(), 0);
+		}
+
+		TEST_METHOD(RayCastBatch_T)
+		{
+			std::mt19937 rng(11);
+			std::uniform_real_distribution<double> position(0.0, 50.0);
+			std::uniform_real_distribution<double> angle(0.0, 6.283185307179586);
+
+			WLUW::WDynamicTree tree;
+			WLUW::WSpatialHashGrid grid(2.0);
+			WLUW::WLayeredBroadphase layered({ 1, 2 });
+			std::vector<WLUW::AABB> boxes;
+			for (int i = 0; i < 200; i++)
+			{
+				WLUW::Vector2 min(position(rng), position(rng));
+				boxes.emplace_back(min, min + WLUW::Vector2(1.0, 1.0));
+				tree.createProxy(boxes.back(), i);
+				grid.createProxy(boxes.back(), i);
+				layered.setProxyFilter(layered.createProxy(boxes.back(), i), { static_cast<WLUW::CollisionBits>(1 + i % 2) });
+			}
+
+			std::vector<WLUW::Ray> rays;
+			for (int i = 0; i < 64; i++)
+			{
+				double a = angle(rng);
+				rays.push_back({ WLUW::Vector2(25, 25), WLUW::Vector2(std::cos(a), std::sin(a)), 40.0 });
+			}
+
+			// Nearest box each ray enters, found by testing every box
+			std::vector<double> expected(rays.size(), rays[0].maxDistance);
+			for (int i = 0; i < rays.size(); i++)
+			{
+				for (const WLUW::AABB& box : boxes)
+				{
+					double distance;
+					if (box.raycast(rays[i], distance) && distance < expected[i])
+						expected[i] = distance;
+				}
+			}
+
+			for (WLUW::WBroadphase* broadphase : std::vector<WLUW::WBroadphase*>{ &tree, &grid, &layered })
+			{
+				std::vector<double> nearest(rays.size(), rays[0].maxDistance);
+				auto clip = [&](int rayIndex, int userId, double maxDistance) {
+					WLUW::Ray clipped = rays[rayIndex];
+					clipped.maxDistance = maxDistance;
+
+					double distance;
+					if (!boxes[userId].raycast(clipped, distance))
+						return maxDistance;
+					nearest[rayIndex] = distance;
+					return distance;
+				};
+
+				broadphase->rayCastBatch(rays, clip);
+				for (int i = 0; i < rays.size(); i++)
+					Assert::AreEqual(expected[i], nearest[i]);
+
+				std::fill(nearest.begin(), nearest.end(), rays[0].maxDistance);
+				for (int i = 0; i < rays.size(); i++)
+					broadphase->rayCast(rays[i], [&](int userId, double maxDistance) { return clip(i, userId, maxDistance); });
+				for (int i = 0; i < rays.size(); i++)
+					Assert::AreEqual(expected[i], nearest[i]);
+			}
+		}
+	};
+
+	TEST_CLASS(DynamicTree_Tests)
+	{
+	public:
+		TEST_METHOD(Pairs_T)
+		{
+			WLUW::WDynamicTree tree;
+			Broadphase_Tests::checkAgainstBruteForce(tree);
+		}
+
+		TEST_METHOD(Balanced_T)
+		{
+			WLUW::WDynamicTree tree;
+			for (int i = 0; i < 1024; i++)
+				tree.createProxy(WLUW::AABB(WLUW::Vector2(i, 0), WLUW::Vector2(i + 0.5, 0.5)), i);
+
+			// Sorted insertion would make a list without rotations
+			Assert::IsTrue(tree.getHeight() < 25);
+		}
+
+		TEST_METHOD(FatBoxes_T)
+		{
+			WLUW::WDynamicTree tree(0.1, 2.0);
+			int proxy = tree.createProxy(WLUW::AABB(WLUW::Vector2(0, 0), WLUW::Vector2(1, 1)), 5);
+			Assert::AreEqual(-0.1, tree.getFatAABB(proxy).min.x, 1e-12);
+
+			// Small moves stay inside the fat box
+			Assert::IsFalse(tree.moveProxyChecked(proxy, WLUW::AABB(WLUW::Vector2(0.05, 0), WLUW::Vector2(1.05, 1)), WLUW::Vector2(0.05, 0)));
+
+			// Leaving it reinserts the proxy with the box stretched along the motion
+			Assert::IsTrue(tree.moveProxyChecked(proxy, WLUW::AABB(WLUW::Vector2(0.5, 0), WLUW::Vector2(1.5, 1)), WLUW::Vector2(0.45, 0)));
+			Assert::AreEqual(0.4, tree.getFatAABB(proxy).min.x, 1e-12);
+			Assert::AreEqual(1.6 + 0.9, tree.getFatAABB(proxy).max.x, 1e-12);
+			Assert::AreEqual(5, tree.getUserId(proxy));
+		}
+
+		TEST_METHOD(QueryAndDestroy_T)
+		{
+			WLUW::WDynamicTree tree;
+			std::vector<int> proxies;
+			for (int i = 0; i < 10; i++)
+				proxies.push_back(tree.createProxy(WLUW::AABB(WLUW::Vector2(i * 2, 0), WLUW::Vector2(i * 2 + 1, 1)), 100 + i));
+
+			std::vector<int> found;
+			auto collect = [&found](int userId) { found.push_back(userId); return true; };
+			tree.query(WLUW::AABB(WLUW::Vector2(3.5, 0), WLUW::Vector2(6.5, 1)), collect);
+			std::sort(found.begin(), found.end());
+			Assert::IsTrue(std::vector<int>{ 102, 103 } == found);
+
+			// Destroyed proxies disappear, and their nodes are reused
+			tree.destroyProxy(proxies[2]);
+			Assert::AreEqual(9, tree.getProxyCount());
+			found.clear();
+			tree.query(WLUW::AABB(WLUW::Vector2(3.5, 0), WLUW::Vector2(6.5, 1)), collect);
+			Assert::IsTrue(std::vector<int>{ 103 } == found);
+
+			int reused = tree.createProxy(WLUW::AABB(WLUW::Vector2(50, 0), WLUW::Vector2(51, 1)), 200);
+			Assert::AreEqual(10, tree.getProxyCount());
+			Assert::AreEqual(200, tree.getUserId(reused));
+			Assert::ExpectException<const char*>([&tree]() { tree.destroyProxy(-1); });
+		}
+	};
+
+	TEST_CLASS(Dynamics_Tests)
+	{
+	public:
+		TEST_METHOD(Integrate_T)
+		{
+			WLUW::WBodyPool pool;
+			int falling = pool.createBody(1.0, 1.0, WLUW::Vector2(0, 0), 0.0, WLUW::Vector2(2, 0), 0.5);
+			int fixed = pool.createBody(0.0, 0.0, WLUW::Vector2(5, 5), 0.0, WLUW::Vector2(0, 0), 0.0);
+
+			pool.integrate(0.1, WLUW::Vector2(0, -10));
+
+			// Semi-implicit Euler moves by the new velocity
+			int i = pool.getIndex(falling);
+			Assert::AreEqual(-1.0, pool.velocityY[i], 1e-12);
+			Assert::AreEqual(-0.1, pool.positionY[i], 1e-12);
+			Assert::AreEqual(0.2, pool.positionX[i], 1e-12);
+			Assert::AreEqual(0.05, pool.angle[i], 1e-12);
+
+			// Static bodies ignore gravity
+			Assert::AreEqual(5.0, pool.positionY[pool.getIndex(fixed)]);
+
+			// Handles survive the bodies being moved around
+			pool.destroyBody(falling);
+			Assert::AreEqual(0, pool.getIndex(fixed));
+			Assert::AreEqual(5.0, pool.positionX[pool.getIndex(fixed)]);
+		}
+
+		TEST_METHOD(IntegrateMatchesScalar_T)
+		{
+			std::mt19937 rng(11);
+			std::uniform_real_distribution<double> value(-10.0, 10.0);
+
+			// Odd count so the vector loops have a tail
+			WLUW::WBodyPool pools[3];
+			for (int i = 0; i < 1003; i++)
+			{
+				double inverseMass = i % 7 == 0 ? 0.0 : 1.0 / (1.0 + std::abs(value(rng)));
+				WLUW::Vector2 position(value(rng), value(rng));
+				WLUW::Vector2 velocity(value(rng), value(rng));
+				WLUW::Vector2 force(value(rng), value(rng));
+
+				for (auto& pool : pools)
+				{
+					pool.createBody(inverseMass, inverseMass, position, 0.0, velocity, 1.0);
+					pool.forceX[i] = force.x;
+					pool.forceY[i] = force.y;
+				}
+			}
+
+			for (int level = 0; level <= static_cast<int>(WLUW::getSimdLevel()); level++)
+				pools[level].integrate(1.0 / 60.0, WLUW::Vector2(0, -9.81), -1, static_cast<WLUW::SimdLevel>(level));
+
+			for (int level = 1; level <= static_cast<int>(WLUW::getSimdLevel()); level++)
+			{
+				Assert::IsTrue(pools[level].positionX == pools[0].positionX);
+				Assert::IsTrue(pools[level].positionY == pools[0].positionY);
+				Assert::IsTrue(pools[level].velocityY == pools[0].velocityY);
+				Assert::IsTrue(pools[level].angle == pools[0].angle);
+			}
+		}
+
+		TEST_METHOD(SolverIslands_T)
+		{
+			// Rows of bodies sliding into each other, each row resting on a shared static floor
+			WLUW::WBodyPool pools[2];
+			std::vector<WLUW::ContactManifold> manifolds[2];
+			std::vector<WLUW::SolverContact> contacts[2];
+
+			for (int p = 0; p < 2; p++)
+			{
+				int floor = pools[p].createBody(0.0, 0.0, WLUW::Vector2(0, -1), 0.0, WLUW::Vector2(0, 0), 0.0);
+				manifolds[p].resize(20);
+
+				for (int row = 0; row < 10; row++)
+				{
+					int left = pools[p].createBody(1.0, 1.0, WLUW::Vector2(0, row * 3.0), 0.0, WLUW::Vector2(1, -1), 0.0);
+					int right = pools[p].createBody(0.5, 0.5, WLUW::Vector2(1, row * 3.0), 0.0, WLUW::Vector2(-1, -1), 0.0);
+
+					// Normals point from b towards a
+					WLUW::ContactManifold& between = manifolds[p][row * 2];
+					between.normal = WLUW::Vector2(-1, 0);
+					between.pointCount = 1;
+					between.points[0].position = WLUW::Vector2(0.5, row * 3.0);
+					between.points[0].depth = 0.05;
+
+					WLUW::ContactManifold& ground = manifolds[p][row * 2 + 1];
+					ground.normal = WLUW::Vector2(0, 1);
+					ground.pointCount = 1;
+					ground.points[0].position = WLUW::Vector2(0, row * 3.0 - 0.5);
+					ground.points[0].depth = 0.0;
+
+					contacts[p].push_back({ left, right, &between, 0.3 });
+					contacts[p].push_back({ left, floor, &ground, 0.3 });
+				}
+			}
+
+			WLUW::WContactSolver solver;
+			solver.solve(pools[0], contacts[0], 1.0 / 60.0);
+			Assert::AreEqual(10, solver.getIslandCount());
+
+			solver.setThreadCount(4);
+			solver.solve(pools[1], contacts[1], 1.0 / 60.0);
+
+			// Same answer whichever thread solved each island
+			Assert::IsTrue(pools[0].velocityX == pools[1].velocityX);
+			Assert::IsTrue(pools[0].velocityY == pools[1].velocityY);
+			Assert::IsTrue(pools[0].angularVelocity == pools[1].angularVelocity);
+
+			// The pairs stop approaching and the floor stops the fall
+			for (int row = 0; row < 10; row++)
+			{
+				int left = 1 + row * 2;
+				Assert::IsTrue(pools[0].velocityX[left + 1] - pools[0].velocityX[left] >= -1e-9);
+				Assert::IsTrue(pools[0].velocityY[left] >= -1e-9);
+				Assert::IsTrue(manifolds[0][row * 2].points[0].normalImpulse > 0.0);
+			}
+
+			// The floor is static and never written
+			Assert::AreEqual(0.0, pools[0].velocityX[0]);
+		}
+
+		TEST_METHOD(Sleep_T)
+		{
+			WLUW::WBodyPool pool;
+			int still = pool.createBody(1.0, 1.0, WLUW::Vector2(0, 0), 0.0, WLUW::Vector2(0, 0), 0.0);
+			int resting = pool.createBody(1.0, 1.0, WLUW::Vector2(0, 1), 0.0, WLUW::Vector2(0, 0), 0.0);
+			int moving = pool.createBody(1.0, 1.0, WLUW::Vector2(5, 0), 0.0, WLUW::Vector2(1, 0), 0.0);
+
+			// resting lies on top of moving, so they form one island
+			WLUW::ContactManifold manifold;
+			manifold.normal = WLUW::Vector2(0, 1);
+			manifold.pointCount = 1;
+			manifold.points[0].position = WLUW::Vector2(0, 0.5);
+			manifold.points[0].depth = 0.0;
+			std::vector<WLUW::SolverContact> contacts = { { resting, moving, &manifold, 0.0 } };
+
+			WLUW::WContactSolver solver;
+			for (int i = 0; i < 40; i++)
+			{
+				solver.solve(pool, contacts, 1.0 / 60.0);
+				solver.updateSleep(pool, contacts, 1.0 / 60.0);
+			}
+
+			// Only the lone still body sleeps, the island waits for its restless member
+			Assert::IsFalse(pool.isAwake(still));
+			Assert::IsTrue(pool.isAwake(resting));
+			Assert::IsTrue(pool.isAwake(moving));
+			Assert::AreEqual(2, pool.getAwakeCount());
+
+			// Sleeping bodies are outside the awake range, so integration skips them
+			pool.forceX[pool.getIndex(still)] = 100.0;
+			pool.integrate(1.0 / 60.0, WLUW::Vector2(0, -10), pool.getAwakeCount());
+			Assert::AreEqual(0.0, pool.positionY[pool.getIndex(still)]);
+
+			// Waking moves the body back into the awake range and resets its timer
+			pool.setAwake(still, true);
+			Assert::AreEqual(3, pool.getAwakeCount());
+			Assert::AreEqual(0.0, pool.sleepTime[pool.getIndex(still)]);
+			Assert::AreEqual(0.0, pool.positionX[pool.getIndex(still)]);
+			Assert::AreEqual(1.0, pool.velocityX[pool.getIndex(moving)]);
+
+			// A body woken between a solve and updating sleep doesn't break up the islands of that solve
+			pool.velocityY[pool.getIndex(resting)] = 0.0;
+			pool.velocityY[pool.getIndex(moving)] = 0.0;
+			for (int i = 0; i < 40; i++)
+			{
+				pool.setAwake(still, false);
+				solver.solve(pool, contacts, 1.0 / 60.0);
+				pool.setAwake(still, true);
+				solver.updateSleep(pool, contacts, 1.0 / 60.0);
+			}
+			Assert::IsTrue(pool.isAwake(resting));
+		}
+
+		TEST_METHOD(FixedTimestep_T)
+		{
+			WLUW::WGameLoop loop(30, 16);
+			WLUW::WBodyPool pool;
+			int body = pool.createBody(1.0, 0.0, WLUW::Vector2(0, 0), 0.0, WLUW::Vector2(30, 0), 0.0);
+			auto update = [&](double deltaTime) {
+				pool.savePreviousState();
+				pool.integrate(deltaTime, WLUW::Vector2(0, 0));
+			};
+
+			// A second in uneven frames is exactly thirty ticks, with nothing left over
+			Assert::AreEqual(9, loop.advance(333333333, update));
+			Assert::AreEqual(10, loop.advance(333333333, update));
+			Assert::AreEqual(11, loop.advance(333333334, update));
+			Assert::IsTrue(loop.getTick() == 30);
+			Assert::AreEqual(0.0, loop.getAlpha());
+
+			// Half a tick later, rendering sits halfway between the last two steps
+			loop.advance(1000000000 / 60, update);
+			Assert::AreEqual(0.5, loop.getAlpha(), 1e-6);
+			Assert::AreEqual(29.5, pool.getInterpolatedPosition(body, loop.getAlpha()).x, 1e-5);
+
+			// A one second stall runs the limit and drops the rest
+			Assert::AreEqual(16, loop.advance(1000000000, update));
+			Assert::IsTrue(loop.getDroppedTicks() == 14);
+			Assert::AreEqual(0.5, loop.getAlpha(), 1e-6);
+		}
+	};
+
+	TEST_CLASS(World_Tests)
+	{
+	public:
+		/**
+		 * \brief Add an object with a collider to a world, and a rigid body if it has mass
+		 *
+		 * \return the object, owned by the world
+		 */
+		static WLUW::WObject* addObject(WLUW::WWorld& world, const WLUW::Shape& shape, double mass = 0.0, double inertia = 0.0)
+		{
+			auto object = std::make_unique<WLUW::WObject>();
+			object->attachComponent(std::make_unique<WLUW::WCollider>(shape));
+			if (mass > 0.0)
+				object->attachComponent(std::make_unique<WLUW::WRigidBody>(mass, inertia));
+
+			WLUW::WObject* added = object.get();
+			world.addWorldObject(std::move(object));
+			return added;
+		}
+
+		static WLUW::Shape makeBox(WLUW::Vector2 pos, double halfWidth, double halfHeight)
+		{
+			std::vector<WLUW::Vector2> points = {
+				WLUW::Vector2(-halfWidth, -halfHeight),
+				WLUW::Vector2(halfWidth, -halfHeight),
+				WLUW::Vector2(halfWidth, halfHeight),
+				WLUW::Vector2(-halfWidth, halfHeight)
+			};
+			return WLUW::Shape(points, pos);
+		}
+
+		TEST_METHOD(ContinuousCollision_T)
+		{
+			// A bullet crossing ten units a step, and a wall a fiftieth thick halfway along its path
+			auto fire = [](bool continuous) {
+				WLUW::WWorld world;
+				world.setGravity(WLUW::Vector2(0, 0));
+				addObject(world, makeBox(WLUW::Vector2(0, 0), 0.01, 5.0));
+
+				WLUW::WObject* bullet = addObject(world, makeBox(WLUW::Vector2(-5, 0), 0.1, 0.1), 1.0);
+				bullet->getComponent<WLUW::WCollider>()->setContinuous(continuous);
+				bullet->getComponent<WLUW::WRigidBody>()->setVelocity(WLUW::Vector2(600, 0));
+
+				world.step(1.0 / 60.0);
+				return bullet->getComponent<WLUW::WCollider>()->getShape().getPosition().x;
+			};
+
+			// Without sweeping it jumps clean over the wall
+			Assert::IsTrue(fire(false) > 4.0);
+
+			// Swept, it stops against the near face
+			double const stopped = fire(true);
+			Assert::IsTrue(stopped <= -0.11 + 1e-6);
+			Assert::IsTrue(stopped > -0.2);
+		}
+
+		TEST_METHOD(ContactCache_T)
+		{
+			WLUW::WWorld world;
+			world.setGravity(WLUW::Vector2(0, -10));
+
+			// Enough pairs to grow the contact table. Every other box flies off its slab, the rest stay resting on theirs
+			std::vector<int> slabs;
+			std::vector<int> boxes;
+			for (int i = 0; i < 80; i++)
+			{
+				slabs.push_back(addObject(world, makeBox(WLUW::Vector2(i * 3.0, 0), 1.0, 0.5))->getId());
+				WLUW::WObject* box = addObject(world, makeBox(WLUW::Vector2(i * 3.0, 0.99), 0.5, 0.5), 1.0, 1.0 / 6.0);
+				boxes.push_back(box->getId());
+				if (i % 2 == 0)
+					box->getComponent<WLUW::WRigidBody>()->setVelocity(WLUW::Vector2(0, 30));
+			}
+
+			world.step(1.0 / 60.0);
+			for (int i = 0; i < 80; i++)
+				Assert::IsTrue(world.getManifold(slabs[i], boxes[i]) != nullptr);
+
+			// The pairs which came apart are forgotten, without losing the ones still touching
+			for (int i = 0; i < 10; i++)
+				world.step(1.0 / 60.0);
+			for (int i = 0; i < 80; i++)
+				Assert::AreEqual(i % 2 == 1, world.getManifold(slabs[i], boxes[i]) != nullptr);
+			Assert::IsTrue(world.getManifold(slabs[0], boxes[1]) == nullptr);
+		}
+
+		TEST_METHOD(ContinuousSliding_T)
+		{
+			// A bullet fired at a slant into a thin wall which it would cross in one step
+			WLUW::WWorld world;
+			world.setGravity(WLUW::Vector2(0, 0));
+			addObject(world, makeBox(WLUW::Vector2(10, 0), 0.01, 100.0));
+
+			WLUW::WObject* bullet = addObject(world, makeBox(WLUW::Vector2(0, 0), 0.1, 0.1), 1.0);
+			bullet->getComponent<WLUW::WCollider>()->setContinuous(true);
+			WLUW::WRigidBody* body = bullet->getComponent<WLUW::WRigidBody>();
+			body->setVelocity(WLUW::Vector2(600, 300));
+
+			world.step(1.0 / 60.0);
+
+			// Stopped against the wall, with the speed into it gone and the rest of the step spent sliding along it
+			const WLUW::Shape& shape = bullet->getComponent<WLUW::WCollider>()->getShape();
+			Assert::AreEqual(9.89, shape.getPosition().x, 1e-4);
+			Assert::AreEqual(5.0, shape.getPosition().y, 1e-4);
+			Assert::AreEqual(0.0, body->getVelocity().x, 1e-4);
+			Assert::AreEqual(300.0, body->getVelocity().y, 1e-4);
+
+			// From then on it keeps sliding up the wall without getting stuck or passing through
+			for (int i = 1; i <= 8; i++)
+			{
+				world.step(1.0 / 60.0);
+				Assert::AreEqual(9.89, shape.getPosition().x, 1e-4);
+				Assert::AreEqual(5.0 * (i + 1), shape.getPosition().y, 1e-4);
+				Assert::AreEqual(300.0, body->getVelocity().y, 1e-4);
+			}
+		}
+
+		TEST_METHOD(RotatingBody_T)
+		{
+			WLUW::WWorld world;
+			world.setGravity(WLUW::Vector2(0, 0));
+
+			// A bar lying along x, turning a quarter turn in one step
+			WLUW::WObject* bar = addObject(world, makeBox(WLUW::Vector2(0, 0), 2.0, 0.1), 1.0, 1.0);
+			bar->getComponent<WLUW::WRigidBody>()->setAngularVelocity(1.5707963267948966);
+			world.step(1.0);
+
+			const WLUW::Shape& shape = bar->getComponent<WLUW::WCollider>()->getShape();
+			Assert::AreEqual(bar->getComponent<WLUW::WRigidBody>()->getAngle(), shape.getTransform().getAngle(), 1e-12);
+			Assert::AreEqual(2.0, shape.getBoundingBox().max.y, 1e-9);
+			Assert::AreEqual(0.1, shape.getBoundingBox().max.x, 1e-9);
+
+			// The broadphase follows the turn, so queries find the bar where it now stands
+			std::vector<int> ids;
+			Assert::AreEqual(1, world.queryPoint(WLUW::Vector2(0, 1.5), ids));
+			Assert::AreEqual(0, world.queryPoint(WLUW::Vector2(1.5, 0), ids));
+		}
+
+		TEST_METHOD(ContactTorque_T)
+		{
+			WLUW::WWorld world;
+			world.setGravity(WLUW::Vector2(0, 0));
+
+			// A box sliding into a ledge which only catches the top of its leading face
+			addObject(world, makeBox(WLUW::Vector2(1.2, 0.7), 0.5, 0.5));
+			WLUW::WObject* box = addObject(world, makeBox(WLUW::Vector2(0, 0), 0.5, 0.5), 1.0, 1.0 / 6.0);
+			WLUW::WRigidBody* body = box->getComponent<WLUW::WRigidBody>();
+			body->setVelocity(WLUW::Vector2(3, 0));
+
+			for (int i = 0; i < 20; i++)
+				world.step(1.0 / 60.0);
+
+			// The push lands above the centre, so the box tips back, and its shape turns with it
+			Assert::IsTrue(body->getVelocity().x < 3.0);
+			Assert::IsTrue(body->getAngularVelocity() > 0.1);
+			Assert::AreEqual(body->getAngle(), box->getComponent<WLUW::WCollider>()->getShape().getTransform().getAngle(), 1e-12);
+		}
+
+		TEST_METHOD(Stacking_T)
+		{
+			struct Rest
+			{
+				WLUW::Vector2 position;
+				double angle;
+				bool awake;
+			};
+
+			// Two stacks of five boxes on one floor, so the solver finds two islands to spread across threads
+			auto settle = [](int threads) {
+				WLUW::WWorld world;
+				world.setGravity(WLUW::Vector2(0, -10));
+				world.setThreadCount(threads);
+				addObject(world, makeBox(WLUW::Vector2(0, -1), 10.0, 0.5));
+
+				std::vector<WLUW::WRigidBody*> bodies;
+				for (int stack = 0; stack < 2; stack++)
+					for (int i = 0; i < 5; i++)
+					{
+						WLUW::Vector2 position(stack * 4.0 + 0.02 * i, i * 1.0);
+						bodies.push_back(addObject(world, makeBox(position, 0.5, 0.5), 1.0, 1.0 / 6.0)->getComponent<WLUW::WRigidBody>());
+					}
+
+				for (int i = 0; i < 600; i++)
+					world.step(1.0 / 60.0);
+
+				std::vector<Rest> rests;
+				for (WLUW::WRigidBody* body : bodies)
+					rests.push_back({ body->getPosition(), body->getAngle(), body->isAwake() });
+				return rests;
+			};
+
+			std::vector<Rest> serial = settle(1);
+			for (int i = 0; i < serial.size(); i++)
+			{
+				// Each box rests on the one below, upright, and the stacks have gone to sleep
+				Assert::AreEqual(i % 5 * 1.0, serial[i].position.y, 0.05);
+				Assert::AreEqual(0.0, serial[i].angle, 0.02);
+				Assert::IsFalse(serial[i].awake);
+			}
+
+			// The solver's workers are kept between steps, and leave the result as it was on one thread
+			std::vector<Rest> threaded = settle(4);
+			for (int i = 0; i < serial.size(); i++)
+			{
+				Assert::IsTrue(serial[i].position == threaded[i].position);
+				Assert::AreEqual(serial[i].angle, threaded[i].angle);
+			}
+		}
+
+		TEST_METHOD(Queries_T)
+		{
+			WLUW::WWorld world;
+			int const box = addObject(world, makeBox(WLUW::Vector2(0, 0), 1.0, 1.0))->getId();
+			int const circle = addObject(world, WLUW::Shape(0.5, WLUW::Vector2(3, 0)))->getId();
+
+			// On its own layer, so filters can leave it out
+			WLUW::WObject* layered = addObject(world, makeBox(WLUW::Vector2(6, 0), 0.5, 0.5));
+			layered->getComponent<WLUW::WCollider>()->setFilter({ 2, 0xFFFFFFFF });
+			int const other = layered->getId();
+
+			// Reserved up front, so no query needs to grow it
+			std::vector<int> ids;
+			ids.reserve(8);
+			int const* const storage = ids.data();
+
+			auto found = [&](std::vector<int> expected) {
+				std::sort(ids.begin(), ids.end());
+				std::sort(expected.begin(), expected.end());
+				return ids == expected;
+			};
+
+			Assert::AreEqual(2, world.queryAABB(WLUW::AABB(WLUW::Vector2(-0.5, -0.5), WLUW::Vector2(3, 0.2)), ids));
+			Assert::IsTrue(found({ box, circle }));
+			Assert::AreEqual(0, world.queryAABB(WLUW::AABB(WLUW::Vector2(1.5, 2), WLUW::Vector2(2, 3)), ids));
+
+			// A gap of 0.05 to the box leaves it out, touching the circle's edge counts
+			Assert::AreEqual(1, world.queryCircle(WLUW::Vector2(1.7, 0), 0.75, ids));
+			Assert::IsTrue(found({ box }));
+			Assert::AreEqual(2, world.queryCircle(WLUW::Vector2(4.5, 0), 1.0, ids));
+			Assert::IsTrue(found({ circle, other }));
+
+			WLUW::CollisionFilter firstLayer;
+			firstLayer.mask = 1;
+			Assert::AreEqual(1, world.queryCircle(WLUW::Vector2(4.5, 0), 1.0, ids, firstLayer));
+			Assert::IsTrue(found({ circle }));
+
+			// This triangle's box overlaps the box's corner, but the triangle itself stays clear of it
+			std::vector<WLUW::Vector2> clear = { WLUW::Vector2(0.9, 1.5), WLUW::Vector2(1.5, 0.9), WLUW::Vector2(1.5, 1.5) };
+			WLUW::Shape corner(clear);
+			Assert::AreEqual(1, world.queryAABB(corner.getBoundingBox(), ids));
+			Assert::AreEqual(0, world.queryShape(corner, ids));
+
+			std::vector<WLUW::Vector2> touching = { WLUW::Vector2(1, 0), WLUW::Vector2(2, -0.5), WLUW::Vector2(2, 0.5) };
+			Assert::AreEqual(1, world.queryShape(WLUW::Shape(touching), ids));
+			Assert::IsTrue(found({ box }));
+
+			// Inside the circle's bounding box, but outside the circle
+			Assert::AreEqual(0, world.queryPoint(WLUW::Vector2(2.6, 0.4), ids));
+			Assert::AreEqual(1, world.queryPoint(WLUW::Vector2(3, 0.4), ids));
+			Assert::IsTrue(found({ circle }));
+			Assert::AreEqual(1, world.queryPoint(WLUW::Vector2(0.99, -0.99), ids));
+			Assert::IsTrue(found({ box }));
+
+			Assert::IsTrue(ids.data() == storage);
+		}
+
+		TEST_METHOD(Sensors_T)
+		{
+			WLUW::WWorld world;
+			world.setGravity(WLUW::Vector2(0, 0));
+
+			WLUW::WObject* sensorObject = addObject(world, makeBox(WLUW::Vector2(0, 0), 1.0, 1.0));
+			sensorObject->getComponent<WLUW::WCollider>()->setSensor(true);
+			int const sensor = sensorObject->getId();
+
+			WLUW::WObject* moving = addObject(world, makeBox(WLUW::Vector2(-3, 0), 0.25, 0.25), 1.0, 1.0);
+			WLUW::WRigidBody* body = moving->getComponent<WLUW::WRigidBody>();
+			body->setVelocity(WLUW::Vector2(3, 0));
+			int const passing = moving->getId();
+
+			std::vector<WLUW::SensorPair> entered;
+			std::vector<WLUW::SensorPair> exited;
+			int stayed = 0;
+			world.setSensorCallback([&](const WLUW::SensorEvents& events) {
+				entered.insert(entered.end(), events.entered.begin(), events.entered.end());
+				exited.insert(exited.end(), events.exited.begin(), events.exited.end());
+				stayed += static_cast<int>(events.stayed.size());
+			});
+
+			// Pass straight through the sensor, from one side to the other
+			for (int i = 0; i < 120; i++)
+			{
+				world.step(1.0 / 60.0);
+				if (i == 60)
+				{
+					// Halfway across it sits inside the sensor, which has reported it once
+					Assert::AreEqual(1, static_cast<int>(entered.size()));
+					Assert::IsTrue(exited.empty());
+					Assert::IsTrue(world.getSensorEvents().stayed == std::vector<WLUW::SensorPair>{ { sensor, passing } });
+				}
+			}
+
+			Assert::IsTrue(entered == std::vector<WLUW::SensorPair>{ { sensor, passing } });
+			Assert::IsTrue(exited == std::vector<WLUW::SensorPair>{ { sensor, passing } });
+			Assert::IsTrue(stayed > 0);
+
+			// Nothing pushed back, and no contact was kept for the pair
+			Assert::IsTrue(body->getVelocity() == WLUW::Vector2(3, 0));
+			Assert::AreEqual(0.0, body->getAngularVelocity());
+			Assert::AreEqual(3.0, body->getPosition().x, 1e-9);
+			Assert::IsTrue(world.getManifold(sensor, passing) == nullptr);
+
+			// A body removed while inside the sensor is reported as exited on the next step, and then forgotten
+			int const resting = addObject(world, makeBox(WLUW::Vector2(0.5, 0), 0.25, 0.25), 1.0, 1.0)->getId();
+			world.step(1.0 / 60.0);
+			Assert::IsTrue(world.getSensorEvents().entered == std::vector<WLUW::SensorPair>{ { sensor, resting } });
+
+			entered.clear();
+			exited.clear();
+			Assert::IsTrue(world.removeWorldObject(resting) != nullptr);
+			world.step(1.0 / 60.0);
+			Assert::IsTrue(entered.empty());
+			Assert::IsTrue(exited == std::vector<WLUW::SensorPair>{ { sensor, resting } });
+			Assert::IsTrue(world.getSensorEvents().stayed.empty());
+
+			world.step(1.0 / 60.0);
+			Assert::IsTrue(world.getSensorEvents().exited.empty());
+
+			// Removing the sensor itself ends its overlaps the same way
+			int const inside = addObject(world, makeBox(WLUW::Vector2(-0.5, 0), 0.25, 0.25), 1.0, 1.0)->getId();
+			world.step(1.0 / 60.0);
+			Assert::IsTrue(world.getSensorEvents().entered == std::vector<WLUW::SensorPair>{ { sensor, inside } });
+
+			world.removeWorldObject(sensor);
+			world.step(1.0 / 60.0);
+			Assert::IsTrue(world.getSensorEvents().exited == std::vector<WLUW::SensorPair>{ { sensor, inside } });
+		}
+
+		TEST_METHOD(CompoundCollider_T)
+		{
+			WLUW::WWorld world;
+			world.setGravity(WLUW::Vector2(0, -10));
+
+			// Static floor of three slabs, and an L of two boxes dropped onto it
+			WLUW::CompoundShape floor(WLUW::Vector2(0, -1));
+			for (int i = -1; i <= 1; i++)
+				floor.addChild(makeBox(WLUW::Vector2(), 1.0, 0.5), WLUW::Transform2D(WLUW::Vector2(2.0 * i, 0)));
+			auto floorObject = std::make_unique<WLUW::WObject>();
+			floorObject->attachComponent(std::make_unique<WLUW::WCollider>(floor));
+			int const floorId = floorObject->getId();
+			world.addWorldObject(std::move(floorObject));
+
+			WLUW::CompoundShape l(WLUW::Vector2(0.5, 0.05));
+			l.addChild(makeBox(WLUW::Vector2(), 1.0, 0.5));
+			l.addChild(makeBox(WLUW::Vector2(), 0.5, 0.5), WLUW::Transform2D(WLUW::Vector2(-0.5, 1)));
+			auto lObject = std::make_unique<WLUW::WObject>();
+			lObject->attachComponent(std::make_unique<WLUW::WCollider>(l));
+			lObject->attachComponent(std::make_unique<WLUW::WRigidBody>(2.0, 1.0));
+			WLUW::WCollider* lCollider = lObject->getComponent<WLUW::WCollider>();
+			WLUW::WRigidBody* lBody = lObject->getComponent<WLUW::WRigidBody>();
+			world.addWorldObject(std::move(lObject));
+
+			// A single box landing on the floor as well, to be paired with the compound either way round
+			WLUW::WObject* boxObject = addObject(world, makeBox(WLUW::Vector2(-2, 1), 0.5, 0.5), 1.0, 1.0 / 6.0);
+			WLUW::WRigidBody* box = boxObject->getComponent<WLUW::WRigidBody>();
+
+			for (int i = 0; i < 300; i++)
+				world.step(1.0 / 60.0);
+
+			// The L rests across two slabs, upright, and its children follow the body
+			Assert::AreEqual(0.0, lBody->getPosition().y, 0.05);
+			Assert::AreEqual(0.0, lBody->getAngle(), 0.02);
+			Assert::IsTrue(lCollider->getPosition() == lBody->getPosition());
+			Assert::AreEqual(lBody->getAngle(), lCollider->getTransform().getAngle(), 1e-12);
+			WLUW::Vector2 const top = lCollider->getTransform().apply(WLUW::Vector2(-0.5, 1));
+			Assert::AreEqual(top.x, lCollider->getCompound()->getChild(1).getPosition().x, 1e-12);
+			Assert::AreEqual(top.y, lCollider->getCompound()->getChild(1).getPosition().y, 1e-12);
+			Assert::AreEqual(0.0, box->getPosition().y, 0.05);
+			Assert::IsTrue(world.getManifold(floorId, boxObject->getId()) != nullptr);
+
+			// Queries reach the children, not only the compound's box
+			std::vector<int> ids;
+			Assert::AreEqual(1, world.queryPoint(WLUW::Vector2(-0.25, 1), ids));
+			Assert::AreEqual(0, world.queryPoint(WLUW::Vector2(1.2, 1), ids));
+			Assert::AreEqual(0, world.queryCircle(WLUW::Vector2(1.2, 1.2), 0.1, ids));
+
+			WLUW::RayHit hit;
+			Assert::IsTrue(world.raycast(WLUW::Ray{ WLUW::Vector2(1, 5), WLUW::Vector2(0, -1), 10.0 }, hit));
+			Assert::AreEqual(4.5, hit.distance, 0.05);
+
+			// A fast continuous bullet is stopped by the L's tall child
+			WLUW::WObject* bullet = addObject(world, makeBox(WLUW::Vector2(-5, 1), 0.1, 0.1), 1.0);
+			bullet->getComponent<WLUW::WCollider>()->setContinuous(true);
+			bullet->getComponent<WLUW::WRigidBody>()->setVelocity(WLUW::Vector2(600, 0));
+			world.setGravity(WLUW::Vector2(0, 0));
+			world.step(1.0 / 60.0);
+			Assert::IsTrue(bullet->getComponent<WLUW::WCollider>()->getPosition().x < 0.0);
+		}
+	};
 }
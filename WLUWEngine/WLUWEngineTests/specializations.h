@@ -7,7 +7,7 @@ namespace Microsoft
     {
         namespace CppUnitTestFramework
         {
-            template<> inline std::wstring ToString<WLUW::Vector2>(const class WLUW::Vector2& v) { return std::wstring(L"Vector2"); }
+            template<> inline std::wstring ToString<WLUW::Vector2>(const WLUW::Vector2& v) { return std::wstring(L"Vector2"); }
         }
     }
 }
\ No newline at end of file